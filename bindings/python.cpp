@@ -34,6 +34,7 @@ PYBIND11_MODULE(python_griddly, m) {
   gdy.def("get_action_input_mappings", &Py_GDYWrapper::getActionInputMappings);
   gdy.def("get_avatar_object", &Py_GDYWrapper::getAvatarObject);
   gdy.def("create_game", &Py_GDYWrapper::createGame);
+  gdy.def("create_vector_game", &Py_GDYWrapper::createVectorGame);
   gdy.def("get_level_count", &Py_GDYWrapper::getLevelCount);
   gdy.def("get_observer_type", &Py_GDYWrapper::getObserverType);
   
@@ -59,6 +60,9 @@ PYBIND11_MODULE(python_griddly, m) {
   game_process.def("get_available_action_ids", &Py_GameWrapper::getAvailableActionIds);
   game_process.def("build_valid_action_trees", &Py_GameWrapper::buildValidActionTrees);
 
+  // Dense [width, height, action type, action id] mask of the valid actions of a player, much cheaper than the valid action trees on large maps
+  game_process.def("get_valid_action_mask", &Py_GameWrapper::getValidActionMask, py::arg("player_id"), py::arg("out")=py::none());
+
   // Width and height of the game grid 
   game_process.def("get_width", &Py_GameWrapper::getWidth);
   game_process.def("get_height", &Py_GameWrapper::getHeight);
@@ -71,6 +75,9 @@ PYBIND11_MODULE(python_griddly, m) {
 
   // Tile size of the global observer
   game_process.def("observe", &Py_GameWrapper::observe);
+
+  // Render global observations into a preallocated numpy array, observe() then returns a view of it. None goes back to the observer's own buffer
+  game_process.def("set_observation_buffer", &Py_GameWrapper::setObservationBuffer);
   
   // Enable the history collection mode 
   game_process.def("enable_history", &Py_GameWrapper::enableHistory);
@@ -78,9 +85,24 @@ PYBIND11_MODULE(python_griddly, m) {
   // Create a copy of the game in its current state
   game_process.def("clone", &Py_GameWrapper::clone);
 
+  // Create a copy of the game that shares the objects that can never change with this game, copying tiles as they change
+  game_process.def("fork", &Py_GameWrapper::fork);
+
+  // Save the state of the game to bytes, and restore it in this or another game created from the same GDY
+  game_process.def("save_state", &Py_GameWrapper::saveState);
+  game_process.def("load_state", &Py_GameWrapper::loadState);
+
+  // Record changes from this point so they can be undone with rollback, cheaper than a clone for tree search
+  game_process.def("push_checkpoint", &Py_GameWrapper::pushCheckpoint);
+  game_process.def("rollback", &Py_GameWrapper::rollback);
+  game_process.def("discard_checkpoint", &Py_GameWrapper::discardCheckpoint);
+
   // Get a dictionary containing the objects in the environment and their variable values
   game_process.def("get_state", &Py_GameWrapper::getState);
 
+  // Get a hash of the state that is updated incrementally and is stable across processes
+  game_process.def("get_state_hash", &Py_GameWrapper::getStateHash);
+
   // Get a specific variable value
   game_process.def("get_global_variable", &Py_GameWrapper::getGlobalVariables);
 
@@ -105,10 +127,32 @@ PYBIND11_MODULE(python_griddly, m) {
   game_process.def("seed", &Py_GameWrapper::seedRandomGenerator);
 
 
+  // Steps a batch of games with one call, the results are written into the same numpy arrays every step
+  py::class_<Py_VectorGameWrapper, std::shared_ptr<Py_VectorGameWrapper>> vector_game(m, "VectorGameProcess");
+  vector_game.def("load_level", &Py_VectorGameWrapper::loadLevel);
+  vector_game.def("load_level_string", &Py_VectorGameWrapper::loadLevelString);
+  vector_game.def("init", &Py_VectorGameWrapper::init);
+  vector_game.def("reset", &Py_VectorGameWrapper::reset);
+  vector_game.def("step", &Py_VectorGameWrapper::step);
+  vector_game.def("seed", &Py_VectorGameWrapper::seedRandomGenerator);
+
+  // send starts a step in the background and returns straight away, recv waits for it and returns the same results as step
+  vector_game.def("send", &Py_VectorGameWrapper::send);
+  vector_game.def("recv", &Py_VectorGameWrapper::recv);
+
+  // Step the games on this many threads, 0 uses every core
+  vector_game.def("set_thread_count", &Py_VectorGameWrapper::setThreadCount, py::arg("thread_count"), py::arg("pin_threads")=false);
+  vector_game.def("get_thread_count", &Py_VectorGameWrapper::getThreadCount);
+
+  vector_game.def("get_game_count", &Py_VectorGameWrapper::getGameCount);
+  vector_game.def("get_player_count", &Py_VectorGameWrapper::getPlayerCount);
+
+
   py::class_<Py_StepPlayerWrapper, std::shared_ptr<Py_StepPlayerWrapper>> player(m, "Player");
   player.def("step", &Py_StepPlayerWrapper::stepSingle);
   player.def("step_multi", &Py_StepPlayerWrapper::stepMulti);
   player.def("observe", &Py_StepPlayerWrapper::observe);
+  player.def("set_observation_buffer", &Py_StepPlayerWrapper::setObservationBuffer);
   player.def("get_observation_description", &Py_StepPlayerWrapper::getObservationDescription);
 
 
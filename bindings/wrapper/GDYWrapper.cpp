@@ -10,6 +10,7 @@
 #include "../../src/Griddly/Core/TurnBasedGameProcess.hpp"
 #include "GameWrapper.cpp"
 #include "StepPlayerWrapper.cpp"
+#include "VectorGameWrapper.cpp"
 
 namespace griddly {
 
@@ -87,6 +88,10 @@ class Py_GDYWrapper {
     return std::make_shared<Py_GameWrapper>(Py_GameWrapper(globalObserverName, gdyFactory_));
   }
 
+  std::shared_ptr<Py_VectorGameWrapper> createVectorGame(uint32_t gameCount, std::string playerObserverName) {
+    return std::make_shared<Py_VectorGameWrapper>(gameCount, playerObserverName, gdyFactory_);
+  }
+
  private:
   const std::shared_ptr<GDYFactory> gdyFactory_;
 };
@@ -129,6 +129,32 @@ class Py_GameWrapper {
     return valid_action_trees;
   }
 
+  // The mask is written into out if it is given, so the same array can be reused every step
+  py::array_t<uint8_t> getValidActionMask(uint32_t playerId, py::object out) const {
+    auto shape = gameProcess_->getValidActionMaskShape();
+    std::vector<ssize_t> maskShape(shape.begin(), shape.end());
+
+    py::array_t<uint8_t, py::array::c_style> mask;
+    if (out.is_none()) {
+      mask = py::array_t<uint8_t, py::array::c_style>(maskShape);
+    } else {
+      mask = py::array_t<uint8_t, py::array::c_style>::ensure(out);
+      if (!mask || !mask.is(out) || !mask.writeable() || std::vector<ssize_t>(mask.shape(), mask.shape() + mask.ndim()) != maskShape) {
+        auto error = fmt::format("Mask must be a writeable, contiguous uint8 array with the shape [{0}, {1}, {2}, {3}].", shape[0], shape[1], shape[2], shape[3]);
+        spdlog::error(error);
+        throw std::invalid_argument(error);
+      }
+    }
+
+    auto* maskData = mask.mutable_data();
+    {
+      py::gil_scoped_release release;
+      gameProcess_->writeValidActionMask(playerId, maskData);
+    }
+
+    return mask;
+  }
+
   py::dict getAvailableActionNames(int playerId) const {
     auto availableActionNames = gameProcess_->getAvailableActionNames(playerId);
 
@@ -174,6 +200,7 @@ class Py_GameWrapper {
   }
 
   void reset() {
+    py::gil_scoped_release release;
     gameProcess_->reset();
   }
 
@@ -185,6 +212,10 @@ class Py_GameWrapper {
     return wrapObservation(gameProcess_->getObserver());
   }
 
+  void setObservationBuffer(py::object buffer) {
+    observationBuffer_ = griddly::setObservationBuffer(gameProcess_->getObserver(), buffer);
+  }
+
   py::tuple stepParallel(py::buffer stepArray) {
     auto stepArrayInfo = stepArray.request();
     if (stepArrayInfo.format != "l" && stepArrayInfo.format != "i") {
@@ -292,12 +323,63 @@ class Py_GameWrapper {
   }
 
   std::shared_ptr<Py_GameWrapper> clone() {
-    auto clonedGameProcess = gameProcess_->clone();
+    std::shared_ptr<TurnBasedGameProcess> clonedGameProcess;
+    {
+      py::gil_scoped_release release;
+      clonedGameProcess = gameProcess_->clone();
+    }
     auto clonedPyGameProcessWrapper = std::make_shared<Py_GameWrapper>(Py_GameWrapper(gdyFactory_, clonedGameProcess));
 
     return clonedPyGameProcessWrapper;
   }
 
+  std::shared_ptr<Py_GameWrapper> fork() {
+    std::shared_ptr<TurnBasedGameProcess> forkedGameProcess;
+    {
+      py::gil_scoped_release release;
+      forkedGameProcess = gameProcess_->fork();
+    }
+    auto forkedPyGameProcessWrapper = std::make_shared<Py_GameWrapper>(Py_GameWrapper(gdyFactory_, forkedGameProcess));
+
+    return forkedPyGameProcessWrapper;
+  }
+
+  py::bytes saveState() {
+    {
+      py::gil_scoped_release release;
+      gameProcess_->saveState(stateBuffer_);
+    }
+    return py::bytes(reinterpret_cast<const char*>(stateBuffer_.data()), stateBuffer_.size());
+  }
+
+  void loadState(py::buffer state) {
+    auto stateInfo = state.request();
+    if (stateInfo.ndim != 1 || stateInfo.itemsize != 1) {
+      std::string error = "Invalid state buffer, must be a 1-dimensional byte buffer.";
+      spdlog::error(error);
+      throw std::invalid_argument(error);
+    }
+
+    py::gil_scoped_release release;
+    gameProcess_->loadState(static_cast<const uint8_t*>(stateInfo.ptr), stateInfo.size);
+  }
+
+  void pushCheckpoint() {
+    gameProcess_->pushCheckpoint();
+  }
+
+  void rollback() {
+    gameProcess_->rollback();
+  }
+
+  void discardCheckpoint() {
+    gameProcess_->discardCheckpoint();
+  }
+
+  uint64_t getStateHash() const {
+    return gameProcess_->getStateHash();
+  }
+
   py::dict getState() const {
     py::dict py_state;
     auto state = gameProcess_->getState();
@@ -424,5 +506,11 @@ class Py_GameWrapper {
   const std::shared_ptr<GDYFactory> gdyFactory_;
   uint32_t playerCount_ = 0;
   std::vector<std::shared_ptr<Py_StepPlayerWrapper>> players_;
+
+  // Reused between calls to saveState
+  std::vector<uint8_t> stateBuffer_;
+
+  // Keeps the array the global observer renders into alive
+  py::object observationBuffer_;
 };
 }  // namespace griddly
\ No newline at end of file
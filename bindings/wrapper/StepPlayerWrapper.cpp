@@ -34,6 +34,10 @@ class Py_StepPlayerWrapper {
     return wrapObservation(player_->getObserver());
   }
 
+  void setObservationBuffer(py::object buffer) {
+    observationBuffer_ = griddly::setObservationBuffer(player_->getObserver(), buffer);
+  }
+
   py::tuple stepMulti(py::buffer stepArray, bool updateTicks) {
     auto externalActionNames = gdyFactory_->getExternalActionNames();
     auto gameProcess = player_->getGameProcess();
@@ -100,7 +104,12 @@ class Py_StepPlayerWrapper {
       }
     }
 
-    auto actionResult = player_->performActions(actions, updateTicks);
+    ActionResult actionResult;
+    {
+      py::gil_scoped_release release;
+      actionResult = player_->performActions(actions, updateTicks);
+    }
+
     auto info = buildInfo(actionResult);
     auto rewards = gameProcess_->getAccumulatedRewards(player_->getId());
     return py::make_tuple(rewards, actionResult.terminated, info);
@@ -114,10 +123,13 @@ class Py_StepPlayerWrapper {
     auto action = buildAction(actionName, actionArray);
 
     ActionResult actionResult;
-    if (action != nullptr) {
-      actionResult = player_->performActions({action}, updateTicks);
-    } else {
-      actionResult = player_->performActions({}, updateTicks);
+    {
+      py::gil_scoped_release release;
+      if (action != nullptr) {
+        actionResult = player_->performActions({action}, updateTicks);
+      } else {
+        actionResult = player_->performActions({}, updateTicks);
+      }
     }
 
     auto info = buildInfo(actionResult);
@@ -130,6 +142,9 @@ class Py_StepPlayerWrapper {
   const std::shared_ptr<GDYFactory> gdyFactory_;
   const std::shared_ptr<GameProcess> gameProcess_;
 
+  // Keeps the array the observer renders into alive
+  py::object observationBuffer_;
+
   py::dict buildInfo(ActionResult actionResult) {
     py::dict py_info;
 
@@ -165,7 +180,7 @@ class Py_StepPlayerWrapper {
     auto playerAvatar = player_->getAvatar();
     auto playerId = player_->getId();
 
-    auto inputMappings = actionInputsDefinition.inputMappings;
+    const auto& inputMappings = actionInputsDefinition.inputMappings;
 
     if (playerAvatar != nullptr) {
       auto actionId = actionArray[0];
@@ -174,11 +189,10 @@ class Py_StepPlayerWrapper {
         return nullptr;
       }
 
-      auto mapping = inputMappings[actionId];
+      const auto& mapping = inputMappings.at(actionId);
       auto vectorToDest = mapping.vectorToDest;
       auto orientationVector = mapping.orientationVector;
-      auto metaData = mapping.metaData;
-      auto action = std::make_shared<Action>(Action(gameProcess_->getGrid(), actionName, playerId, 0, metaData));
+      auto action = gameProcess_->getGrid()->createAction(actionName, playerId, 0, mapping.metaData);
       action->init(playerAvatar, vectorToDest, orientationVector, actionInputsDefinition.relative);
 
       return action;
@@ -191,13 +205,11 @@ class Py_StepPlayerWrapper {
         return nullptr;
       }
 
-      auto mapping = inputMappings[actionId];
+      const auto& mapping = inputMappings.at(actionId);
       auto vector = mapping.vectorToDest;
-      auto orientationVector = mapping.orientationVector;
-      auto metaData = mapping.metaData;
       glm::ivec2 destinationLocation = sourceLocation + vector;
 
-      auto action = std::make_shared<Action>(Action(gameProcess_->getGrid(), actionName, playerId, 0, metaData));
+      auto action = gameProcess_->getGrid()->createAction(actionName, playerId, 0, mapping.metaData);
       action->init(sourceLocation, destinationLocation);
 
       return action;
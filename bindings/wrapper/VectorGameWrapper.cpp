@@ -0,0 +1,133 @@
+#pragma once
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <spdlog/spdlog.h>
+
+#include <memory>
+
+#include "../../src/Griddly/Core/VectorGameProcess.hpp"
+
+namespace py = pybind11;
+
+namespace griddly {
+
+class Py_VectorGameWrapper {
+ public:
+  Py_VectorGameWrapper(uint32_t gameCount, std::string playerObserverName, std::shared_ptr<GDYFactory> gdyFactory)
+      : vectorGameProcess_(std::make_shared<VectorGameProcess>(gameCount, playerObserverName, gdyFactory)) {
+    spdlog::debug("Created vector game process wrapper");
+  }
+
+  void loadLevel(uint32_t levelId) {
+    vectorGameProcess_->setLevel(levelId);
+  }
+
+  void loadLevelString(std::string levelString) {
+    vectorGameProcess_->setLevel(levelString);
+  }
+
+  void init() {
+    vectorGameProcess_->init();
+  }
+
+  void setThreadCount(uint32_t threadCount, bool pinThreads) {
+    vectorGameProcess_->setThreadCount(threadCount, pinThreads);
+  }
+
+  uint32_t getThreadCount() const {
+    return vectorGameProcess_->getThreadCount();
+  }
+
+  void seedRandomGenerator(uint32_t seed) {
+    vectorGameProcess_->seedRandomGenerator(seed);
+  }
+
+  uint32_t getGameCount() const {
+    return vectorGameProcess_->getGameCount();
+  }
+
+  uint32_t getPlayerCount() const {
+    return vectorGameProcess_->getPlayerCount();
+  }
+
+  py::tuple reset() {
+    {
+      py::gil_scoped_release release;
+      vectorGameProcess_->reset();
+    }
+
+    return buildResults();
+  }
+
+  py::tuple step(py::array_t<int32_t, py::array::c_style | py::array::forcecast> actions) {
+    validateActions(actions);
+
+    const int32_t* actionData = actions.data();
+    auto actionSize = static_cast<uint32_t>(actions.shape(2));
+
+    {
+      py::gil_scoped_release release;
+      vectorGameProcess_->step(actionData, actionSize);
+    }
+
+    return buildResults();
+  }
+
+  // Starts stepping the games in the background, the results are returned by recv
+  void send(py::array_t<int32_t, py::array::c_style | py::array::forcecast> actions) {
+    validateActions(actions);
+    vectorGameProcess_->stepAsync(actions.data(), static_cast<uint32_t>(actions.shape(2)));
+  }
+
+  py::tuple recv() {
+    {
+      py::gil_scoped_release release;
+      vectorGameProcess_->waitForStep();
+    }
+
+    return buildResults();
+  }
+
+ private:
+  const std::shared_ptr<VectorGameProcess> vectorGameProcess_;
+
+  void validateActions(const py::array_t<int32_t, py::array::c_style | py::array::forcecast>& actions) const {
+    auto gameCount = vectorGameProcess_->getGameCount();
+    auto playerCount = vectorGameProcess_->getPlayerCount();
+
+    if (actions.ndim() != 3 || actions.shape(0) != gameCount || actions.shape(1) != playerCount) {
+      auto error = fmt::format("Actions must have the shape [{0}, {1}, action size].", gameCount, playerCount);
+      spdlog::error(error);
+      throw std::invalid_argument(error);
+    }
+  }
+
+  // The arrays are views of the buffers of the vector game process, they are overwritten by the next step or reset
+  py::tuple buildResults() const {
+    auto gameCount = static_cast<ssize_t>(vectorGameProcess_->getGameCount());
+    auto playerCount = static_cast<ssize_t>(vectorGameProcess_->getPlayerCount());
+    auto observationSize = static_cast<ssize_t>(vectorGameProcess_->getObservationSize());
+
+    // Keeps the buffers alive for as long as any of the arrays are
+    py::capsule owner(new std::shared_ptr<VectorGameProcess>(vectorGameProcess_), [](void* vectorGameProcess) {
+      delete reinterpret_cast<std::shared_ptr<VectorGameProcess>*>(vectorGameProcess);
+    });
+
+    std::vector<ssize_t> observationShape{gameCount, playerCount};
+    std::vector<ssize_t> observationStrides{playerCount * observationSize, observationSize};
+    const auto& shape = vectorGameProcess_->getObservationShape();
+    const auto& strides = vectorGameProcess_->getObservationStrides();
+    for (size_t d = 0; d < shape.size(); d++) {
+      observationShape.push_back(shape[d]);
+      observationStrides.push_back(strides[d]);
+    }
+
+    auto observations = py::array_t<uint8_t>(observationShape, observationStrides, vectorGameProcess_->getObservations().data(), owner);
+    auto rewards = py::array_t<int32_t>({gameCount, playerCount}, vectorGameProcess_->getRewards().data(), owner);
+    auto dones = py::array(py::dtype::of<bool>(), {gameCount}, vectorGameProcess_->getDones().data(), owner);
+
+    return py::make_tuple(observations, rewards, dones);
+  }
+};
+
+}  // namespace griddly
@@ -1,28 +1,47 @@
 #pragma once
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 
 #include "../../src/Griddly/Core/Observers/EntityObserver.hpp"
+#include "../../src/Griddly/Core/Observers/VectorObserver.hpp"
 #include "NumpyWrapper.cpp"
 
 namespace py = pybind11;
 
 namespace griddly {
 
+// A numpy view of the first rows of an entity buffer. The array holds the buffer, so it stays valid after the observer has moved on to a larger one,
+// but it is overwritten by the observer's next update like the arrays of tensor observations
+template <class T>
+py::array_t<T> wrapEntityBuffer(const std::shared_ptr<std::vector<T>>& buffer, std::vector<ssize_t> shape) {
+  auto* heldBuffer = new std::shared_ptr<std::vector<T>>(buffer);
+  py::capsule base(heldBuffer, [](void* heldBuffer) {
+    delete reinterpret_cast<std::shared_ptr<std::vector<T>>*>(heldBuffer);
+  });
+
+  return py::array_t<T>(shape, buffer->data(), base);
+}
+
 inline py::dict wrapEntityObservation(EntityObservations& entityObservations) {
   py::dict entityObservation;
 
   py::dict entityObservationsObs;
+  py::dict entityObservationsIds;
+  py::dict entityObservationsLocations;
 
-  for (const auto& entityObservation : entityObservations.observations) {
+  for (const auto& entityObservation : entityObservations.entities) {
     const auto& name = entityObservation.first;
-    const auto& obs = entityObservation.second;
+    const auto& entities = entityObservation.second;
 
-    entityObservationsObs[name.c_str()] = py::cast(obs);
+    ssize_t entityCount = entities.entityCount;
+    entityObservationsObs[name.c_str()] = wrapEntityBuffer(entities.features, {entityCount, entities.featureCount});
+    entityObservationsIds[name.c_str()] = wrapEntityBuffer(entities.ids, {entityCount});
+    entityObservationsLocations[name.c_str()] = wrapEntityBuffer(entities.locations, {entityCount, 2});
   }
 
   entityObservation["Entities"] = entityObservationsObs;
-  entityObservation["Ids"] = entityObservations.ids;
-  entityObservation["Locations"] = entityObservations.locations;
+  entityObservation["Ids"] = entityObservationsIds;
+  entityObservation["Locations"] = entityObservationsLocations;
 
   entityObservation["ActorIds"] = entityObservations.actorIds;
 
@@ -38,18 +57,99 @@ inline py::dict wrapEntityObservation(EntityObservations& entityObservations) {
   return entityObservation;
 }
 
+// COO form of a SPARSE vector observation: [nonzero elements, 3] uint32 indices of [channel, x, y] and their uint8 values
+inline py::dict wrapSparseObservation(std::shared_ptr<VectorObserver> vectorObserver) {
+  std::vector<uint32_t> indices;
+  std::vector<uint8_t> values;
+  vectorObserver->getSparseObservation(indices, values);
+
+  auto elementCount = static_cast<ssize_t>(values.size());
+
+  py::dict sparseObservation;
+  sparseObservation["Indices"] = py::array_t<uint32_t>(std::vector<ssize_t>{elementCount, 3}, indices.data());
+  sparseObservation["Values"] = py::array_t<uint8_t>(elementCount, values.data());
+  sparseObservation["Shape"] = py::cast(vectorObserver->getShape());
+  return sparseObservation;
+}
+
+inline std::string getVectorObservationFormatName(VectorObservationFormat format) {
+  switch (format) {
+    case VectorObservationFormat::BIT_PACKED:
+      return "BIT_PACKED";
+    case VectorObservationFormat::TYPE_IDS:
+      return "TYPE_IDS";
+    case VectorObservationFormat::SPARSE:
+      return "SPARSE";
+    default:
+      return "DENSE";
+  }
+}
+
+// Observers are updated without holding the GIL so other python threads can run while the observation is rendered
 inline py::object wrapObservation(std::shared_ptr<Observer> observer) {
   if (observer->getObserverType() == ObserverType::ENTITY) {
     auto entityObserver = std::dynamic_pointer_cast<EntityObserver>(observer);
-    auto& observationData = entityObserver->update();
-    return wrapEntityObservation(observationData);
+    EntityObservations* observationData;
+    {
+      py::gil_scoped_release release;
+      observationData = &entityObserver->update();
+    }
+    return wrapEntityObservation(*observationData);
   } else {
     auto tensorObserver = std::dynamic_pointer_cast<TensorObservationInterface>(observer);
-    auto& observationData = tensorObserver->update();
-    return py::cast(std::make_shared<NumpyWrapper<uint8_t>>(NumpyWrapper<uint8_t>(tensorObserver->getShape(), tensorObserver->getStrides(), observationData)));
+    uint8_t* observationData;
+    {
+      py::gil_scoped_release release;
+      observationData = &tensorObserver->update();
+    }
+
+    auto vectorObserver = std::dynamic_pointer_cast<VectorObserver>(observer);
+    if (vectorObserver != nullptr && vectorObserver->getConfig().format == VectorObservationFormat::SPARSE) {
+      return wrapSparseObservation(vectorObserver);
+    }
+
+    return py::cast(std::make_shared<NumpyWrapper<uint8_t>>(NumpyWrapper<uint8_t>(tensorObserver->getShape(), tensorObserver->getStrides(), *observationData)));
   }
 }
 
+// Renders the observations of a tensor observer straight into a writable uint8 array with the observation's shape, which can be a slice
+// of a larger array. The returned object has to be kept alive for as long as the observer uses the array.
+inline py::object setObservationBuffer(std::shared_ptr<Observer> observer, py::object buffer) {
+  auto tensorObserver = std::dynamic_pointer_cast<TensorObservationInterface>(observer);
+  if (tensorObserver == nullptr) {
+    throw std::invalid_argument("Only observers that produce tensors can render into an observation buffer.");
+  }
+
+  if (buffer.is_none()) {
+    tensorObserver->setOutputBuffer(nullptr, {});
+    return buffer;
+  }
+
+  auto array = py::array_t<uint8_t>::ensure(buffer);
+  if (!array || !array.is(buffer)) {
+    throw std::invalid_argument("Observation buffer must be a numpy array of uint8.");
+  }
+
+  if (!array.writeable()) {
+    throw std::invalid_argument("Observation buffer must be writeable.");
+  }
+
+  auto shape = tensorObserver->getShape();
+  std::vector<uint32_t> strides;
+  bool shapeMatches = static_cast<size_t>(array.ndim()) == shape.size();
+  for (size_t d = 0; shapeMatches && d < shape.size(); d++) {
+    shapeMatches = array.shape(d) == static_cast<ssize_t>(shape[d]) && array.strides(d) >= 0;
+    strides.push_back(static_cast<uint32_t>(array.strides(d)));
+  }
+
+  if (!shapeMatches) {
+    throw std::invalid_argument("Observation buffer must have the same shape as the observation, with positive strides.");
+  }
+
+  tensorObserver->setOutputBuffer(array.mutable_data(), strides);
+  return array;
+}
+
 inline py::object wrapObservationDescription(std::shared_ptr<Observer> observer) {
   py::dict observationDescription;
   const auto observerType = observer->getObserverType();
@@ -62,6 +162,18 @@ inline py::object wrapObservationDescription(std::shared_ptr<Observer> observer)
       observationDescription["TileSize"] = py::cast(std::array<uint32_t, 2>{static_cast<uint32_t>(tileSize.x), static_cast<uint32_t>(tileSize.y)});
     }
     observationDescription["Shape"] = py::cast(std::dynamic_pointer_cast<TensorObservationInterface>(observer)->getShape());
+
+    // Describes how the channels of vector observations are stored, so they can be unpacked by the learner
+    if (observerType == ObserverType::VECTOR) {
+      auto vectorObserver = std::dynamic_pointer_cast<VectorObserver>(observer);
+      const auto& config = vectorObserver->getConfig();
+      observationDescription["Format"] = getVectorObservationFormatName(config.format);
+      if (config.format == VectorObservationFormat::BIT_PACKED) {
+        observationDescription["PackedChannels"] = vectorObserver->getPackedChannelCount();
+      } else if (config.format == VectorObservationFormat::TYPE_IDS) {
+        observationDescription["Layers"] = py::cast(config.objectLayers);
+      }
+    }
   }
 
   return observationDescription;
@@ -0,0 +1,50 @@
+from timeit import default_timer as timer
+import argparse
+import numpy as np
+
+from griddly import GriddlyLoader
+
+# Measures how stepping a batch of games in one call scales with the number of threads.
+# Random actions are sent to the avatars, so the GDY must have an avatar object.
+
+
+def benchmark(gdy, game_count, thread_count, pin_threads, steps):
+    vector_game = gdy.create_vector_game(game_count, "VECTOR")
+    vector_game.set_thread_count(thread_count, pin_threads)
+    vector_game.load_level(0)
+    vector_game.init()
+    vector_game.seed(100)
+    vector_game.reset()
+
+    action_count = len(gdy.get_action_names())
+    player_count = gdy.get_player_count()
+    action_ids = np.random.randint(0, 5, size=(steps, game_count, player_count, 1), dtype=np.int32)
+    if action_count > 1:
+        action_types = np.random.randint(0, action_count, size=(steps, game_count, player_count, 1), dtype=np.int32)
+        actions = np.concatenate([action_types, action_ids], axis=3)
+    else:
+        actions = action_ids
+
+    start = timer()
+    for s in range(steps):
+        vector_game.step(actions[s])
+    end = timer()
+
+    return game_count * steps / (end - start)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--gdy", default="Single-Player/GVGAI/sokoban.yaml")
+    parser.add_argument("--games", type=int, default=1024)
+    parser.add_argument("--steps", type=int, default=200)
+    parser.add_argument("--pin-threads", action="store_true")
+    args = parser.parse_args()
+
+    gdy = GriddlyLoader().load(args.gdy)
+
+    baseline = None
+    for thread_count in [1, 2, 4, 8, 16, 32, 64]:
+        sps = benchmark(gdy, args.games, thread_count, args.pin_threads, args.steps)
+        baseline = baseline or sps
+        print(f"threads: {thread_count}, steps per second: {sps:.0f}, speedup: {sps / baseline:.2f}")
@@ -115,7 +115,8 @@ class GymWrapper(gym.Env):
             return observer_type_or_string
 
     def _get_observation(self, observation, type):
-        if type != gd.ObserverType.ENTITY:
+        # Entity and SPARSE vector observations are dictionaries
+        if type != gd.ObserverType.ENTITY and not isinstance(observation, dict):
             return np.array(observation, copy=False)
         else:
             return observation
@@ -123,6 +124,24 @@ class GymWrapper(gym.Env):
     def get_state(self):
         return self.game.get_state()
 
+    def get_state_hash(self):
+        return self.game.get_state_hash()
+
+    def save_state(self):
+        return self.game.save_state()
+
+    def load_state(self, state):
+        self.game.load_state(state)
+
+    def push_checkpoint(self):
+        self.game.push_checkpoint()
+
+    def rollback(self):
+        self.game.rollback()
+
+    def discard_checkpoint(self):
+        self.game.discard_checkpoint()
+
     def get_tile_size(self, player=0):
         if player == 0:
             return self.game.get_global_observation_description()["TileSize"]
@@ -440,6 +459,27 @@ class GymWrapper(gym.Env):
 
         return cloned_wrapper
 
+    def fork(self, global_observer_type=None, player_observer_type=None):
+        """
+        Return an executable copy of the current environment that shares the objects that can never change, such as walls,
+        with this environment. Memory is only used for the parts of the map that change, so this is cheaper than clone
+        when creating many copies of an environment
+        :param global_observer_type: optionally override the global observer type
+        :param player_observer_type: optionally override the player observer type
+        :return:
+        """
+        game_fork = self.game.fork()
+        forked_wrapper = GymWrapper(
+            global_observer_type=global_observer_type or self._global_observer_type,
+            player_observer_type=player_observer_type or self._player_observer_type[0],
+            gdy=self.gdy,
+            game=game_fork,
+        )
+
+        forked_wrapper.initialize_spaces()
+
+        return forked_wrapper
+
     def seed(self, seed=None):
         if seed is None:
             seed = 1234
@@ -88,6 +88,22 @@ class ValidActionSpaceWrapper(gym.Wrapper):
 
         return action_masks
 
+    def get_valid_action_mask(self, player_id, out=None):
+        """
+        Returns a dense mask of every valid action of a player, with shape [grid_width, grid_height, action_name_id, action_id].
+        The mask is built in a single pass in the engine, so it is much faster than get_unit_location_mask and
+        get_unit_action_mask when there are many units.
+
+        :param player_id: The player to generate the mask for
+        :param out: An optional uint8 array with the same shape to write the mask into, so it can be reused every step
+        :return:
+        """
+
+        assert player_id <= self.player_count, "Player does not exist."
+        assert player_id > 0, "Player 0 is reserved for internal actions only."
+
+        return self.env.game.get_valid_action_mask(player_id, out)
+
     def _override_action_space(self):
         return ValidatedActionSpace(self.action_space, self)
 
@@ -125,3 +125,55 @@ def test_clone_multi_agent_done(test_name):
     assert np.all(np.array(obs_2) == np.array(c_obs))
     assert np.all(reward_2 == c_reward)
     assert np.all(done_2 == c_done)
+
+
+def test_forked_random_trajectory_states(test_name):
+
+    env = gym.make(
+        "GDY-Sokoban-v0",
+        global_observer_type=gd.ObserverType.VECTOR,
+        player_observer_type=gd.ObserverType.VECTOR,
+    )
+    env.reset()
+    forked_env = env.fork()
+
+    # Create a bunch of steps and test in both environments
+    actions = [env.action_space.sample() for _ in range(1000)]
+
+    for action in actions:
+        obs, reward, done, info = env.step(action)
+        f_obs, f_reward, f_done, f_info = forked_env.step(action)
+
+        assert np.all(obs == f_obs)
+        assert reward == f_reward
+        assert done == f_done
+        assert info == f_info
+
+        env_state = env.get_state()
+        forked_state = forked_env.get_state()
+
+        assert (
+            env_state["Hash"] == forked_state["Hash"]
+        ), f"state: {env_state}, forked: {forked_state}"
+
+        if done and f_done:
+            env.reset()
+            forked_env.reset()
+
+
+def test_fork_does_not_change_parent(test_name):
+
+    env = gym.make(
+        "GDY-Sokoban-v0",
+        global_observer_type=gd.ObserverType.VECTOR,
+        player_observer_type=gd.ObserverType.VECTOR,
+    )
+    env.reset()
+    state = env.get_state()
+
+    forks = [env.fork() for _ in range(10)]
+    for forked_env in forks:
+        for _ in range(20):
+            forked_env.step(forked_env.action_space.sample())
+
+    assert env.get_state()["Hash"] == state["Hash"]
@@ -62,3 +62,27 @@ def test_state_hash_consistent_return_to_state(test_name):
 
     assert len(set(first_state_hashes)) == 1
     assert len(set(second_state_hashes)) == 1
+
+
+def test_incremental_state_hash_return_to_state(test_name):
+    """
+    Test that the incremental state hash is the same when returning to a state and changes when the state changes
+    """
+    env = build_test_env(
+        test_name, "tests/gdy/test_step_SinglePlayer_SingleActionType.yaml"
+    )
+
+    first_state_hash = env.get_state_hash()
+
+    env.step(0)
+    assert env.get_state_hash() == first_state_hash
+
+    env.step(1)
+    second_state_hash = env.get_state_hash()
+    assert second_state_hash != first_state_hash
+
+    env.step(3)
+    assert env.get_state_hash() == first_state_hash
+
+    env.step(1)
+    assert env.get_state_hash() == second_state_hash
@@ -0,0 +1,95 @@
+import numpy as np
+import pytest
+
+import gym
+from griddly import gd
+
+
+@pytest.fixture
+def test_name(request):
+    return request.node.name
+
+
+def test_load_state_restores_hash(test_name):
+    env = gym.make(
+        "GDY-Sokoban-v0",
+        global_observer_type=gd.ObserverType.VECTOR,
+        player_observer_type=gd.ObserverType.VECTOR,
+    )
+    env.reset()
+
+    state = env.save_state()
+    saved_hash = env.get_state()["Hash"]
+
+    for _ in range(100):
+        env.step(env.action_space.sample())
+
+    env.load_state(state)
+
+    assert env.get_state()["Hash"] == saved_hash
+
+
+def test_load_state_numpy_buffer(test_name):
+    env = gym.make(
+        "GDY-Sokoban-v0",
+        global_observer_type=gd.ObserverType.VECTOR,
+        player_observer_type=gd.ObserverType.VECTOR,
+    )
+    env.reset()
+
+    state = np.frombuffer(env.save_state(), dtype=np.uint8)
+    saved_hash = env.get_state()["Hash"]
+
+    for _ in range(100):
+        env.step(env.action_space.sample())
+
+    env.load_state(state)
+
+    assert env.get_state()["Hash"] == saved_hash
+
+
+def test_random_trajectory_after_load(test_name):
+    env = gym.make(
+        "GDY-Sokoban-v0",
+        global_observer_type=gd.ObserverType.VECTOR,
+        player_observer_type=gd.ObserverType.VECTOR,
+    )
+    env.reset()
+
+    # Load the state of this environment into another one
+    other_env = gym.make(
+        "GDY-Sokoban-v0",
+        global_observer_type=gd.ObserverType.VECTOR,
+        player_observer_type=gd.ObserverType.VECTOR,
+    )
+    other_env.reset()
+    other_env.load_state(env.save_state())
+
+    actions = [env.action_space.sample() for _ in range(1000)]
+
+    for action in actions:
+        obs, reward, done, info = env.step(action)
+        o_obs, o_reward, o_done, o_info = other_env.step(action)
+
+        assert reward == o_reward
+        assert done == o_done
+        assert info == o_info
+
+        assert env.get_state()["Hash"] == other_env.get_state()["Hash"]
+
+        if done:
+            break
+
+
+def test_load_state_invalid_buffer(test_name):
+    env = gym.make(
+        "GDY-Sokoban-v0",
+        global_observer_type=gd.ObserverType.VECTOR,
+        player_observer_type=gd.ObserverType.VECTOR,
+    )
+    env.reset()
+
+    state = env.save_state()
+
+    with pytest.raises(ValueError):
+        env.load_state(state[: len(state) // 2])
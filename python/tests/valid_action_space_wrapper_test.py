@@ -497,3 +497,29 @@ def test_vasw_MultiplePlayer_SelectSource_MultipleActionType(test_name):
     # Test that we sample both players
     assert check_valid_actions(sampled[0], possible_actions[0])
     assert check_valid_actions(sampled[1], possible_actions[1])
+
+
+def test_vasw_valid_action_mask_matches_trees(test_name):
+    env = build_test_env(
+        test_name,
+        "tests/gdy/test_step_MultiPlayer_SelectSource_MultipleActionType.yaml",
+    )
+
+    valid_action_trees = env.game.build_valid_action_trees()
+    for p in range(env.player_count):
+        mask = env.get_valid_action_mask(p + 1)
+        assert mask.shape == (env.grid_width, env.grid_height, 2, 5)
+
+        expected_mask = np.zeros_like(mask)
+        for x, ys in valid_action_trees[p].items():
+            for y, action_types in ys.items():
+                for action_type, action_ids in action_types.items():
+                    for action_id in action_ids:
+                        expected_mask[x, y, action_type, action_id] = 1
+
+        np.testing.assert_array_equal(mask, expected_mask)
+
+        # The mask can be written into an existing array
+        out = np.ones_like(mask)
+        assert env.get_valid_action_mask(p + 1, out) is not None
+        np.testing.assert_array_equal(out, expected_mask)
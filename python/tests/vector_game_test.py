@@ -0,0 +1,136 @@
+import numpy as np
+import pytest
+
+from griddly import GriddlyLoader, gd
+
+
+@pytest.fixture
+def test_name(request):
+    return request.node.name
+
+
+def build_vector_game(yaml_file, game_count):
+    gdy = GriddlyLoader().load(yaml_file)
+    vector_game = gdy.create_vector_game(game_count, "VECTOR")
+    vector_game.load_level(0)
+    vector_game.init()
+    return gdy, vector_game
+
+
+def test_vector_game_step_matches_single_games(test_name):
+    game_count = 8
+    gdy, vector_game = build_vector_game("Single-Player/GVGAI/sokoban.yaml", game_count)
+
+    games = []
+    players = []
+    for _ in range(game_count):
+        game = gdy.create_game("NONE")
+        player = game.register_player("Player 1", "VECTOR")
+        game.load_level(0)
+        game.init(False)
+        game.reset()
+        games.append(game)
+        players.append(player)
+
+    observations, rewards, dones = vector_game.reset()
+
+    assert observations.shape == (game_count, 1, 4, 13, 9)
+    assert rewards.shape == (game_count, 1)
+    assert dones.shape == (game_count,)
+
+    for g in range(game_count):
+        np.testing.assert_array_equal(observations[g, 0], np.array(players[g].observe(), copy=False))
+
+    for _ in range(50):
+        actions = np.random.randint(0, 5, size=(game_count, 1, 1), dtype=np.int32)
+        observations, rewards, dones = vector_game.step(actions)
+
+        for g in range(game_count):
+            reward, done, _ = players[g].step_multi(actions[g], True)
+            assert rewards[g, 0] == reward
+            assert dones[g] == done
+            if done:
+                games[g].reset()
+            np.testing.assert_array_equal(observations[g, 0], np.array(players[g].observe(), copy=False))
+
+
+def test_vector_game_results_are_written_in_place(test_name):
+    _, vector_game = build_vector_game("Single-Player/GVGAI/sokoban.yaml", 4)
+
+    observations, rewards, dones = vector_game.reset()
+    next_observations, next_rewards, next_dones = vector_game.step(np.zeros((4, 1, 1), dtype=np.int32))
+
+    assert np.shares_memory(observations, next_observations)
+    assert np.shares_memory(rewards, next_rewards)
+    assert np.shares_memory(dones, next_dones)
+
+
+def test_vector_game_invalid_action_shape(test_name):
+    _, vector_game = build_vector_game("Single-Player/GVGAI/sokoban.yaml", 4)
+    vector_game.reset()
+
+    with pytest.raises(ValueError):
+        vector_game.step(np.zeros((3, 1, 1), dtype=np.int32))
+
+
+def test_vector_game_send_recv_matches_step(test_name):
+    _, sync_game = build_vector_game("Single-Player/GVGAI/sokoban.yaml", 4)
+    _, async_game = build_vector_game("Single-Player/GVGAI/sokoban.yaml", 4)
+
+    sync_game.reset()
+    async_game.reset()
+
+    for _ in range(20):
+        actions = np.random.randint(0, 5, size=(4, 1, 1), dtype=np.int32)
+        observations, rewards, dones = sync_game.step(actions)
+
+        async_game.send(actions)
+        async_observations, async_rewards, async_dones = async_game.recv()
+
+        np.testing.assert_array_equal(observations, async_observations)
+        np.testing.assert_array_equal(rewards, async_rewards)
+        np.testing.assert_array_equal(dones, async_dones)
+
+
+def test_vector_game_step_while_sending(test_name):
+    _, vector_game = build_vector_game("Single-Player/GVGAI/sokoban.yaml", 4)
+    vector_game.reset()
+
+    actions = np.zeros((4, 1, 1), dtype=np.int32)
+    vector_game.send(actions)
+    with pytest.raises(RuntimeError):
+        vector_game.step(actions)
+    vector_game.recv()
+
+
+def test_players_render_into_observation_buffer(test_name):
+    game_count = 4
+    gdy = GriddlyLoader().load("Single-Player/GVGAI/sokoban.yaml")
+
+    def create_game():
+        game = gdy.create_game("NONE")
+        player = game.register_player("Player 1", "VECTOR")
+        game.load_level(0)
+        game.init(False)
+        game.reset()
+        return game, player
+
+    # Each player renders into its slice of a [games, channels, width, height] buffer
+    observation_buffer = np.zeros((game_count, 4, 13, 9), dtype=np.uint8)
+    buffered = [create_game() for _ in range(game_count)]
+    expected = [create_game() for _ in range(game_count)]
+    for g, (_, player) in enumerate(buffered):
+        player.set_observation_buffer(observation_buffer[g])
+
+    for _ in range(20):
+        actions = np.random.randint(0, 5, size=(game_count, 1, 1), dtype=np.int32)
+        for g in range(game_count):
+            buffered[g][1].step_multi(actions[g], True)
+            expected[g][1].step_multi(actions[g], True)
+
+            observation = np.array(buffered[g][1].observe(), copy=False)
+            assert np.shares_memory(observation, observation_buffer)
+            np.testing.assert_array_equal(observation_buffer[g], np.array(expected[g][1].observe(), copy=False))
+
+    with pytest.raises(ValueError):
+        buffered[0][1].set_observation_buffer(np.zeros((4, 9, 13), dtype=np.uint8))
@@ -62,7 +62,7 @@ SearchOutput AStarPathFinder::search(glm::ivec2 startLocation, glm::ivec2 endLoc
       }
 
       // If this location is passable
-      auto objectsAtNextLocation = grid_->getObjectsAt(nextLocation);
+      const auto& objectsAtNextLocation = grid_->getObjectsAt(nextLocation);
       bool passable = true;
       for (const auto& object : objectsAtNextLocation) {
         auto objectName = object.second->getObjectName();
@@ -6,4 +6,9 @@ CollisionDetector::CollisionDetector(uint32_t gridWidth, uint32_t gridHeight, ui
     : range_(range), gridWidth_(gridWidth), gridHeight_(gridHeight) {
 }
 
+void CollisionDetector::searchInto(glm::ivec2 location, std::vector<std::shared_ptr<Object>>& collidedObjects) {
+  auto searchResult = search(location);
+  collidedObjects.assign(searchResult.objectSet.begin(), searchResult.objectSet.end());
+}
+
 }  // namespace griddly
\ No newline at end of file
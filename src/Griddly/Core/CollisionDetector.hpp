@@ -25,6 +25,9 @@ class CollisionDetector {
 
   virtual SearchResult search(glm::ivec2 location) = 0;
 
+  // Writes the objects in range of the location into a buffer owned by the caller, the buffer is cleared first
+  virtual void searchInto(glm::ivec2 location, std::vector<std::shared_ptr<Object>>& collidedObjects);
+
  protected:
   const uint32_t range_;
   const uint32_t gridWidth_;
@@ -1,18 +1,10 @@
 #include "CollisionDetectorFactory.hpp"
 
-#include "SpatialHashCollisionDetector.hpp"
+#include "GridCollisionDetector.hpp"
 
 namespace griddly {
 
 std::shared_ptr<CollisionDetector> CollisionDetectorFactory::newCollisionDetector(uint32_t gridWidth, uint32_t gridHeight, ActionTriggerDefinition actionTriggerDefinition) {
-  // Calculate bucket size
-  auto minDim = gridWidth > gridHeight ? gridWidth : gridHeight;
-  uint32_t cellSize = 10;
-
-  if (minDim >= 100) {
-    cellSize = (uint32_t)std::floor(std::sqrt((double)minDim));
-  }
-
-  return std::make_shared<SpatialHashCollisionDetector>(SpatialHashCollisionDetector(gridWidth, gridHeight, cellSize, actionTriggerDefinition.range, actionTriggerDefinition.triggerType));
+  return std::make_shared<GridCollisionDetector>(gridWidth, gridHeight, actionTriggerDefinition.range, actionTriggerDefinition.triggerType);
 }
-}  // namespace griddly
\ No newline at end of file
+}  // namespace griddly
@@ -0,0 +1,249 @@
+#include "DelayedActionQueue.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "GDY/Actions/Action.hpp"
+
+namespace griddly {
+
+uint64_t DelayedActionQueue::push(uint32_t playerId, uint32_t executionTick, std::shared_ptr<Action> action) {
+  DelayedActionQueueItem item(playerId, executionTick, std::move(action));
+  item.sequence = nextSequence_++;
+  insert(std::move(item));
+  return nextSequence_ - 1;
+}
+
+void DelayedActionQueue::insert(DelayedActionQueueItem item) {
+  auto entryId = allocateEntry();
+  auto& entry = entries_[entryId];
+  auto executionTick = item.priority;
+
+  entry.sourceObject = item.action->getSourceObject().get();
+  entry.item = std::move(item);
+  entry.pending = true;
+  pendingCount_++;
+
+  if (entry.sourceObject != nullptr) {
+    auto& sourceEntries = sourceEntries_[entry.sourceObject];
+    entry.sourceIndex = static_cast<uint32_t>(sourceEntries.size());
+    sourceEntries.push_back(entryId);
+  }
+
+  if (executionTick <= currentTick_) {
+    ready_.push_back(entryId);
+  } else {
+    placeEntry(entryId);
+  }
+}
+
+void DelayedActionQueue::advance(uint32_t tick) {
+  if (pendingCount_ == 0) {
+    // Nothing to execute, so the wheel can jump straight to the tick. Cancelled entries are dropped on the way.
+    if (tick > currentTick_) {
+      if (freeEntries_.size() != entries_.size()) {
+        clear(tick);
+      } else {
+        currentTick_ = tick;
+      }
+    }
+    return;
+  }
+
+  while (currentTick_ < tick) {
+    step();
+  }
+}
+
+bool DelayedActionQueue::popReady(DelayedActionQueueItem& item) {
+  while (readyCursor_ < ready_.size()) {
+    auto entryId = ready_[readyCursor_++];
+    auto& entry = entries_[entryId];
+
+    if (entry.pending) {
+      unlinkSource(entry);
+      entry.pending = false;
+      pendingCount_--;
+      item = std::move(entry.item);
+      releaseEntry(entryId);
+      return true;
+    }
+
+    releaseEntry(entryId);
+  }
+
+  ready_.clear();
+  readyCursor_ = 0;
+  return false;
+}
+
+void DelayedActionQueue::cancel(const std::shared_ptr<Object>& sourceObject, std::vector<DelayedActionQueueItem>* cancelledActions) {
+  auto sourceEntriesIt = sourceEntries_.find(sourceObject.get());
+  if (sourceEntriesIt == sourceEntries_.end()) {
+    return;
+  }
+
+  for (auto entryId : sourceEntriesIt->second) {
+    auto& entry = entries_[entryId];
+    entry.pending = false;
+    if (cancelledActions != nullptr) {
+      cancelledActions->push_back(std::move(entry.item));
+    }
+    entry.item.action = nullptr;
+    pendingCount_--;
+  }
+
+  sourceEntries_.erase(sourceEntriesIt);
+}
+
+void DelayedActionQueue::clear(uint32_t tick) {
+  for (auto& level : wheel_) {
+    for (auto& slot : level) {
+      slot.clear();
+    }
+  }
+
+  entries_.clear();
+  freeEntries_.clear();
+  ready_.clear();
+  readyCursor_ = 0;
+  sourceEntries_.clear();
+  pendingCount_ = 0;
+  currentTick_ = tick;
+}
+
+void DelayedActionQueue::setCurrentTick(uint32_t tick) {
+  restore(getPendingActions(), tick);
+}
+
+void DelayedActionQueue::restore(std::vector<DelayedActionQueueItem> pendingActions, uint32_t tick) {
+  clear(tick);
+
+  std::sort(pendingActions.begin(), pendingActions.end(), [](const DelayedActionQueueItem& a, const DelayedActionQueueItem& b) {
+    return a.sequence < b.sequence;
+  });
+
+  for (auto& pendingAction : pendingActions) {
+    nextSequence_ = std::max(nextSequence_, pendingAction.sequence + 1);
+    insert(std::move(pendingAction));
+  }
+}
+
+uint32_t DelayedActionQueue::getCurrentTick() const {
+  return currentTick_;
+}
+
+size_t DelayedActionQueue::size() const {
+  return pendingCount_;
+}
+
+bool DelayedActionQueue::empty() const {
+  return pendingCount_ == 0;
+}
+
+std::vector<DelayedActionQueueItem> DelayedActionQueue::getPendingActions() const {
+  std::vector<DelayedActionQueueItem> pendingActions;
+  pendingActions.reserve(pendingCount_);
+  for (const auto& entry : entries_) {
+    if (entry.pending) {
+      pendingActions.push_back(entry.item);
+    }
+  }
+  return pendingActions;
+}
+
+uint32_t DelayedActionQueue::allocateEntry() {
+  if (!freeEntries_.empty()) {
+    auto entryId = freeEntries_.back();
+    freeEntries_.pop_back();
+    return entryId;
+  }
+
+  entries_.emplace_back();
+  return static_cast<uint32_t>(entries_.size() - 1);
+}
+
+void DelayedActionQueue::releaseEntry(uint32_t entryId) {
+  auto& entry = entries_[entryId];
+  entry.item = DelayedActionQueueItem();
+  entry.sourceObject = nullptr;
+  freeEntries_.push_back(entryId);
+}
+
+void DelayedActionQueue::placeEntry(uint32_t entryId) {
+  auto executionTick = entries_[entryId].item.priority;
+
+  // The level is the highest wheel digit in which the execution tick differs from the current tick
+  auto difference = executionTick ^ currentTick_;
+  uint32_t level = 0;
+  while (level + 1 < WHEEL_LEVELS && (difference >> (WHEEL_BITS * (level + 1))) != 0) {
+    level++;
+  }
+
+  auto slot = (executionTick >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1);
+  wheel_[level][slot].push_back(entryId);
+}
+
+void DelayedActionQueue::unlinkSource(Entry& entry) {
+  if (entry.sourceObject == nullptr) {
+    return;
+  }
+
+  auto sourceEntriesIt = sourceEntries_.find(entry.sourceObject);
+  auto& sourceEntries = sourceEntriesIt->second;
+
+  auto movedEntryId = sourceEntries.back();
+  sourceEntries[entry.sourceIndex] = movedEntryId;
+  entries_[movedEntryId].sourceIndex = entry.sourceIndex;
+  sourceEntries.pop_back();
+
+  if (sourceEntries.empty()) {
+    sourceEntries_.erase(sourceEntriesIt);
+  }
+}
+
+void DelayedActionQueue::cascade(uint32_t level) {
+  auto& slot = wheel_[level][(currentTick_ >> (WHEEL_BITS * level)) & (WHEEL_SLOTS - 1)];
+  cascadeBuffer_.swap(slot);
+
+  for (auto entryId : cascadeBuffer_) {
+    if (entries_[entryId].pending) {
+      placeEntry(entryId);
+    } else {
+      releaseEntry(entryId);
+    }
+  }
+
+  cascadeBuffer_.clear();
+}
+
+void DelayedActionQueue::step() {
+  currentTick_++;
+
+  // Move the actions of the higher levels down when the wheel has gone round the levels below them
+  for (uint32_t level = WHEEL_LEVELS - 1; level > 0; level--) {
+    if ((currentTick_ & ((1u << (WHEEL_BITS * level)) - 1)) == 0) {
+      cascade(level);
+    }
+  }
+
+  auto firstReady = ready_.size();
+  auto& slot = wheel_[0][currentTick_ & (WHEEL_SLOTS - 1)];
+  for (auto entryId : slot) {
+    if (entries_[entryId].pending) {
+      ready_.push_back(entryId);
+    } else {
+      releaseEntry(entryId);
+    }
+  }
+  slot.clear();
+
+  // Actions cascaded from the higher levels are behind the ones placed in the slot directly, execute them in the order they were delayed
+  if (ready_.size() - firstReady > 1) {
+    std::sort(ready_.begin() + firstReady, ready_.end(), [this](uint32_t a, uint32_t b) {
+      return entries_[a].item.sequence < entries_[b].item.sequence;
+    });
+  }
+}
+
+}  // namespace griddly
@@ -0,0 +1,93 @@
+#pragma once
+#include <array>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "DelayedActionQueueItem.hpp"
+
+namespace griddly {
+
+class Object;
+
+// Actions that are delayed in time, keyed by the game tick they are executed on.
+// The actions are kept in a hierarchical timing wheel. Each level has WHEEL_SLOTS slots and a slot of a level spans
+// WHEEL_SLOTS times more ticks than a slot of the level below it. Delaying an action is O(1), and when the wheel
+// reaches a tick all the actions of that tick are moved to the ready list at once. Actions in a higher level are moved
+// down when the wheel reaches their slot.
+class DelayedActionQueue {
+ public:
+  static constexpr uint32_t WHEEL_BITS = 8;
+  static constexpr uint32_t WHEEL_SLOTS = 1 << WHEEL_BITS;
+  static constexpr uint32_t WHEEL_LEVELS = 4;
+
+  // Actions with an execution tick that is not after the current tick are ready straight away.
+  // Returns the sequence number given to the action.
+  uint64_t push(uint32_t playerId, uint32_t executionTick, std::shared_ptr<Action> action);
+
+  // Moves the wheel forward to tick, every action up to and including tick becomes ready
+  void advance(uint32_t tick);
+
+  // Takes the next ready action, returns false once there are no ready actions left
+  bool popReady(DelayedActionQueueItem& item);
+
+  // Cancels all the pending actions of a source object, including ready actions that have not been taken yet.
+  // The cancelled actions are added to cancelledActions if it is given.
+  void cancel(const std::shared_ptr<Object>& sourceObject, std::vector<DelayedActionQueueItem>* cancelledActions = nullptr);
+
+  // Removes all the actions and moves the wheel to tick
+  void clear(uint32_t tick = 0);
+
+  // Moves the wheel to tick and keeps the pending actions
+  void setCurrentTick(uint32_t tick);
+
+  // Replaces the pending actions and moves the wheel to tick. The actions keep their sequence numbers.
+  void restore(std::vector<DelayedActionQueueItem> pendingActions, uint32_t tick);
+
+  uint32_t getCurrentTick() const;
+
+  size_t size() const;
+  bool empty() const;
+
+  // The pending actions, in no particular order
+  std::vector<DelayedActionQueueItem> getPendingActions() const;
+
+ private:
+  struct Entry {
+    DelayedActionQueueItem item;
+    const Object* sourceObject = nullptr;
+
+    // position of this entry in the entries of its source object
+    uint32_t sourceIndex = 0;
+
+    // false once the action has been taken or cancelled, the entry is released when it is reached in the wheel
+    bool pending = false;
+  };
+
+  void insert(DelayedActionQueueItem item);
+  uint32_t allocateEntry();
+  void releaseEntry(uint32_t entryId);
+  void placeEntry(uint32_t entryId);
+  void unlinkSource(Entry& entry);
+  void cascade(uint32_t level);
+  void step();
+
+  std::vector<Entry> entries_;
+  std::vector<uint32_t> freeEntries_;
+
+  std::array<std::array<std::vector<uint32_t>, WHEEL_SLOTS>, WHEEL_LEVELS> wheel_;
+  std::vector<uint32_t> cascadeBuffer_;
+
+  std::vector<uint32_t> ready_;
+  size_t readyCursor_ = 0;
+
+  std::unordered_map<const Object*, std::vector<uint32_t>> sourceEntries_;
+
+  uint32_t currentTick_ = 0;
+  size_t pendingCount_ = 0;
+
+  // Not reset when the queue is cleared, so actions restored after a clear keep their order
+  uint64_t nextSequence_ = 0;
+};
+
+}  // namespace griddly
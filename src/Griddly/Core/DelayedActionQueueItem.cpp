@@ -2,12 +2,10 @@
 
 #include <utility>
 
-#include <utility>
-
 namespace griddly {
 
 DelayedActionQueueItem::DelayedActionQueueItem(uint32_t _playerId, uint32_t _priority, std::shared_ptr<Action> _action)
-    : playerId(_playerId), priority(_priority), action(std::move(std::move(_action))) {
+    : playerId(_playerId), priority(_priority), action(std::move(_action)) {
 }
 
-}  // namespace griddly
\ No newline at end of file
+}  // namespace griddly
@@ -1,7 +1,5 @@
 #pragma once
 #include <memory>
-#include <queue>
-#include "Util/util.hpp"
 
 namespace griddly {
 
@@ -9,19 +7,17 @@ class Action;
 
 class DelayedActionQueueItem {
  public:
+  DelayedActionQueueItem() = default;
   DelayedActionQueueItem(uint32_t _playerId, uint32_t _priority, std::shared_ptr<Action> _action);
 
-  uint32_t playerId;
-  uint32_t priority;
+  uint32_t playerId = 0;
+
+  // The game tick the action is executed on
+  uint32_t priority = 0;
   std::shared_ptr<Action> action;
-};
 
-struct SortDelayedActionQueue {
-  bool operator()(const std::shared_ptr<DelayedActionQueueItem>& a, const std::shared_ptr<DelayedActionQueueItem>& b) {
-    return a->priority > b->priority;
-  };
+  // The order in which actions were delayed, actions with the same execution tick are executed in this order
+  uint64_t sequence = 0;
 };
 
-using DelayedActionQueue = VectorPriorityQueue<std::shared_ptr<DelayedActionQueueItem>, std::vector<std::shared_ptr<DelayedActionQueueItem> >, SortDelayedActionQueue>;
-
-}  // namespace griddly
\ No newline at end of file
+}  // namespace griddly
@@ -132,7 +132,16 @@ glm::ivec2 Action::getOrientationVector() const {
   return orientationVector_;
 }
 
-std::string Action::getActionName() const { return actionName_; }
+const std::string& Action::getActionName() const { return actionName_; }
+
+uint32_t Action::getActionId(const SymbolTable& actionSymbols) const {
+  // Names unknown to the table are not cached, as they may be interned later
+  if (resolvedActionSymbols_ != &actionSymbols || resolvedActionId_ == SymbolTable::UNKNOWN_SYMBOL) {
+    resolvedActionId_ = actionSymbols.getId(getActionName());
+    resolvedActionSymbols_ = &actionSymbols;
+  }
+  return resolvedActionId_;
+}
 
 uint32_t Action::getOriginatingPlayerId() const {
   return playerId_;
@@ -142,9 +151,10 @@ uint32_t Action::getDelay() const {
   return delay_;
 }
 
-int32_t Action::getMetaData(std::string variableName) const {
-  if (metaData_.find(variableName) != metaData_.end()) {
-    return metaData_.at(variableName);
+int32_t Action::getMetaData(const std::string& variableName) const {
+  auto metaDataIt = metaData_.find(variableName);
+  if (metaDataIt != metaData_.end()) {
+    return metaDataIt->second;
   } else {
     throw std::invalid_argument(fmt::format("cannot resolve action metadata variable meta.{0}", variableName));
   }
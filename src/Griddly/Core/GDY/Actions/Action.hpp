@@ -4,6 +4,7 @@
 #include <string>
 
 #include "../../Grid.hpp"
+#include "../SymbolTable.hpp"
 #include "../Objects/Object.hpp"
 #include "Direction.hpp"
 
@@ -58,7 +59,10 @@ class Action {
 
   virtual glm::ivec2 getVectorToDest() const;
 
-  virtual std::string getActionName() const;
+  virtual const std::string& getActionName() const;
+
+  // Id of the action name in the given symbol table. The id is cached for the last table it was looked up in.
+  uint32_t getActionId(const SymbolTable& actionSymbols) const;
 
   virtual std::string getDescription() const;
 
@@ -71,7 +75,7 @@ class Action {
 
   virtual std::unordered_map<std::string, int32_t> getMetaData() const;
 
-  virtual int32_t getMetaData(std::string variableName) const;
+  virtual int32_t getMetaData(const std::string& variableName) const;
 
   virtual ~Action() = default;
 
@@ -95,6 +99,9 @@ class Action {
  private:
   ActionMode actionMode_;
 
+  mutable const SymbolTable* resolvedActionSymbols_ = nullptr;
+  mutable uint32_t resolvedActionId_ = SymbolTable::UNKNOWN_SYMBOL;
+
   std::shared_ptr<Grid> grid() const;
 
 };
@@ -0,0 +1,53 @@
+#include "ActionPool.hpp"
+
+#include <new>
+
+namespace griddly {
+
+namespace {
+constexpr size_t alignBlockSize(size_t size) {
+  return (size + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+}
+}  // namespace
+
+void* ActionPool::allocate(size_t size) {
+  if (blockSize_ == 0) {
+    blockSize_ = alignBlockSize(size);
+  }
+
+  // Only blocks of a single size are pooled
+  if (alignBlockSize(size) != blockSize_) {
+    return ::operator new(size);
+  }
+
+  if (freeBlocks_.empty()) {
+    chunks_.emplace_back(new std::byte[blockSize_ * BLOCKS_PER_CHUNK]);  // NOLINT
+    auto* chunk = chunks_.back().get();
+    for (size_t block = BLOCKS_PER_CHUNK; block > 0; block--) {
+      freeBlocks_.push_back(chunk + (block - 1) * blockSize_);
+    }
+  }
+
+  auto* block = freeBlocks_.back();
+  freeBlocks_.pop_back();
+  return block;
+}
+
+void ActionPool::deallocate(void* block, size_t size) {
+  if (alignBlockSize(size) != blockSize_) {
+    ::operator delete(block);
+    return;
+  }
+
+  freeBlocks_.push_back(block);
+}
+
+size_t ActionPool::getBlockCount() const {
+  return chunks_.size() * BLOCKS_PER_CHUNK;
+}
+
+size_t ActionPool::getFreeBlockCount() const {
+  return freeBlocks_.size();
+}
+
+}  // namespace griddly
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace griddly {
+
+// Recycles the memory of actions created by a grid, so that creating an action in the step loop does not go to the heap.
+// Blocks are handed out from chunks and returned to a free list when the last reference to an action is released.
+// The pool is not thread safe, it belongs to a single grid.
+class ActionPool {
+ public:
+  static constexpr size_t BLOCKS_PER_CHUNK = 64;
+
+  void* allocate(size_t size);
+  void deallocate(void* block, size_t size);
+
+  // Number of blocks that have been created, and how many of them are currently free
+  size_t getBlockCount() const;
+  size_t getFreeBlockCount() const;
+
+ private:
+  size_t blockSize_ = 0;
+  std::vector<std::unique_ptr<std::byte[]>> chunks_;
+  std::vector<void*> freeBlocks_;
+};
+
+// Allocator for std::allocate_shared so that an action and its control block share one pooled block
+template <class T>
+class ActionPoolAllocator {
+ public:
+  using value_type = T;
+
+  explicit ActionPoolAllocator(std::shared_ptr<ActionPool> actionPool) : actionPool_(std::move(actionPool)) {}
+
+  template <class U>
+  ActionPoolAllocator(const ActionPoolAllocator<U>& other) : actionPool_(other.getActionPool()) {}  // NOLINT
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(actionPool_->allocate(n * sizeof(T)));
+  }
+
+  void deallocate(T* block, size_t n) {
+    actionPool_->deallocate(block, n * sizeof(T));
+  }
+
+  const std::shared_ptr<ActionPool>& getActionPool() const {
+    return actionPool_;
+  }
+
+  template <class U>
+  bool operator==(const ActionPoolAllocator<U>& other) const {
+    return actionPool_ == other.getActionPool();
+  }
+
+  template <class U>
+  bool operator!=(const ActionPoolAllocator<U>& other) const {
+    return actionPool_ != other.getActionPool();
+  }
+
+ private:
+  std::shared_ptr<ActionPool> actionPool_;
+};
+
+}  // namespace griddly
@@ -2,6 +2,7 @@
 #include <yaml-cpp/yaml.h>
 
 #include <fstream>
+#include <set>
 #include <sstream>
 #include <utility>
 
@@ -21,11 +22,6 @@ GDYFactory::GDYFactory(std::shared_ptr<ObjectGenerator> objectGenerator, std::sh
     : objectGenerator_(std::move(objectGenerator)),
       terminationGenerator_(std::move(terminationGenerator)),
       resourceConfig_(std::move(resourceConfig)) {
-#ifndef NDEBUG
-  spdlog::set_level(spdlog::level::debug);
-#else
-  spdlog::set_level(spdlog::level::info);
-#endif
 }
 
 void GDYFactory::initializeFromFile(std::string filename) {
@@ -191,6 +187,28 @@ VectorObserverConfig GDYFactory::parseNamedVectorObserverConfig(std::string obse
   config.includeRotation = resolveObserverConfigValue<bool>("IncludeRotation", observerConfigNode, config.includeRotation, !isGlobalObserver);
   config.includeVariables = resolveObserverConfigValue<bool>("IncludeVariables", observerConfigNode, config.includeVariables, !isGlobalObserver);
 
+  auto formatString = resolveObserverConfigValue<std::string>("Format", observerConfigNode, "DENSE", !isGlobalObserver);
+  if (formatString == "DENSE") {
+    config.format = VectorObservationFormat::DENSE;
+  } else if (formatString == "BIT_PACKED") {
+    config.format = VectorObservationFormat::BIT_PACKED;
+  } else if (formatString == "TYPE_IDS") {
+    config.format = VectorObservationFormat::TYPE_IDS;
+  } else if (formatString == "SPARSE") {
+    config.format = VectorObservationFormat::SPARSE;
+  } else {
+    throw std::invalid_argument(fmt::format("Invalid vector observation Format {0} for observer '{1}'", formatString, observerName));
+  }
+
+  // Each z index that objects are defined on is a layer of TYPE_IDS observations, from the lowest
+  if (config.format == VectorObservationFormat::TYPE_IDS) {
+    std::set<uint32_t> objectLayers;
+    for (const auto& objectDefinitionIt : objectGenerator_->getObjectDefinitions()) {
+      objectLayers.insert(objectDefinitionIt.second->zIdx);
+    }
+    config.objectLayers = std::vector<uint32_t>(objectLayers.begin(), objectLayers.end());
+  }
+
   return config;
 }
 
@@ -6,23 +6,126 @@
 
 #include "../../AStarPathFinder.hpp"
 #include "../../Grid.hpp"
-#include "../../SpatialHashCollisionDetector.hpp"
+#include "../../GridCollisionDetector.hpp"
 #include "../../Util/util.hpp"
 #include "../Actions/Action.hpp"
 #include "ObjectGenerator.hpp"
 
 namespace griddly {
 
+namespace {
+
+// Program compiled for an action id and object id, or nullptr if there is none
+const BehaviourProgram *findProgram(const std::vector<std::unordered_map<uint32_t, BehaviourProgram>> &programsByAction, uint32_t actionId, uint32_t objectNameId) {
+  if (actionId >= programsByAction.size()) {
+    return nullptr;
+  }
+
+  const auto &programsForAction = programsByAction[actionId];
+  auto programIt = programsForAction.find(objectNameId);
+  if (programIt == programsForAction.end()) {
+    return nullptr;
+  }
+
+  return &programIt->second;
+}
+
+BehaviourProgram &getOrAddProgram(std::vector<std::unordered_map<uint32_t, BehaviourProgram>> &programsByAction, uint32_t actionId, uint32_t objectNameId) {
+  if (actionId >= programsByAction.size()) {
+    programsByAction.resize(actionId + 1);
+  }
+  return programsByAction[actionId][objectNameId];
+}
+
+BehaviourOpCode getConditionOpCode(const std::string &commandName) {
+  if (commandName == "eq") {
+    return BehaviourOpCode::EQ;
+  } else if (commandName == "gt") {
+    return BehaviourOpCode::GT;
+  } else if (commandName == "gte") {
+    return BehaviourOpCode::GTE;
+  } else if (commandName == "lt") {
+    return BehaviourOpCode::LT;
+  } else if (commandName == "lte") {
+    return BehaviourOpCode::LTE;
+  } else if (commandName == "neq") {
+    return BehaviourOpCode::NEQ;
+  }
+
+  throw std::invalid_argument(fmt::format("Unknown or badly defined condition command {0}.", commandName));
+}
+
+bool evaluateCondition(BehaviourOpCode opCode, int32_t a, int32_t b) {
+  switch (opCode) {
+    case BehaviourOpCode::EQ:
+      return a == b;
+    case BehaviourOpCode::GT:
+      return a > b;
+    case BehaviourOpCode::GTE:
+      return a >= b;
+    case BehaviourOpCode::LT:
+      return a < b;
+    case BehaviourOpCode::LTE:
+      return a <= b;
+    case BehaviourOpCode::NEQ:
+      return a != b;
+    default:
+      return false;
+  }
+}
+
+uint32_t addObjectName(BehaviourProgram &program, std::string objectName) {
+  program.objectNames.push_back(std::move(objectName));
+  return static_cast<uint32_t>(program.objectNames.size() - 1);
+}
+
+}  // namespace
+
 Object::Object(std::string objectName, char mapCharacter, uint32_t playerId, uint32_t zIdx, std::unordered_map<std::string, std::shared_ptr<int32_t>> availableVariables, std::shared_ptr<ObjectGenerator> objectGenerator, std::weak_ptr<Grid> grid)
-    : objectName_(std::move(objectName)), mapCharacter_(mapCharacter), zIdx_(zIdx), objectGenerator_(std::move(objectGenerator)), grid_(std::move(grid)) {
-  availableVariables.insert({"_x", x_});
-  availableVariables.insert({"_y", y_});
+    : objectName_(std::move(objectName)), mapCharacter_(mapCharacter), zIdx_(zIdx), behaviourTable_(std::make_shared<ObjectBehaviourTable>()), objectGenerator_(std::move(objectGenerator)), grid_(std::move(grid)) {
+  // This object is not created from a shared behaviour table, so build a variable layout just for this object.
+  // Only the location and player id are stored in the object, the given variables are referenced like global variables.
+  auto addVariableSlot = [this](const std::string& variableName) {
+    auto slot = static_cast<uint32_t>(behaviourTable_->variableNames.size());
+    behaviourTable_->variableSlots.insert({variableName, slot});
+    behaviourTable_->variableNames.push_back(variableName);
+    return slot;
+  };
+
+  behaviourTable_->xSlot = addVariableSlot("_x");
+  behaviourTable_->ySlot = addVariableSlot("_y");
+  behaviourTable_->playerIdSlot = addVariableSlot("_playerId");
+  behaviourTable_->localVariableNames = behaviourTable_->variableNames;
+  behaviourTable_->localVariableCount = static_cast<uint32_t>(behaviourTable_->variableNames.size());
+  behaviourTable_->localVariableInitialValues.resize(behaviourTable_->localVariableCount, 0);
+
+  for (auto& variable : availableVariables) {
+    if (behaviourTable_->variableSlots.find(variable.first) == behaviourTable_->variableSlots.end()) {
+      addVariableSlot(variable.first);
+      globalVariables_.push_back(variable.second);
+    }
+  }
 
-  availableVariables.insert({"_playerId", playerId_});
+  auto variableStore = std::make_shared<ObjectVariableStore>(behaviourTable_->localVariableNames);
+  variableRow_ = variableStore->allocateRow(behaviourTable_->localVariableInitialValues);
+
+  x_ = variableRow_->getValuePtr(behaviourTable_->xSlot);
+  y_ = variableRow_->getValuePtr(behaviourTable_->ySlot);
+  playerId_ = variableRow_->getValuePtr(behaviourTable_->playerIdSlot);
+
+  *playerId_ = playerId;
+
+  renderTileName_ = objectName_ + std::to_string(renderTileId_);
+}
+
+Object::Object(std::string objectName, char mapCharacter, uint32_t playerId, uint32_t zIdx, std::shared_ptr<ObjectVariableRow> variableRow, std::vector<std::shared_ptr<int32_t>> globalVariables, std::shared_ptr<ObjectBehaviourTable> behaviourTable, std::shared_ptr<ObjectGenerator> objectGenerator, std::weak_ptr<Grid> grid)
+    : objectName_(std::move(objectName)), mapCharacter_(mapCharacter), zIdx_(zIdx), behaviourTable_(std::move(behaviourTable)), variableRow_(std::move(variableRow)), globalVariables_(std::move(globalVariables)), objectGenerator_(std::move(objectGenerator)), grid_(std::move(grid)) {
+  x_ = variableRow_->getValuePtr(behaviourTable_->xSlot);
+  y_ = variableRow_->getValuePtr(behaviourTable_->ySlot);
+  playerId_ = variableRow_->getValuePtr(behaviourTable_->playerIdSlot);
 
   *playerId_ = playerId;
 
-  availableVariables_ = availableVariables;
   renderTileName_ = objectName_ + std::to_string(renderTileId_);
 }
 
@@ -51,437 +154,403 @@ std::string Object::getDescription() const {
 }
 
 BehaviourResult Object::onActionSrc(std::string destinationObjectName, std::shared_ptr<Action> action) {
-  auto actionName = action->getActionName();
-
-  auto behavioursForActionIt = srcBehaviours_.find(actionName);
-  if (behavioursForActionIt == srcBehaviours_.end()) {
-    return {true};
-  }
+  auto actionId = action->getActionId(*behaviourTable_->actionSymbols);
+  auto destinationObjectNameId = behaviourTable_->objectSymbols->getId(destinationObjectName);
 
-  auto &behavioursForAction = behavioursForActionIt->second;
-
-  auto behavioursForActionAndDestinationObject = behavioursForAction.find(destinationObjectName);
-  if (behavioursForActionAndDestinationObject == behavioursForAction.end()) {
+  const auto *behaviourProgram = findProgram(behaviourTable_->srcBehaviours, actionId, destinationObjectNameId);
+  if (behaviourProgram == nullptr) {
     return {true};
   }
 
-  spdlog::debug("Executing behaviours for source [{0}] -> {1} -> {2}", getObjectName(), actionName, destinationObjectName);
-  auto &behaviours = behavioursForActionAndDestinationObject->second;
-
-  std::unordered_map<uint32_t, int32_t> rewardAccumulator;
-  for (auto &behaviour : behaviours) {
-    auto result = behaviour(action);
+  spdlog::debug("Executing behaviours for source [{0}] -> {1} -> {2}", getObjectName(), action->getActionName(), destinationObjectName);
 
-    accumulateRewards(rewardAccumulator, result.rewards);
-    if (result.abortAction) {
-      return {true, rewardAccumulator};
-    }
-  }
-
-  return {false, rewardAccumulator};
+  return runBehaviourProgram(*behaviourProgram, action);
 }
 
 BehaviourResult Object::onActionDst(std::shared_ptr<Action> action) {
-  auto actionName = action->getActionName();
-  auto sourceObject = action->getSourceObject();
-  auto sourceObjectName = sourceObject == nullptr ? "_empty" : sourceObject->getObjectName();
+  static const std::string emptyObjectName = "_empty";
 
-  auto behavioursForActionIt = dstBehaviours_.find(actionName);
-  if (behavioursForActionIt == dstBehaviours_.end()) {
-    spdlog::debug("Aborting dst behaviour, (no dst behaviours)", action->getDescription());
-    return {true};
-  }
-
-  auto &behavioursForAction = behavioursForActionIt->second;
+  auto actionId = action->getActionId(*behaviourTable_->actionSymbols);
+  auto sourceObject = action->getSourceObject();
+  const auto &sourceObjectName = sourceObject == nullptr ? emptyObjectName : sourceObject->getObjectName();
+  auto sourceObjectNameId = behaviourTable_->objectSymbols->getId(sourceObjectName);
 
-  auto behavioursForActionAndDestinationObject = behavioursForAction.find(sourceObjectName);
-  if (behavioursForActionAndDestinationObject == behavioursForAction.end()) {
+  const auto *behaviourProgram = findProgram(behaviourTable_->dstBehaviours, actionId, sourceObjectNameId);
+  if (behaviourProgram == nullptr) {
     spdlog::debug("Aborting dst behaviour, (no behaviours for action)", action->getDescription());
     return {true};
   }
 
-  spdlog::debug("Executing behaviours for destination {0} -> {1} -> [{2}]", sourceObjectName, actionName, getObjectName());
-  auto &behaviours = behavioursForActionAndDestinationObject->second;
-
-  std::unordered_map<uint32_t, int32_t> rewardAccumulator;
-  for (auto &behaviour : behaviours) {
-    auto result = behaviour(action);
-
-    accumulateRewards(rewardAccumulator, result.rewards);
-    if (result.abortAction) {
-      return {true, rewardAccumulator};
-    }
-  }
+  spdlog::debug("Executing behaviours for destination {0} -> {1} -> [{2}]", sourceObjectName, action->getActionName(), getObjectName());
 
-  return {false, rewardAccumulator};
+  return runBehaviourProgram(*behaviourProgram, action);
 }
 
-std::unordered_map<std::string, std::shared_ptr<ObjectVariable>> Object::resolveVariables(BehaviourCommandArguments commandArguments) {
-  std::unordered_map<std::string, std::shared_ptr<ObjectVariable>> resolvedVariables;
-  for (auto commandArgument : commandArguments) {
-    resolvedVariables[commandArgument.first] = std::make_shared<ObjectVariable>(ObjectVariable(commandArgument.second, availableVariables_));
+uint32_t Object::addOperand(BehaviourProgram &program, BehaviourCommandArguments &commandArguments, const std::string &argumentKey) const {
+  auto commandArgumentIt = commandArguments.find(argumentKey);
+  if (commandArgumentIt == commandArguments.end()) {
+    throw std::invalid_argument(fmt::format("Missing command argument {0}.", argumentKey));
   }
 
-  return resolvedVariables;
+  program.operands.emplace_back(commandArgumentIt->second, behaviourTable_->variableSlots);
+  return static_cast<uint32_t>(program.operands.size() - 1);
 }
 
-PreconditionFunction Object::instantiatePrecondition(std::string commandName, BehaviourCommandArguments commandArguments) {
-  std::function<bool(int32_t, int32_t)> condition;
-  if (commandName == "eq") {
-    condition = [](int32_t a, int32_t b) { return a == b; };
-  } else if (commandName == "gt") {
-    condition = [](int32_t a, int32_t b) { return a > b; };
-  } else if (commandName == "gte") {
-    condition = [](int32_t a, int32_t b) { return a >= b; };
-  } else if (commandName == "lt") {
-    condition = [](int32_t a, int32_t b) { return a < b; };
-  } else if (commandName == "lte") {
-    condition = [](int32_t a, int32_t b) { return a <= b; };
-  } else if (commandName == "neq") {
-    condition = [](int32_t a, int32_t b) { return a != b; };
-  } else {
-    throw std::invalid_argument(fmt::format("Unknown or badly defined condition command {0}.", commandName));
-  }
-
-  auto variablePointers = resolveVariables(commandArguments);
-
-  auto a = variablePointers["0"];
-  auto b = variablePointers["1"];
-
-  return [this, condition, a, b](std::shared_ptr<Action> action) {
-    return condition(a->resolve(action), b->resolve(action));
-  };
+void Object::compilePrecondition(BehaviourProgram &program, std::string commandName, BehaviourCommandArguments commandArguments) {
+  auto opCode = getConditionOpCode(commandName);
+  auto a = addOperand(program, commandArguments, "0");
+  auto b = addOperand(program, commandArguments, "1");
+  program.instructions.push_back({opCode, a, b});
 }
 
-BehaviourFunction Object::instantiateConditionalBehaviour(std::string commandName, BehaviourCommandArguments commandArguments, CommandList subCommands) {
-  if (subCommands.size() == 0) {
-    return instantiateBehaviour(commandName, commandArguments);
+void Object::compileConditionalBehaviour(BehaviourProgram &program, std::string commandName, BehaviourCommandArguments commandArguments, CommandList subCommands) {
+  if (subCommands.empty()) {
+    compileBehaviour(program, commandName, commandArguments);
+    return;
   }
 
-  std::function<bool(int32_t, int32_t)> condition;
-  if (commandName == "eq") {
-    condition = [](int32_t a, int32_t b) { return a == b; };
-  } else if (commandName == "gt") {
-    condition = [](int32_t a, int32_t b) { return a > b; };
-  } else if (commandName == "gte") {
-    condition = [](int32_t a, int32_t b) { return a >= b; };
-  } else if (commandName == "lt") {
-    condition = [](int32_t a, int32_t b) { return a < b; };
-  } else if (commandName == "lte") {
-    condition = [](int32_t a, int32_t b) { return a <= b; };
-  } else if (commandName == "neq") {
-    condition = [](int32_t a, int32_t b) { return a != b; };
-  } else {
-    throw std::invalid_argument(fmt::format("Unknown or badly defined condition command {0}.", commandName));
-  }
+  auto opCode = getConditionOpCode(commandName);
+  auto a = addOperand(program, commandArguments, "0");
+  auto b = addOperand(program, commandArguments, "1");
 
-  std::vector<BehaviourFunction> conditionalBehaviours;
+  auto conditionIdx = program.instructions.size();
+  program.instructions.push_back({opCode, a, b});
 
-  for (auto subCommand : subCommands) {
-    auto subCommandName = subCommand.first;
-    auto subCommandVariables = subCommand.second;
-
-    conditionalBehaviours.push_back(instantiateBehaviour(subCommandName, subCommandVariables));
+  for (auto &subCommand : subCommands) {
+    compileBehaviour(program, subCommand.first, subCommand.second);
   }
 
-  auto variablePointers = resolveVariables(commandArguments);
-  auto a = variablePointers["0"];
-  auto b = variablePointers["1"];
-
-  return [this, condition, conditionalBehaviours, a, b](std::shared_ptr<Action> action) -> BehaviourResult {
-    if (condition(a->resolve(action), b->resolve(action))) {
-      std::unordered_map<uint32_t, int32_t> rewardAccumulator;
-      for (auto &behaviour : conditionalBehaviours) {
-        auto result = behaviour(action);
-
-        accumulateRewards(rewardAccumulator, result.rewards);
-        if (result.abortAction) {
-          return {true, rewardAccumulator};
-        }
-      }
-
-      return {false, rewardAccumulator};
-    }
-
-    return {};
-  };
+  // Skip the sub commands if the condition fails
+  program.instructions[conditionIdx].jumpTarget = static_cast<uint32_t>(program.instructions.size());
 }
 
-BehaviourFunction Object::instantiateBehaviour(std::string commandName, BehaviourCommandArguments commandArguments) {
+void Object::compileBehaviour(BehaviourProgram &program, std::string commandName, BehaviourCommandArguments commandArguments) {
+  auto &instructions = program.instructions;
+
   // Command just used in tests
   if (commandName == "nop") {
-    return [this](std::shared_ptr<Action> action) -> BehaviourResult {
-      return {};
-    };
+    instructions.push_back({BehaviourOpCode::NOP});
+    return;
   }
 
-  // reward the player that owns this particular object, otherwise warn
   if (commandName == "reward") {
-    auto variablePointers = resolveVariables(commandArguments);
-    auto value = variablePointers["0"];
-    return [this, value](std::shared_ptr<Action> action) -> BehaviourResult {
-      // if the object has a player Id, the reward will be given to that object's player,
-      // otherwise the reward will be given to the player which has performed the action
-      auto rewardPlayer = getPlayerId() == 0 ? action->getOriginatingPlayerId() : getPlayerId();
-
-      if (rewardPlayer == 0) {
-        spdlog::warn("Misconfigured 'reward' for object '{0}' will not be assigned to a player.", action->getSourceObject()->getDescription());
-        return {};
-      }
-
-      // Find the player id of this object and give rewards to this player.
-      return {false, {{rewardPlayer, value->resolve(action)}}};
-    };
+    instructions.push_back({BehaviourOpCode::REWARD, addOperand(program, commandArguments, "0")});
+    return;
   }
 
   if (commandName == "change_to") {
-    auto objectName = commandArguments["0"].as<std::string>();
-    return [this, objectName](std::shared_ptr<Action> action) -> BehaviourResult {
-      spdlog::debug("Changing object={0} to {1}", getObjectName(), objectName);
-      auto playerId = getPlayerId();
-      auto location = getLocation();
-      auto newObject = objectGenerator_->newInstance(objectName, playerId, grid());
-      removeObject();
-      grid()->addObject(location, newObject, true, action);
-      return {};
-    };
-  }
-
-  if (commandName == "add") {
-    auto variablePointers = resolveVariables(commandArguments);
-    auto a = variablePointers["0"];
-    auto b = variablePointers["1"];
-    return [this, a, b](std::shared_ptr<Action> action) -> BehaviourResult {
-      *a->resolve_ptr(action) += b->resolve(action);
-      grid()->invalidateLocation(getLocation());
-      return {};
-    };
-  }
-
-  if (commandName == "sub") {
-    auto variablePointers = resolveVariables(commandArguments);
-    auto a = variablePointers["0"];
-    auto b = variablePointers["1"];
-    return [this, a, b](std::shared_ptr<Action> action) -> BehaviourResult {
-      *a->resolve_ptr(action) -= b->resolve(action);
-      grid()->invalidateLocation(getLocation());
-      return {};
-    };
-  }
-
-  if (commandName == "set") {
-    auto variablePointers = resolveVariables(commandArguments);
-    auto a = variablePointers["0"];
-    auto b = variablePointers["1"];
-    return [this, a, b](std::shared_ptr<Action> action) -> BehaviourResult {
-      spdlog::debug("set");
-      *a->resolve_ptr(action) = b->resolve(action);
-      grid()->invalidateLocation(getLocation());
-      return {};
-    };
-  }
-
-  if (commandName == "incr") {
-    auto variablePointers = resolveVariables(commandArguments);
-    auto a = variablePointers["0"];
-    return [this, a](std::shared_ptr<Action> action) -> BehaviourResult {
-      spdlog::debug("incr");
-      (*a->resolve_ptr(action)) += 1;
-      grid()->invalidateLocation(getLocation());
-      return {};
-    };
-  }
-
-  if (commandName == "decr") {
-    auto variablePointers = resolveVariables(commandArguments);
-    auto a = variablePointers["0"];
-    return [this, a](std::shared_ptr<Action> action) -> BehaviourResult {
-      spdlog::debug("decr");
-      (*a->resolve_ptr(action)) -= 1;
-      grid()->invalidateLocation(getLocation());
-      return {};
-    };
+    instructions.push_back({BehaviourOpCode::CHANGE_TO, addObjectName(program, commandArguments["0"].as<std::string>())});
+    return;
+  }
+
+  if (commandName == "add" || commandName == "sub" || commandName == "set") {
+    auto opCode = commandName == "add" ? BehaviourOpCode::ADD : commandName == "sub" ? BehaviourOpCode::SUB : BehaviourOpCode::SET;
+    auto a = addOperand(program, commandArguments, "0");
+    auto b = addOperand(program, commandArguments, "1");
+    instructions.push_back({opCode, a, b});
+    return;
+  }
+
+  if (commandName == "incr" || commandName == "decr") {
+    auto opCode = commandName == "incr" ? BehaviourOpCode::INCR : BehaviourOpCode::DECR;
+    instructions.push_back({opCode, addOperand(program, commandArguments, "0")});
+    return;
   }
 
   if (commandName == "rot") {
     if (commandArguments["0"].as<std::string>() == "_dir") {
-      return [this](std::shared_ptr<Action> action) -> BehaviourResult {
-        orientation_ = DiscreteOrientation(action->getOrientationVector());
-
-        // redraw the current location
-        grid()->invalidateLocation(getLocation());
-        return {};
-      };
+      instructions.push_back({BehaviourOpCode::ROT_DIR});
+      return;
     }
   }
 
   if (commandName == "mov") {
     if (commandArguments["0"].as<std::string>() == "_dest") {
-      return [this](std::shared_ptr<Action> action) -> BehaviourResult {
-        auto objectMoved = moveObject(action->getDestinationLocation());
-        return {!objectMoved};
-      };
+      instructions.push_back({BehaviourOpCode::MOV_DEST});
+      return;
     }
 
     if (commandArguments["0"].as<std::string>() == "_src") {
-      return [this](std::shared_ptr<Action> action) -> BehaviourResult {
-        auto objectMoved = moveObject(action->getSourceLocation());
-        return {!objectMoved};
-      };
+      instructions.push_back({BehaviourOpCode::MOV_SRC});
+      return;
     }
 
-    auto variablePointers = resolveVariables(commandArguments);
-
-    if (variablePointers.size() != 2) {
-      spdlog::error("Bad mov command detected! There should be two arguments but {0} were provided. This command will be ignored.", variablePointers.size());
-      return [this](std::shared_ptr<Action> action) -> BehaviourResult {
-        return {};
-      };
+    if (commandArguments.size() != 2) {
+      spdlog::error("Bad mov command detected! There should be two arguments but {0} were provided. This command will be ignored.", commandArguments.size());
+      instructions.push_back({BehaviourOpCode::NOP});
+      return;
     }
 
-    auto x = variablePointers["0"];
-    auto y = variablePointers["1"];
-
-    return [this, x, y](std::shared_ptr<Action> action) -> BehaviourResult {
-      auto objectMoved = moveObject({x->resolve(action), y->resolve(action)});
-      return {!objectMoved};
-    };
+    auto x = addOperand(program, commandArguments, "0");
+    auto y = addOperand(program, commandArguments, "1");
+    instructions.push_back({BehaviourOpCode::MOV, x, y});
+    return;
   }
 
   if (commandName == "cascade") {
-    auto a = commandArguments["0"].as<std::string>();
-    return [this, a](std::shared_ptr<Action> action) -> BehaviourResult {
-      if (a == "_dest") {
-        std::shared_ptr<Action> cascadedAction = std::make_shared<Action>(Action(grid(), action->getActionName(), action->getOriginatingPlayerId(), action->getDelay(), action->getMetaData()));
+    if (commandArguments["0"].as<std::string>() == "_dest") {
+      instructions.push_back({BehaviourOpCode::CASCADE_DEST});
+    } else {
+      instructions.push_back({BehaviourOpCode::CASCADE_UNSUPPORTED});
+    }
+    return;
+  }
 
-        cascadedAction->init(action->getDestinationObject(), action->getVectorToDest(), action->getOrientationVector(), false);
+  if (commandName == "exec") {
+    ExecCommand execCommand;
+    execCommand.actionName = getCommandArgument<std::string>(commandArguments, "Action", "");
+    execCommand.delay = getCommandArgument<uint32_t>(commandArguments, "Delay", 0);
+    execCommand.randomize = getCommandArgument<bool>(commandArguments, "Randomize", false);
+    execCommand.actionId = getCommandArgument<uint32_t>(commandArguments, "ActionId", 0);
+    execCommand.executor = getActionExecutorFromString(getCommandArgument<std::string>(commandArguments, "Executor", "action"));
 
-        auto sourceLocation = cascadedAction->getSourceLocation();
-        auto destinationLocation = cascadedAction->getDestinationLocation();
-        auto vectorToDest = action->getVectorToDest();
-        spdlog::debug("Cascade vector [{0},{1}]", vectorToDest.x, vectorToDest.y);
-        spdlog::debug("Cascading action to [{0},{1}], dst: [{2}, {3}]", sourceLocation.x, sourceLocation.y, destinationLocation.x, destinationLocation.y);
+    auto searchNode = getCommandArgument<YAML::Node>(commandArguments, "Search", YAML::Node(YAML::NodeType::Undefined));
+    execCommand.pathFinderConfig = configurePathFinder(searchNode, execCommand.actionName);
 
-        auto actionRewards = grid()->performActions(0, {cascadedAction});
+    program.execCommands.push_back(std::move(execCommand));
+    instructions.push_back({BehaviourOpCode::EXEC, static_cast<uint32_t>(program.execCommands.size() - 1)});
+    return;
+  }
 
-        return {false, actionRewards};
-      }
+  if (commandName == "remove") {
+    instructions.push_back({BehaviourOpCode::REMOVE});
+    return;
+  }
 
-      spdlog::warn("The only supported variable for cascade is _dest.");
+  if (commandName == "set_tile") {
+    instructions.push_back({BehaviourOpCode::SET_TILE, addOperand(program, commandArguments, "0")});
+    return;
+  }
 
-      return {true};
-    };
+  if (commandName == "spawn") {
+    instructions.push_back({BehaviourOpCode::SPAWN, addObjectName(program, commandArguments["0"].as<std::string>())});
+    return;
   }
 
-  if (commandName == "exec") {
-    auto actionName = getCommandArgument<std::string>(commandArguments, "Action", "");
-    auto delay = getCommandArgument<uint32_t>(commandArguments, "Delay", 0);
-    auto randomize = getCommandArgument<bool>(commandArguments, "Randomize", false);
-    auto actionId = getCommandArgument<uint32_t>(commandArguments, "ActionId", 0);
-    auto executor = getCommandArgument<std::string>(commandArguments, "Executor", "action");
-    auto searchNode = getCommandArgument<YAML::Node>(commandArguments, "Search", YAML::Node(YAML::NodeType::Undefined));
+  throw std::invalid_argument(fmt::format("Unknown or badly defined command {0}.", commandName));
+}
 
-    PathFinderConfig pathFinderConfig = configurePathFinder(searchNode, actionName);
+bool Object::checkPreconditions(const BehaviourProgram &program, const std::shared_ptr<Action> &action) const {
+  const auto &operands = program.operands;
+  for (const auto &instruction : program.instructions) {
+    if (!evaluateCondition(instruction.opCode, operands[instruction.a].resolve(*this, action), operands[instruction.b].resolve(*this, action))) {
+      return false;
+    }
+  }
+  return true;
+}
 
-    auto actionExecutor = getActionExecutorFromString(executor);
+BehaviourResult Object::runBehaviourProgram(const BehaviourProgram &program, const std::shared_ptr<Action> &action) {
+  const auto &instructions = program.instructions;
+  const auto &operands = program.operands;
 
-    // Resolve source object
-    return [this, actionName, delay, randomize, actionId, actionExecutor, pathFinderConfig](std::shared_ptr<Action> action) -> BehaviourResult {
-      InputMapping fallbackInputMapping;
-      fallbackInputMapping.vectorToDest = action->getVectorToDest();
-      fallbackInputMapping.orientationVector = action->getOrientationVector();
+  BehaviourResult result;
 
-      SingleInputMapping inputMapping;
-      if (pathFinderConfig.pathFinder != nullptr) {
-        spdlog::debug("Executing action based on PathFinder");
-        auto endLocation = pathFinderConfig.endLocation;
-        if (pathFinderConfig.collisionDetector != nullptr) {
-          auto searchResult = pathFinderConfig.collisionDetector->search(getLocation());
+  // Keeps variables of other objects alive while they are modified
+  std::shared_ptr<int32_t> variableOwner;
+  int32_t scratch = 0;
 
-          if (searchResult.objectSet.empty()) {
-            spdlog::debug("Cannot find target object for pathfinding!");
-            return {};
-          }
+  uint32_t pc = 0;
+  while (pc < instructions.size()) {
+    const auto &instruction = instructions[pc++];
 
-          endLocation = searchResult.closestObjects.at(0)->getLocation();
+    switch (instruction.opCode) {
+      case BehaviourOpCode::NOP:
+        break;
+
+      case BehaviourOpCode::REWARD: {
+        // if the object has a player Id, the reward will be given to that object's player,
+        // otherwise the reward will be given to the player which has performed the action
+        auto rewardPlayer = getPlayerId() == 0 ? action->getOriginatingPlayerId() : getPlayerId();
+
+        if (rewardPlayer == 0) {
+          spdlog::warn("Misconfigured 'reward' for object '{0}' will not be assigned to a player.", action->getSourceObject()->getDescription());
+          break;
         }
 
-        spdlog::debug("Searching for path from [{0},{1}] to [{2},{3}] using action {4}", getLocation().x, getLocation().y, endLocation.x, endLocation.y, actionName);
+        // Find the player id of this object and give rewards to this player.
+        result.rewards[rewardPlayer] += operands[instruction.a].resolve(*this, action);
+      } break;
+
+      case BehaviourOpCode::CHANGE_TO: {
+        const auto &objectName = program.objectNames[instruction.a];
+        spdlog::debug("Changing object={0} to {1}", getObjectName(), objectName);
+        auto playerId = getPlayerId();
+        auto location = getLocation();
+        auto newObject = objectGenerator_->newInstance(objectName, playerId, grid());
+        removeObject();
+        grid()->addObject(location, newObject, true, action);
+      } break;
+
+      case BehaviourOpCode::ADD: {
+        auto value = operands[instruction.b].resolve(*this, action);
+        *resolveVariableForUpdate(operands[instruction.a], action, variableOwner, scratch) += value;
+      } break;
+
+      case BehaviourOpCode::SUB: {
+        auto value = operands[instruction.b].resolve(*this, action);
+        *resolveVariableForUpdate(operands[instruction.a], action, variableOwner, scratch) -= value;
+      } break;
+
+      case BehaviourOpCode::SET: {
+        auto value = operands[instruction.b].resolve(*this, action);
+        *resolveVariableForUpdate(operands[instruction.a], action, variableOwner, scratch) = value;
+      } break;
+
+      case BehaviourOpCode::INCR:
+        *resolveVariableForUpdate(operands[instruction.a], action, variableOwner, scratch) += 1;
+        break;
+
+      case BehaviourOpCode::DECR:
+        *resolveVariableForUpdate(operands[instruction.a], action, variableOwner, scratch) -= 1;
+        break;
+
+      case BehaviourOpCode::ROT_DIR:
+        recordAppearanceChange();
+        orientation_ = DiscreteOrientation(action->getOrientationVector());
 
-        auto searchResult = pathFinderConfig.pathFinder->search(getLocation(), endLocation, getObjectOrientation().getUnitVector(), pathFinderConfig.maxSearchDepth);
-        inputMapping = getInputMapping(actionName, searchResult.actionId, false, fallbackInputMapping);
-      } else {
-        inputMapping = getInputMapping(actionName, actionId, randomize, fallbackInputMapping);
-      }
+        // redraw the current location
+        grid()->invalidateLocation(getLocation());
+        break;
 
-      if (inputMapping.mappedToGrid) {
-        inputMapping.vectorToDest = inputMapping.destinationLocation - getLocation();
-      }
+      case BehaviourOpCode::MOV_DEST:
+        if (!moveObject(action->getDestinationLocation())) {
+          result.abortAction = true;
+          return result;
+        }
+        break;
 
-      uint32_t execAsPlayerId = 0;
-      switch (actionExecutor) {
-        case ActionExecutor::ACTION_PLAYER_ID:
-          execAsPlayerId = action->getOriginatingPlayerId();
-          break;
-        case ActionExecutor::OBJECT_PLAYER_ID:
-          execAsPlayerId = getPlayerId();
-          break;
-        default:
-          break;
-      }
+      case BehaviourOpCode::MOV_SRC:
+        if (!moveObject(action->getSourceLocation())) {
+          result.abortAction = true;
+          return result;
+        }
+        break;
 
-      std::shared_ptr<Action> newAction = std::make_shared<Action>(Action(grid(), actionName, execAsPlayerId, delay, inputMapping.metaData));
-      newAction->init(shared_from_this(), inputMapping.vectorToDest, inputMapping.orientationVector, inputMapping.relative);
+      case BehaviourOpCode::MOV: {
+        glm::ivec2 location{operands[instruction.a].resolve(*this, action), operands[instruction.b].resolve(*this, action)};
+        if (!moveObject(location)) {
+          result.abortAction = true;
+          return result;
+        }
+      } break;
 
-      auto rewards = grid()->performActions(0, {newAction});
+      case BehaviourOpCode::CASCADE_DEST: {
+        auto cascadedAction = grid()->createAction(action->getActionName(), action->getOriginatingPlayerId(), action->getDelay(), action->getMetaData());
 
-      return {false, rewards};
-    };
-  }
+        cascadedAction->init(action->getDestinationObject(), action->getVectorToDest(), action->getOrientationVector(), false);
 
-  if (commandName == "remove") {
-    return [this](std::shared_ptr<Action> action) -> BehaviourResult {
-      spdlog::debug("remove");
-      removeObject();
-      return {};
-    };
-  }
+        auto sourceLocation = cascadedAction->getSourceLocation();
+        auto destinationLocation = cascadedAction->getDestinationLocation();
+        auto vectorToDest = action->getVectorToDest();
+        spdlog::debug("Cascade vector [{0},{1}]", vectorToDest.x, vectorToDest.y);
+        spdlog::debug("Cascading action to [{0},{1}], dst: [{2}, {3}]", sourceLocation.x, sourceLocation.y, destinationLocation.x, destinationLocation.y);
 
-  if (commandName == "set_tile") {
-    auto variablePointers = resolveVariables(commandArguments);
+        auto actionRewards = grid()->performActions(0, {cascadedAction});
+        accumulateRewards(result.rewards, actionRewards);
+      } break;
+
+      case BehaviourOpCode::CASCADE_UNSUPPORTED:
+        spdlog::warn("The only supported variable for cascade is _dest.");
+        result.abortAction = true;
+        return result;
+
+      case BehaviourOpCode::EXEC: {
+        const auto &execCommand = program.execCommands[instruction.a];
+        const auto &pathFinderConfig = execCommand.pathFinderConfig;
+
+        InputMapping fallbackInputMapping;
+        fallbackInputMapping.vectorToDest = action->getVectorToDest();
+        fallbackInputMapping.orientationVector = action->getOrientationVector();
+
+        SingleInputMapping inputMapping;
+        if (pathFinderConfig.pathFinder != nullptr) {
+          spdlog::debug("Executing action based on PathFinder");
+          auto endLocation = pathFinderConfig.endLocation;
+          if (pathFinderConfig.collisionDetector != nullptr) {
+            auto searchResult = pathFinderConfig.collisionDetector->search(getLocation());
+
+            if (searchResult.objectSet.empty()) {
+              spdlog::debug("Cannot find target object for pathfinding!");
+              break;
+            }
+
+            endLocation = searchResult.closestObjects.at(0)->getLocation();
+          }
 
-    auto tileId = variablePointers["0"];
+          spdlog::debug("Searching for path from [{0},{1}] to [{2},{3}] using action {4}", getLocation().x, getLocation().y, endLocation.x, endLocation.y, execCommand.actionName);
 
-    return [this, tileId](std::shared_ptr<Action> action) -> BehaviourResult {
-      auto resolvedTileId = tileId->resolve(action);
-      spdlog::debug("Setting tile Id to: {0}", resolvedTileId);
-      setRenderTileId(resolvedTileId);
-      grid()->invalidateLocation({*x_, *y_});
-      spdlog::debug("Tile id updated");
-      return {};
-    };
-  }
+          auto searchResult = pathFinderConfig.pathFinder->search(getLocation(), endLocation, getObjectOrientation().getUnitVector(), pathFinderConfig.maxSearchDepth);
+          inputMapping = getInputMapping(execCommand.actionName, searchResult.actionId, false, fallbackInputMapping);
+        } else {
+          inputMapping = getInputMapping(execCommand.actionName, execCommand.actionId, execCommand.randomize, fallbackInputMapping);
+        }
 
-  if (commandName == "spawn") {
-    auto objectName = commandArguments["0"].as<std::string>();
-    return [this, objectName](std::shared_ptr<Action> action) -> BehaviourResult {
-      auto destinationLocation = action->getDestinationLocation();
-      spdlog::debug("Spawning object={0} in location [{1},{2}]", objectName, destinationLocation.x, destinationLocation.y);
-      auto playerId = getPlayerId();
+        if (inputMapping.mappedToGrid) {
+          inputMapping.vectorToDest = inputMapping.destinationLocation - getLocation();
+        }
+
+        uint32_t execAsPlayerId = 0;
+        switch (execCommand.executor) {
+          case ActionExecutor::ACTION_PLAYER_ID:
+            execAsPlayerId = action->getOriginatingPlayerId();
+            break;
+          case ActionExecutor::OBJECT_PLAYER_ID:
+            execAsPlayerId = getPlayerId();
+            break;
+          default:
+            break;
+        }
 
-      auto newObject = objectGenerator_->newInstance(objectName, playerId, grid());
-      grid()->addObject(destinationLocation, newObject, true, action);
-      return {};
-    };
+        auto newAction = grid()->createAction(execCommand.actionName, execAsPlayerId, execCommand.delay, std::move(inputMapping.metaData));
+        newAction->init(shared_from_this(), inputMapping.vectorToDest, inputMapping.orientationVector, inputMapping.relative);
+
+        auto rewards = grid()->performActions(0, {newAction});
+        accumulateRewards(result.rewards, rewards);
+      } break;
+
+      case BehaviourOpCode::REMOVE:
+        spdlog::debug("remove");
+        removeObject();
+        break;
+
+      case BehaviourOpCode::SET_TILE: {
+        auto resolvedTileId = operands[instruction.a].resolve(*this, action);
+        spdlog::debug("Setting tile Id to: {0}", resolvedTileId);
+        recordAppearanceChange();
+        setRenderTileId(resolvedTileId);
+        grid()->invalidateLocation({*x_, *y_});
+      } break;
+
+      case BehaviourOpCode::SPAWN: {
+        const auto &objectName = program.objectNames[instruction.a];
+        auto destinationLocation = action->getDestinationLocation();
+        spdlog::debug("Spawning object={0} in location [{1},{2}]", objectName, destinationLocation.x, destinationLocation.y);
+        auto playerId = getPlayerId();
+
+        auto newObject = objectGenerator_->newInstance(objectName, playerId, grid());
+        grid()->addObject(destinationLocation, newObject, true, action);
+      } break;
+
+      default:
+        if (!evaluateCondition(instruction.opCode, operands[instruction.a].resolve(*this, action), operands[instruction.b].resolve(*this, action))) {
+          pc = instruction.jumpTarget;
+        }
+        break;
+    }
   }
 
-  throw std::invalid_argument(fmt::format("Unknown or badly defined command {0}.", commandName));
+  return result;
 }
 
 void Object::addPrecondition(std::string actionName, std::string destinationObjectName, std::string commandName, BehaviourCommandArguments commandArguments) {
   spdlog::debug("Adding action precondition command={0} when action={1} is performed on object={2} by object={3}", commandName, actionName, destinationObjectName, getObjectName());
-  auto preconditionFunction = instantiatePrecondition(commandName, commandArguments);
-  actionPreconditions_[actionName][destinationObjectName].push_back(preconditionFunction);
+  auto &behaviourTable = mutableBehaviourTable();
+  auto actionId = behaviourTable.actionSymbols->intern(actionName);
+  auto destinationObjectNameId = behaviourTable.objectSymbols->intern(destinationObjectName);
+
+  auto &preconditionProgram = getOrAddProgram(behaviourTable.actionPreconditions, actionId, destinationObjectNameId);
+  compilePrecondition(preconditionProgram, commandName, commandArguments);
 }
 
 void Object::addActionSrcBehaviour(
@@ -492,11 +561,18 @@ void Object::addActionSrcBehaviour(
     CommandList conditionalCommands) {
   spdlog::debug("Adding behaviour command={0} when action={1} is performed on object={2} by object={3}", commandName, actionName, destinationObjectName, getObjectName());
 
-  // This object can perform this action
-  availableActionNames_.insert(actionName);
+  auto &behaviourTable = mutableBehaviourTable();
+  auto actionId = behaviourTable.actionSymbols->intern(actionName);
+  auto destinationObjectNameId = behaviourTable.objectSymbols->intern(destinationObjectName);
+
+  // Compile into a copy so the program is left unchanged if the command is invalid
+  const auto *existingProgram = findProgram(behaviourTable.srcBehaviours, actionId, destinationObjectNameId);
+  auto behaviourProgram = existingProgram == nullptr ? BehaviourProgram() : *existingProgram;
+  compileConditionalBehaviour(behaviourProgram, commandName, commandArguments, conditionalCommands);
 
-  auto behaviourFunction = instantiateConditionalBehaviour(commandName, commandArguments, conditionalCommands);
-  srcBehaviours_[actionName][destinationObjectName].push_back(behaviourFunction);
+  // This object can perform this action
+  behaviourTable.availableActionNames.insert(actionName);
+  getOrAddProgram(behaviourTable.srcBehaviours, actionId, destinationObjectNameId) = std::move(behaviourProgram);
 }
 
 void Object::addActionDstBehaviour(
@@ -507,16 +583,34 @@ void Object::addActionDstBehaviour(
     CommandList conditionalCommands) {
   spdlog::debug("Adding behaviour command={0} when object={1} performs action={2} on object={3}", commandName, sourceObjectName, actionName, getObjectName());
 
-  auto behaviourFunction = instantiateConditionalBehaviour(commandName, commandArguments, conditionalCommands);
-  dstBehaviours_[actionName][sourceObjectName].push_back(behaviourFunction);
+  auto &behaviourTable = mutableBehaviourTable();
+  auto actionId = behaviourTable.actionSymbols->intern(actionName);
+  auto sourceObjectNameId = behaviourTable.objectSymbols->intern(sourceObjectName);
+
+  // Compile into a copy so the program is left unchanged if the command is invalid
+  const auto *existingProgram = findProgram(behaviourTable.dstBehaviours, actionId, sourceObjectNameId);
+  auto behaviourProgram = existingProgram == nullptr ? BehaviourProgram() : *existingProgram;
+  compileConditionalBehaviour(behaviourProgram, commandName, commandArguments, conditionalCommands);
+
+  getOrAddProgram(behaviourTable.dstBehaviours, actionId, sourceObjectNameId) = std::move(behaviourProgram);
 }
 
 bool Object::isValidAction(std::shared_ptr<Action> action) const {
-  auto actionName = action->getActionName();
+  static const std::string boundaryObjectName = "_boundary";
+
+  const auto &actionName = action->getActionName();
+  auto actionId = action->getActionId(*behaviourTable_->actionSymbols);
   auto destinationObject = action->getDestinationObject();
 
-  std::string destinationObjectName = destinationObject->getObjectName();
-  if (destinationObjectName == "_empty") {
+  // There are no source behaviours for this action, so this action cannot happen
+  const auto &srcBehaviours = behaviourTable_->srcBehaviours;
+  if (actionId >= srcBehaviours.size() || srcBehaviours[actionId].empty()) {
+    spdlog::debug("No source behaviours for action {0} on object {1}", actionName, objectName_);
+    return false;
+  }
+
+  const auto *destinationObjectNamePtr = &destinationObject->getObjectName();
+  if (*destinationObjectNamePtr == "_empty") {
     auto width = grid()->getWidth();
     auto height = grid()->getHeight();
 
@@ -524,65 +618,104 @@ bool Object::isValidAction(std::shared_ptr<Action> action) const {
     auto destinationLocation = action->getDestinationLocation();
     if (destinationLocation.x >= width || destinationLocation.x < 0 ||
         destinationLocation.y >= height || destinationLocation.y < 0) {
-      destinationObjectName = "_boundary";
+      destinationObjectNamePtr = &boundaryObjectName;
     }
   }
 
-  spdlog::debug("Checking preconditions for action [{0}] -> {1} -> {2}", getObjectName(), actionName, destinationObjectName);
+  const auto &destinationObjectName = *destinationObjectNamePtr;
+  auto destinationObjectNameId = behaviourTable_->objectSymbols->getId(destinationObjectName);
 
-  // There are no source behaviours for this action, so this action cannot happen
-  auto it = srcBehaviours_.find(actionName);
-  if (it == srcBehaviours_.end()) {
-    spdlog::debug("No source behaviours for action {0} on object {1}", actionName, objectName_);
-    return false;
-  }
+  spdlog::debug("Checking preconditions for action [{0}] -> {1} -> {2}", getObjectName(), actionName, destinationObjectName);
 
   // Check the source behaviours against the destination object
-  if (it->second.find(destinationObjectName) == it->second.end()) {
+  if (findProgram(srcBehaviours, actionId, destinationObjectNameId) == nullptr) {
     spdlog::debug("No destination behaviours for object {0} performing action {1} on object {2}", objectName_, actionName, destinationObjectName);
     return false;
   }
 
-  // Check for preconditions
-  auto preconditionsForActionIt = actionPreconditions_.find(actionName);
-
-  // If there are no preconditions then we just let the action happen
-  if (preconditionsForActionIt == actionPreconditions_.end()) {
+  // Check for preconditions, if there are none then we just let the action happen
+  const auto *preconditionProgram = findProgram(behaviourTable_->actionPreconditions, actionId, destinationObjectNameId);
+  if (preconditionProgram == nullptr) {
+    spdlog::debug("No preconditions with destination object {0}. Passing.", destinationObjectName);
     return true;
   }
 
-  auto &preconditionsForAction = preconditionsForActionIt->second;
-  spdlog::debug("{0} preconditions found.", preconditionsForAction.size());
+  spdlog::debug("{0} preconditions found.", preconditionProgram->instructions.size());
 
-  auto preconditionsForActionAndDestinationObjectIt = preconditionsForAction.find(destinationObjectName);
-  if (preconditionsForActionAndDestinationObjectIt == preconditionsForAction.end()) {
-    spdlog::debug("Precondition found, but not with destination object {0}. Passing.", destinationObjectName);
-    return true;
+  if (!checkPreconditions(*preconditionProgram, action)) {
+    spdlog::debug("Precondition check failed for object {0} performing action {1} on object {2}", objectName_, actionName, destinationObjectName);
+    return false;
   }
 
-  auto &preconditions = preconditionsForActionAndDestinationObjectIt->second;
+  return true;
+}
 
-  for (auto precondition : preconditions) {
-    if (!precondition(action)) {
-      spdlog::debug("Precondition check failed for object {0} performing action {1} on object {2}", objectName_, actionName, destinationObjectName);
-      return false;
-    }
+bool Object::preconditionsReadGlobalVariables(const std::string &actionName) const {
+  auto actionId = behaviourTable_->actionSymbols->getId(actionName);
+  const auto &actionPreconditions = behaviourTable_->actionPreconditions;
+  if (actionId >= actionPreconditions.size()) {
+    return false;
   }
 
-  return true;
+  for (const auto &preconditionProgram : actionPreconditions[actionId]) {
+    for (const auto &operand : preconditionProgram.second.operands) {
+      if (operand.readsGlobalVariable(behaviourTable_->variableSlots, behaviourTable_->localVariableCount)) {
+        return true;
+      }
+    }
+  }
+  return false;
 }
 
 std::unordered_map<std::string, std::shared_ptr<int32_t>> Object::getAvailableVariables() const {
-  return availableVariables_;
+  std::unordered_map<std::string, std::shared_ptr<int32_t>> availableVariables;
+  const auto &variableNames = behaviourTable_->variableNames;
+  for (uint32_t slot = 0; slot < behaviourTable_->localVariableCount; slot++) {
+    availableVariables.insert({variableNames[slot], std::shared_ptr<int32_t>(variableRow_, variableRow_->getValuePtr(slot))});
+  }
+  for (uint32_t slot = behaviourTable_->localVariableCount; slot < variableNames.size(); slot++) {
+    availableVariables.insert({variableNames[slot], globalVariables_[slot - behaviourTable_->localVariableCount]});
+  }
+  return availableVariables;
 }
 
 std::shared_ptr<int32_t> Object::getVariableValue(std::string variableName) {
-  auto it = availableVariables_.find(variableName);
-  if (it == availableVariables_.end()) {
+  const auto &variableSlots = behaviourTable_->variableSlots;
+  auto it = variableSlots.find(variableName);
+  if (it == variableSlots.end()) {
     return nullptr;
   }
 
-  return it->second;
+  auto slot = it->second;
+  if (slot < behaviourTable_->localVariableCount) {
+    // Keeps the variable row alive for as long as the value is referenced
+    return std::shared_ptr<int32_t>(variableRow_, variableRow_->getValuePtr(slot));
+  }
+
+  return globalVariables_[slot - behaviourTable_->localVariableCount];
+}
+
+int32_t *Object::getVariableValueAt(uint32_t variableSlot) const {
+  if (variableSlot < behaviourTable_->localVariableCount) {
+    return variableRow_->getValuePtr(variableSlot);
+  }
+  return globalVariables_[variableSlot - behaviourTable_->localVariableCount].get();
+}
+
+const std::shared_ptr<ObjectVariableRow> &Object::getVariableRow() const {
+  return variableRow_;
+}
+
+const std::shared_ptr<ObjectBehaviourTable> &Object::getBehaviourTable() const {
+  return behaviourTable_;
+}
+
+ObjectBehaviourTable &Object::mutableBehaviourTable() {
+  // The table is shared with other objects of this type, so take a copy before changing it
+  if (behaviourTable_.use_count() > 1) {
+    behaviourTable_ = std::make_shared<ObjectBehaviourTable>(*behaviourTable_);
+  }
+  return *behaviourTable_;
 }
 
 SingleInputMapping Object::getInputMapping(const std::string& actionName, uint32_t actionId, bool randomize, InputMapping fallback) {
@@ -637,7 +770,7 @@ SingleInputMapping Object::getInputMapping(const std::string& actionName, uint32
 }
 
 void Object::setInitialActionDefinitions(std::vector<InitialActionDefinition> initialActionDefinitions) {
-  initialActionDefinitions_ = initialActionDefinitions;
+  mutableBehaviourTable().initialActionDefinitions = initialActionDefinitions;
 }
 
 std::vector<std::shared_ptr<Action>> Object::getInitialActions(std::shared_ptr<Action> originatingAction = nullptr) {
@@ -650,13 +783,13 @@ std::vector<std::shared_ptr<Action>> Object::getInitialActions(std::shared_ptr<A
     fallbackInputMapping.metaData = originatingAction->getMetaData();
   }
 
-  for (auto actionDefinition : initialActionDefinitions_) {
+  for (const auto &actionDefinition : behaviourTable_->initialActionDefinitions) {
     const auto& actionInputsDefinitions = objectGenerator_->getActionInputDefinitions();
     const auto& actionInputsDefinition = actionInputsDefinitions.at(actionDefinition.actionName);
 
     auto inputMapping = getInputMapping(actionDefinition.actionName, actionDefinition.actionId, actionDefinition.randomize, fallbackInputMapping);
 
-    auto action = std::make_shared<Action>(Action(grid(), actionDefinition.actionName, 0, actionDefinition.delay, inputMapping.metaData));
+    auto action = grid()->createAction(actionDefinition.actionName, 0, actionDefinition.delay, std::move(inputMapping.metaData));
     if (inputMapping.mappedToGrid) {
       inputMapping.vectorToDest = inputMapping.destinationLocation - getLocation();
     }
@@ -683,6 +816,7 @@ PathFinderConfig Object::configurePathFinder(YAML::Node searchNode, std::string
   PathFinderConfig config;
   if (searchNode.IsDefined()) {
     spdlog::debug("Configuring path finder for action {0}", actionName);
+    mutableBehaviourTable().boundToGrid = true;
 
     auto targetObjectNameNode = searchNode["TargetObjectName"];
 
@@ -696,10 +830,12 @@ PathFinderConfig Object::configurePathFinder(YAML::Node searchNode, std::string
       // Just make the range really large so we always look in all cells
       auto range = std::max(grid()->getWidth(), grid()->getHeight());
 
-      config.collisionDetector = std::make_shared<SpatialHashCollisionDetector>(SpatialHashCollisionDetector(grid()->getWidth(), grid()->getHeight(), 10, range, TriggerType::RANGE_BOX_AREA));
+      config.collisionDetector = std::make_shared<GridCollisionDetector>(grid()->getWidth(), grid()->getHeight(), range, TriggerType::RANGE_BOX_AREA);
 
       if (config.collisionDetector != nullptr) {
-        grid()->addCollisionDetector({targetObjectName}, actionName + generateRandomString(5), config.collisionDetector);
+        auto collisionDetectorName = actionName + generateRandomString(5);
+        grid()->addCollisionDetector({targetObjectName}, collisionDetectorName, config.collisionDetector);
+        mutableBehaviourTable().collisionDetectorNames.push_back(collisionDetectorName);
       }
     }
 
@@ -726,16 +862,67 @@ uint32_t Object::getPlayerId() const {
 }
 
 bool Object::moveObject(glm::ivec2 newLocation) {
-  if (grid()->updateLocation(shared_from_this(), {*x_, *y_}, newLocation)) {
-    *x_ = newLocation.x;
-    *y_ = newLocation.y;
-    location_ = glm::ivec2(*x_, *y_);
+  auto previousLocation = location_;
+
+  // The object is already at the new location while the grid updates, so collision detectors index the new location
+  *x_ = newLocation.x;
+  *y_ = newLocation.y;
+  location_ = newLocation;
+
+  if (grid()->updateLocation(shared_from_this(), previousLocation, newLocation)) {
     return true;
   }
 
+  *x_ = previousLocation.x;
+  *y_ = previousLocation.y;
+  location_ = previousLocation;
+  return false;
+}
+
+int32_t *Object::resolveVariableForUpdate(const ObjectVariable &operand, const std::shared_ptr<Action> &action, std::shared_ptr<int32_t> &variableOwner, int32_t &scratch) {
+  auto *variable = operand.resolve_ptr(*this, action, variableOwner, scratch);
+  if (variable == &scratch) {
+    return variable;
+  }
+
+  // The variable can belong to the other object of the action, which is then the one to redraw
+  auto variableLocation = getLocation();
+  if (!ownsVariable(variable)) {
+    for (const auto &actionObject : {action->getSourceObject(), action->getDestinationObject()}) {
+      if (actionObject != nullptr && actionObject->ownsVariable(variable)) {
+        variableLocation = actionObject->getLocation();
+        break;
+      }
+    }
+  }
+
+  auto grid = this->grid();
+  if (grid->isRecordingChanges()) {
+    // Variables without an owner belong to this object, which keeps them alive while the change is recorded
+    auto recordedVariable = variable == variableOwner.get() ? variableOwner : std::shared_ptr<int32_t>(shared_from_this(), variable);
+    grid->recordVariableChange(std::move(recordedVariable), variableLocation);
+  }
+  grid->invalidateLocation(variableLocation);
+
+  return variable;
+}
+
+bool Object::ownsVariable(const int32_t *variable) const {
+  for (uint32_t slot = 0; slot < behaviourTable_->localVariableCount; slot++) {
+    if (variableRow_->getValuePtr(slot) == variable) {
+      return true;
+    }
+  }
   return false;
 }
 
+void Object::recordAppearanceChange() {
+  auto grid = this->grid();
+  if (grid->isRecordingChanges()) {
+    grid->recordObjectChange(shared_from_this());
+  }
+}
+
 void Object::setRenderTileId(uint32_t renderTileId) {
   renderTileId_ = renderTileId;
   renderTileName_ = objectName_ + std::to_string(renderTileId_);
@@ -761,6 +948,15 @@ const std::string &Object::getObjectName() const {
   return objectName_;
 }
 
+uint32_t Object::getObjectNameId(const std::shared_ptr<SymbolTable> &objectSymbols) const {
+  // Names unknown to the table are not cached, as they may be interned later
+  if (resolvedObjectSymbols_ != objectSymbols || resolvedObjectNameId_ == SymbolTable::UNKNOWN_SYMBOL) {
+    resolvedObjectNameId_ = objectSymbols->getId(getObjectName());
+    resolvedObjectSymbols_ = objectSymbols;
+  }
+  return resolvedObjectNameId_;
+}
+
 char Object::getMapCharacter() const {
   return mapCharacter_;
 }
@@ -777,8 +973,56 @@ void Object::markAsPlayerAvatar() {
   isPlayerAvatar_ = true;
 }
 
+bool Object::isImmutable() const {
+  const auto &behaviourTable = *behaviourTable_;
+  if (isPlayerAvatar_ || behaviourTable.boundToGrid || !behaviourTable.initialActionDefinitions.empty()) {
+    return false;
+  }
+
+  // Declared variables come before the location and player id in the variable layout
+  if (behaviourTable.xSlot != 0) {
+    return false;
+  }
+
+  for (const auto &programs : behaviourTable.srcBehaviours) {
+    if (!programs.empty()) {
+      return false;
+    }
+  }
+
+  // Being the destination of an action may only give a fixed reward
+  for (const auto &programs : behaviourTable.dstBehaviours) {
+    for (const auto &program : programs) {
+      for (const auto &instruction : program.second.instructions) {
+        auto isFixedReward = instruction.opCode == BehaviourOpCode::REWARD && program.second.operands[instruction.a].isLiteral();
+        if (instruction.opCode != BehaviourOpCode::NOP && !isFixedReward) {
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+void Object::markAsShared() {
+  isShared_ = true;
+}
+
+bool Object::isShared() const {
+  return isShared_;
+}
+
+uint32_t Object::getEntityId() const {
+  return entityId_;
+}
+
+void Object::setEntityId(uint32_t entityId) {
+  entityId_ = entityId;
+}
+
 std::unordered_set<std::string> Object::getAvailableActionNames() const {
-  return availableActionNames_;
+  return behaviourTable_->availableActionNames;
 }
 
 std::shared_ptr<Grid> Object::grid() const {
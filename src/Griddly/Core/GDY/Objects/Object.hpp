@@ -11,17 +11,18 @@
 #include <vector>
 
 #include "../Actions/Direction.hpp"
+#include "../SymbolTable.hpp"
 #include "../YAMLUtils.hpp"
 #include "ObjectVariable.hpp"
+#include "ObjectVariableStore.hpp"
 
 #define BehaviourCommandArguments std::unordered_map<std::string, YAML::Node>
-#define BehaviourFunction std::function<BehaviourResult(std::shared_ptr<Action>)>
-#define PreconditionFunction std::function<bool(std::shared_ptr<Action>)>
 #define CommandList std::vector<std::pair<std::string, BehaviourCommandArguments>>
 
 namespace griddly {
 
 class Grid;
+class Object;
 class Action;
 class ObjectGenerator;
 class InputMapping;
@@ -70,6 +71,100 @@ struct PathFinderConfig {
   uint32_t maxSearchDepth = 100;
 };
 
+enum class BehaviourOpCode : uint8_t {
+  NOP,
+  REWARD,     // a: value operand
+  CHANGE_TO,  // a: object name
+  ADD,        // a: variable operand, b: value operand
+  SUB,        // a: variable operand, b: value operand
+  SET,        // a: variable operand, b: value operand
+  INCR,       // a: variable operand
+  DECR,       // a: variable operand
+  ROT_DIR,
+  MOV_DEST,
+  MOV_SRC,
+  MOV,  // a: x operand, b: y operand
+  CASCADE_DEST,
+  CASCADE_UNSUPPORTED,
+  EXEC,  // a: exec command
+  REMOVE,
+  SET_TILE,  // a: tile id operand
+  SPAWN,     // a: object name
+
+  // Conditions compare operands a and b. In behaviours execution jumps to jumpTarget if the condition fails,
+  // in preconditions the action is not valid if the condition fails.
+  EQ,
+  GT,
+  GTE,
+  LT,
+  LTE,
+  NEQ,
+};
+
+struct BehaviourInstruction {
+  BehaviourOpCode opCode = BehaviourOpCode::NOP;
+  uint32_t a = 0;
+  uint32_t b = 0;
+  uint32_t jumpTarget = 0;
+};
+
+struct ExecCommand {
+  std::string actionName;
+  uint32_t delay = 0;
+  bool randomize = false;
+  uint32_t actionId = 0;
+  ActionExecutor executor = ActionExecutor::ACTION_PLAYER_ID;
+  PathFinderConfig pathFinderConfig{};
+};
+
+// The behaviour commands for an (action, source, destination) combination compiled to a flat list of instructions.
+// Instruction arguments index into the operand, object name and exec command pools of the program.
+struct BehaviourProgram {
+  std::vector<BehaviourInstruction> instructions{};
+  std::vector<ObjectVariable> operands{};
+  std::vector<std::string> objectNames{};
+  std::vector<ExecCommand> execCommands{};
+};
+
+// Behaviours, preconditions and initial actions of an object type.
+// Behaviours are compiled against the variable layout (variableSlots) rather than a particular object, so a single table can be
+// shared by every instance of the type and an instance only needs to hold its variable storage.
+struct ObjectBehaviourTable {
+  // variable name -> index into the variable storage of an object
+  std::unordered_map<std::string, uint32_t> variableSlots{};
+  std::vector<std::string> variableNames{};
+
+  // The first localVariableCount slots are columns of the object type's variable store, the rest reference global variables
+  uint32_t localVariableCount = 0;
+  std::vector<std::string> localVariableNames{};
+  std::vector<int32_t> localVariableInitialValues{};
+
+  uint32_t xSlot = 0;
+  uint32_t ySlot = 0;
+  uint32_t playerIdSlot = 0;
+
+  std::unordered_set<std::string> availableActionNames{};
+  std::vector<InitialActionDefinition> initialActionDefinitions{};
+
+  // Action and object names are interned so behaviours can be looked up by id.
+  // Tables compiled by the object generator share its symbol tables.
+  std::shared_ptr<SymbolTable> actionSymbols = std::make_shared<SymbolTable>();
+  std::shared_ptr<SymbolTable> objectSymbols = std::make_shared<SymbolTable>();
+
+  // action id -> destination object id -> behaviour program
+  std::vector<std::unordered_map<uint32_t, BehaviourProgram>> srcBehaviours{};
+
+  // action id -> source object id -> behaviour program
+  std::vector<std::unordered_map<uint32_t, BehaviourProgram>> dstBehaviours{};
+
+  // action id -> destination object id -> precondition program (only conditions)
+  std::vector<std::unordered_map<uint32_t, BehaviourProgram>> actionPreconditions{};
+
+  // Path finding behaviours reference the grid they were compiled for, and any collision detectors they added to it
+  bool boundToGrid = false;
+  std::vector<std::string> collisionDetectorNames{};
+};
+
 class Object : public std::enable_shared_from_this<Object> {
  public:
   virtual const glm::ivec2& getLocation() const;
@@ -80,6 +175,9 @@ class Object : public std::enable_shared_from_this<Object> {
 
   virtual const std::string& getObjectName() const;
 
+  // Id of the object name in the given symbol table. The id is cached for the last table it was looked up in.
+  uint32_t getObjectNameId(const std::shared_ptr<SymbolTable>& objectSymbols) const;
+
   virtual char getMapCharacter() const;
 
   virtual const std::string& getObjectRenderTileName() const;
@@ -100,8 +198,22 @@ class Object : public std::enable_shared_from_this<Object> {
 
   virtual void markAsPlayerAvatar();  // Set this object as a player avatar
 
+  // True if no action can change this object once it is in a grid, so it can be shared by forked grids
+  virtual bool isImmutable() const;
+
+  // Objects shared by forked grids are never re-initialized or reused for other objects
+  virtual void markAsShared();
+  virtual bool isShared() const;
+
+  // Assigned by the grid when the object is first added to it, 0 until then
+  uint32_t getEntityId() const;
+  void setEntityId(uint32_t entityId);
+
   virtual bool isValidAction(std::shared_ptr<Action> action) const;
 
+  // True if the preconditions of the action read global variables, which can change without the location of this object or its destination being invalidated
+  virtual bool preconditionsReadGlobalVariables(const std::string& actionName) const;
+
   virtual void addPrecondition(std::string actionName, std::string destinationObjectName, std::string commandName, BehaviourCommandArguments commandArguments);
 
   virtual BehaviourResult onActionSrc(std::string destinationObjectName, std::shared_ptr<Action> action);
@@ -122,52 +234,74 @@ class Object : public std::enable_shared_from_this<Object> {
   virtual std::vector<std::shared_ptr<Action>> getInitialActions(std::shared_ptr<Action> originatingAction);
   virtual void setInitialActionDefinitions(std::vector<InitialActionDefinition> actionDefinitions);
 
+  // Value of the variable in a slot of the behaviour table's variable layout
+  int32_t* getVariableValueAt(uint32_t variableSlot) const;
+
+  // The row of the object type's variable store that holds the local variables of this object
+  const std::shared_ptr<ObjectVariableRow>& getVariableRow() const;
+
+  const std::shared_ptr<ObjectBehaviourTable>& getBehaviourTable() const;
+
   Object(std::string objectName, char mapCharacter, uint32_t playerId, uint32_t zIdx, std::unordered_map<std::string, std::shared_ptr<int32_t>> availableVariables, std::shared_ptr<ObjectGenerator> objectGenerator, std::weak_ptr<Grid> grid);
 
+  // Create an object using a (possibly shared) behaviour table. The variable row holds the local variables of the behaviour table
+  // layout and globalVariables the remaining slots
+  Object(std::string objectName, char mapCharacter, uint32_t playerId, uint32_t zIdx, std::shared_ptr<ObjectVariableRow> variableRow, std::vector<std::shared_ptr<int32_t>> globalVariables, std::shared_ptr<ObjectBehaviourTable> behaviourTable, std::shared_ptr<ObjectGenerator> objectGenerator, std::weak_ptr<Grid> grid);
+
   virtual ~Object();
 
  private:
-  // Have to be shared pointers because they are used as variables
-  std::shared_ptr<int32_t> x_ = std::make_shared<int32_t>(0);
-  std::shared_ptr<int32_t> y_ = std::make_shared<int32_t>(0);
+  // Point into the variable row, as they are also used as variables
+  int32_t* x_;
+  int32_t* y_;
 
   glm::ivec2 location_;
 
   DiscreteOrientation orientation_ = DiscreteOrientation(Direction::NONE);
 
-  std::shared_ptr<int32_t> playerId_ = std::make_shared<int32_t>(0);
+  int32_t* playerId_;
   const std::string objectName_;
   const char mapCharacter_;
   const int32_t zIdx_;
   uint32_t renderTileId_ = 0;
   std::string renderTileName_;
   bool isPlayerAvatar_ = false;
+  bool isShared_ = false;
+  uint32_t entityId_ = 0;
 
-  std::vector<InitialActionDefinition> initialActionDefinitions_;
-
-  // action -> destination -> [behaviour functions]
-  std::unordered_map<std::string, std::unordered_map<std::string, std::vector<BehaviourFunction>>> srcBehaviours_;
-
-  // action -> source -> [behaviour functions]
-  std::unordered_map<std::string, std::unordered_map<std::string, std::vector<BehaviourFunction>>> dstBehaviours_;
+  // The table is held so its address cannot be reused by another table while the id is cached
+  mutable std::shared_ptr<SymbolTable> resolvedObjectSymbols_ = nullptr;
+  mutable uint32_t resolvedObjectNameId_ = SymbolTable::UNKNOWN_SYMBOL;
 
-  // action -> destination -> [precondition list]
-  std::unordered_map<std::string, std::unordered_map<std::string, std::vector<PreconditionFunction>>> actionPreconditions_;
+  // Compiled behaviours, shared between objects of the same type. Copied before being modified if it is shared.
+  std::shared_ptr<ObjectBehaviourTable> behaviourTable_;
 
-  // The variables that are available in the object for behaviour commands to interact with
-  std::unordered_map<std::string, std::shared_ptr<int32_t>> availableVariables_;
+  // The variables that are available in the object for behaviour commands to interact with.
+  // Local variables are stored in a row of the variable store shared by all objects of this type, the slots after them reference global variables
+  std::shared_ptr<ObjectVariableRow> variableRow_;
+  std::vector<std::shared_ptr<int32_t>> globalVariables_;
 
   std::shared_ptr<Grid> grid() const;
   const std::weak_ptr<Grid> grid_;
 
-  std::unordered_set<std::string> availableActionNames_;
-
   const std::shared_ptr<ObjectGenerator> objectGenerator_;
 
+  ObjectBehaviourTable& mutableBehaviourTable();
+
   virtual bool moveObject(glm::ivec2 newLocation);
 
   virtual void removeObject();
 
+  // Resolves a variable that a behaviour modifies, recording its current value if the grid is recording changes.
+  // The location of the object that owns the variable is invalidated.
+  int32_t* resolveVariableForUpdate(const ObjectVariable& operand, const std::shared_ptr<Action>& action, std::shared_ptr<int32_t>& variableOwner, int32_t& scratch);
+
+  // True if the variable is one of the local variables of this object
+  bool ownsVariable(const int32_t* variable) const;
+
+  // Records the orientation and render tile before a behaviour changes them, if the grid is recording changes
+  void recordAppearanceChange();
+
   SingleInputMapping getInputMapping(const std::string& actionName, uint32_t actionId, bool randomize, InputMapping fallback);
 
   PathFinderConfig configurePathFinder(YAML::Node searchNode, std::string actionName);
@@ -175,11 +309,14 @@ class Object : public std::enable_shared_from_this<Object> {
   template <typename C>
   static C getCommandArgument(BehaviourCommandArguments commandArguments, std::string commandArgumentKey, C defaultValue);
 
-  std::unordered_map<std::string, std::shared_ptr<ObjectVariable>> resolveVariables(BehaviourCommandArguments variables);
+  uint32_t addOperand(BehaviourProgram& program, BehaviourCommandArguments& commandArguments, const std::string& argumentKey) const;
+
+  void compilePrecondition(BehaviourProgram& program, std::string commandName, BehaviourCommandArguments commandArguments);
+  void compileBehaviour(BehaviourProgram& program, std::string commandName, BehaviourCommandArguments commandArguments);
+  void compileConditionalBehaviour(BehaviourProgram& program, std::string commandName, BehaviourCommandArguments commandArguments, CommandList subCommands);
 
-  PreconditionFunction instantiatePrecondition(std::string commandName, BehaviourCommandArguments commandArguments);
-  BehaviourFunction instantiateBehaviour(std::string commandName, BehaviourCommandArguments commandArguments);
-  BehaviourFunction instantiateConditionalBehaviour(std::string commandName, BehaviourCommandArguments commandArguments, CommandList subCommands);
+  BehaviourResult runBehaviourProgram(const BehaviourProgram& program, const std::shared_ptr<Action>& action);
+  bool checkPreconditions(const BehaviourProgram& program, const std::shared_ptr<Action>& action) const;
 
   ActionExecutor getActionExecutorFromString(std::string executorString) const;
 };
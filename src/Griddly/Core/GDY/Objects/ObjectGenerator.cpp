@@ -24,6 +24,9 @@ ObjectGenerator::ObjectGenerator() {
   boundaryObjectDefinition.zIdx = 0;
   boundaryObjectDefinition.variableDefinitions = {};
   objectDefinitions_.insert({"_boundary", std::make_shared<ObjectDefinition>(boundaryObjectDefinition)});
+
+  objectSymbols_->intern("_empty");
+  objectSymbols_->intern("_boundary");
 }
 
 void ObjectGenerator::defineNewObject(std::string objectName, char mapCharacter, uint32_t zIdx, std::unordered_map<std::string, uint32_t> variableDefinitions) {
@@ -37,6 +40,10 @@ void ObjectGenerator::defineNewObject(std::string objectName, char mapCharacter,
 
   objectDefinitions_.insert({objectName, std::make_shared<ObjectDefinition>(objectDefinition)});
   objectChars_[mapCharacter] = objectName;
+  objectSymbols_->intern(objectName);
+
+  // Behaviours for this object will need to be recompiled
+  behaviourTables_.erase(objectName);
 }
 
 void ObjectGenerator::defineActionBehaviour(
@@ -45,12 +52,18 @@ void ObjectGenerator::defineActionBehaviour(
   spdlog::debug("Defining object {0} behaviour {1}:{2}", objectName, behaviourDefinition.actionName, behaviourDefinition.commandName);
   auto objectDefinition = getObjectDefinition(objectName);
   objectDefinition->actionBehaviourDefinitions.push_back(behaviourDefinition);
+  actionSymbols_->intern(behaviourDefinition.actionName);
+  objectSymbols_->intern(behaviourDefinition.sourceObjectName);
+  objectSymbols_->intern(behaviourDefinition.destinationObjectName);
+  behaviourTables_.erase(objectName);
 }
 
 void ObjectGenerator::addInitialAction(std::string objectName, std::string actionName, uint32_t actionId, uint32_t delay, bool randomize) {
   spdlog::debug("Defining object {0} initial action {1}", objectName, actionName);
   auto objectDefinition = getObjectDefinition(objectName);
   objectDefinition->initialActionDefinitions.push_back({actionName, actionId, delay, randomize});
+  actionSymbols_->intern(actionName);
+  behaviourTables_.erase(objectName);
 }
 
 std::shared_ptr<Object> ObjectGenerator::cloneInstance(std::shared_ptr<Object> toClone, std::shared_ptr<Grid> grid) {
@@ -64,38 +77,27 @@ std::shared_ptr<Object> ObjectGenerator::cloneInstance(std::shared_ptr<Object> t
                 objectDefinition->variableDefinitions.size(),
                 objectDefinition->actionBehaviourDefinitions.size());
 
-  // Initialize the variables for the Object
-  std::unordered_map<std::string, std::shared_ptr<int32_t>> availableVariables;
-  for (auto &variableDefinitions : objectDefinition->variableDefinitions) {
-    // Copy the variable from the old object
-    auto copiedVariableValue = *toClone->getVariableValue(variableDefinitions.first);
+  const auto &globalVariables = grid->getGlobalVariables();
 
-    auto initializedVariable = std::make_shared<int32_t>(copiedVariableValue);
-    availableVariables.insert({variableDefinitions.first, initializedVariable});
+  auto behaviourTable = getCompiledBehaviourTable(objectName, grid, globalVariables);
+  auto isCompiled = behaviourTable != nullptr;
+  if (!isCompiled) {
+    behaviourTable = createBehaviourTable(*objectDefinition, globalVariables);
   }
 
-  auto globalVariables = grid->getGlobalVariables();
-
-  // Initialize global variables
-  for (auto &globalVariable : globalVariables) {
-    auto variableName = globalVariable.first;
-    auto globalVariableInstances = globalVariable.second;
-
-    if (globalVariableInstances.size() == 1) {
-      spdlog::debug("Adding reference to global variable {0} to object {1}", variableName, objectName);
-      auto instance = globalVariableInstances.at(0);
-      availableVariables.insert({variableName, instance});
-    } else {
-      auto instance = globalVariableInstances.at(playerId);
-      spdlog::debug("Adding reference to player variable {0} with value {1} to object {2}", variableName, *instance, objectName);
-      availableVariables.insert({variableName, instance});
-    }
+  // Copy the variables from the old object
+  auto localVariableValues = behaviourTable->localVariableInitialValues;
+  for (auto &variableDefinition : objectDefinition->variableDefinitions) {
+    auto slot = behaviourTable->variableSlots.at(variableDefinition.first);
+    localVariableValues[slot] = *toClone->getVariableValue(variableDefinition.first);
   }
 
+  auto variableRow = grid->getObjectVariableStore(objectName, behaviourTable->localVariableNames)->allocateRow(localVariableValues);
+  auto objectGlobalVariables = instantiateGlobalVariables(playerId, globalVariables);
 
   auto objectZIdx = objectDefinition->zIdx;
   auto mapCharacter = objectDefinition->mapCharacter;
-  auto initializedObject = std::make_shared<Object>(Object(objectName, mapCharacter, playerId, objectZIdx, availableVariables, shared_from_this(), grid));
+  auto initializedObject = std::make_shared<Object>(objectName, mapCharacter, playerId, objectZIdx, std::move(variableRow), std::move(objectGlobalVariables), std::move(behaviourTable), shared_from_this(), grid);
 
   if (objectName == avatarObject_) {
     initializedObject->markAsPlayerAvatar();
@@ -103,40 +105,10 @@ std::shared_ptr<Object> ObjectGenerator::cloneInstance(std::shared_ptr<Object> t
 
   initializedObject->setRenderTileId(toClone->getRenderTileId());
 
-
-  for (auto &actionBehaviourDefinition : objectDefinition->actionBehaviourDefinitions) {
-    switch (actionBehaviourDefinition.behaviourType) {
-      case ActionBehaviourType::SOURCE:
-
-        // Adding the acion preconditions
-        for (auto actionPrecondition : actionBehaviourDefinition.actionPreconditions) {
-          initializedObject->addPrecondition(
-              actionBehaviourDefinition.actionName,
-              actionBehaviourDefinition.destinationObjectName,
-              actionPrecondition.first,
-              actionPrecondition.second);
-        }
-
-        initializedObject->addActionSrcBehaviour(
-            actionBehaviourDefinition.actionName,
-            actionBehaviourDefinition.destinationObjectName,
-            actionBehaviourDefinition.commandName,
-            actionBehaviourDefinition.commandArguments,
-            actionBehaviourDefinition.conditionalCommands);
-        break;
-      case ActionBehaviourType::DESTINATION:
-        initializedObject->addActionDstBehaviour(
-            actionBehaviourDefinition.actionName,
-            actionBehaviourDefinition.sourceObjectName,
-            actionBehaviourDefinition.commandName,
-            actionBehaviourDefinition.commandArguments,
-            actionBehaviourDefinition.conditionalCommands);
-        break;
-    }
+  if (!isCompiled) {
+    compileBehaviourTable(initializedObject, *objectDefinition, grid);
   }
 
-  initializedObject->setInitialActionDefinitions(objectDefinition->initialActionDefinitions);
-
   return initializedObject;
 }
 
@@ -152,54 +124,123 @@ std::shared_ptr<Object> ObjectGenerator::newInstance(std::string objectName, uin
     playerId = 1;
   }
 
-  // Initialize the variables for the Object
-  std::unordered_map<std::string, std::shared_ptr<int32_t>> availableVariables;
-  for (auto &variableDefinitions : objectDefinition->variableDefinitions) {
-    auto variableName = variableDefinitions.first;
-    auto initializedVariable = std::make_shared<int32_t>(variableDefinitions.second);
-    spdlog::debug("Creating local variable {0} with value {1} for object {2}", variableName, *initializedVariable, objectName);
-    availableVariables.insert({variableDefinitions.first, initializedVariable});
-  }
-
-  auto globalVariables = grid->getGlobalVariables();
+  const auto &globalVariables = grid->getGlobalVariables();
 
-  // Initialize global variables
-  for (auto &globalVariable : globalVariables) {
-    auto variableName = globalVariable.first;
-    auto globalVariableInstances = globalVariable.second;
-
-    spdlog::debug("Adding reference to global variable {0} to object {1}", variableName, objectName);
-    if (globalVariableInstances.size() == 1) {
-      auto instance = globalVariableInstances.at(0);
-      availableVariables.insert({variableName, instance});
-    } else {
-      auto instance = globalVariableInstances.at(playerId);
-      availableVariables.insert({variableName, instance});
-    }
+  auto behaviourTable = getCompiledBehaviourTable(objectName, grid, globalVariables);
+  auto isCompiled = behaviourTable != nullptr;
+  if (!isCompiled) {
+    behaviourTable = createBehaviourTable(*objectDefinition, globalVariables);
   }
 
+  auto variableRow = grid->getObjectVariableStore(objectName, behaviourTable->localVariableNames)->allocateRow(behaviourTable->localVariableInitialValues);
+  auto objectGlobalVariables = instantiateGlobalVariables(playerId, globalVariables);
+
   auto objectZIdx = objectDefinition->zIdx;
   auto mapCharacter = objectDefinition->mapCharacter;
-  auto initializedObject = std::make_shared<Object>(Object(objectName, mapCharacter, playerId, objectZIdx, availableVariables, shared_from_this(), grid));
+  auto initializedObject = std::make_shared<Object>(objectName, mapCharacter, playerId, objectZIdx, std::move(variableRow), std::move(objectGlobalVariables), std::move(behaviourTable), shared_from_this(), grid);
 
   if (isAvatar) {
     initializedObject->markAsPlayerAvatar();
   }
 
-  for (auto &actionBehaviourDefinition : objectDefinition->actionBehaviourDefinitions) {
+  if (!isCompiled) {
+    compileBehaviourTable(initializedObject, *objectDefinition, grid);
+  }
+
+  return initializedObject;
+}
+
+std::shared_ptr<ObjectBehaviourTable> ObjectGenerator::getCompiledBehaviourTable(const std::string &objectName, const std::shared_ptr<Grid> &grid, const std::map<std::string, std::unordered_map<uint32_t, std::shared_ptr<int32_t>>> &globalVariables) const {
+  CompiledBehaviourTable compiledBehaviourTable;
+  {
+    std::lock_guard<std::mutex> lock(*behaviourTablesMutex_);
+    auto compiledBehaviourTableIt = behaviourTables_.find(objectName);
+    if (compiledBehaviourTableIt == behaviourTables_.end()) {
+      return nullptr;
+    }
+    compiledBehaviourTable = compiledBehaviourTableIt->second;
+  }
+
+  const auto &behaviourTable = compiledBehaviourTable.behaviourTable;
+
+  // Path finding behaviours hold a path finder and collision detectors that belong to the grid they were compiled on
+  if (behaviourTable->boundToGrid) {
+    if (compiledBehaviourTable.grid.lock() != grid) {
+      return nullptr;
+    }
+
+    for (const auto &collisionDetectorName : behaviourTable->collisionDetectorNames) {
+      if (!grid->hasCollisionDetector(collisionDetectorName)) {
+        return nullptr;
+      }
+    }
+  }
+
+  // The global variables must have the same layout as when the table was compiled
+  if (behaviourTable->variableNames.size() - behaviourTable->localVariableCount != globalVariables.size()) {
+    return nullptr;
+  }
+
+  auto slot = behaviourTable->localVariableCount;
+  for (const auto &globalVariable : globalVariables) {
+    if (behaviourTable->variableNames[slot++] != globalVariable.first) {
+      return nullptr;
+    }
+  }
+
+  return behaviourTable;
+}
+
+std::shared_ptr<ObjectBehaviourTable> ObjectGenerator::createBehaviourTable(const ObjectDefinition &objectDefinition, const std::map<std::string, std::unordered_map<uint32_t, std::shared_ptr<int32_t>>> &globalVariables) const {
+  auto behaviourTable = std::make_shared<ObjectBehaviourTable>();
+  behaviourTable->actionSymbols = actionSymbols_;
+  behaviourTable->objectSymbols = objectSymbols_;
+
+  auto addVariableSlot = [&behaviourTable](const std::string &variableName) {
+    auto slot = static_cast<uint32_t>(behaviourTable->variableNames.size());
+    behaviourTable->variableSlots.insert({variableName, slot});
+    behaviourTable->variableNames.push_back(variableName);
+    return slot;
+  };
+
+  for (auto &variableDefinition : objectDefinition.variableDefinitions) {
+    spdlog::debug("Creating local variable {0} with value {1} for object {2}", variableDefinition.first, variableDefinition.second, objectDefinition.objectName);
+    addVariableSlot(variableDefinition.first);
+    behaviourTable->localVariableInitialValues.push_back(static_cast<int32_t>(variableDefinition.second));
+  }
+
+  behaviourTable->xSlot = addVariableSlot("_x");
+  behaviourTable->ySlot = addVariableSlot("_y");
+  behaviourTable->playerIdSlot = addVariableSlot("_playerId");
+  behaviourTable->localVariableInitialValues.resize(behaviourTable->variableNames.size(), 0);
+  behaviourTable->localVariableNames = behaviourTable->variableNames;
+  behaviourTable->localVariableCount = static_cast<uint32_t>(behaviourTable->variableNames.size());
+
+  for (auto &globalVariable : globalVariables) {
+    spdlog::debug("Adding reference to global variable {0} to object {1}", globalVariable.first, objectDefinition.objectName);
+    addVariableSlot(globalVariable.first);
+  }
+
+  return behaviourTable;
+}
+
+void ObjectGenerator::compileBehaviourTable(const std::shared_ptr<Object> &object, const ObjectDefinition &objectDefinition, const std::shared_ptr<Grid> &grid) {
+  spdlog::debug("Compiling behaviours for object {0}.", objectDefinition.objectName);
+
+  for (auto &actionBehaviourDefinition : objectDefinition.actionBehaviourDefinitions) {
     switch (actionBehaviourDefinition.behaviourType) {
       case ActionBehaviourType::SOURCE:
 
         // Adding the acion preconditions
         for (auto actionPrecondition : actionBehaviourDefinition.actionPreconditions) {
-          initializedObject->addPrecondition(
+          object->addPrecondition(
               actionBehaviourDefinition.actionName,
               actionBehaviourDefinition.destinationObjectName,
               actionPrecondition.first,
               actionPrecondition.second);
         }
 
-        initializedObject->addActionSrcBehaviour(
+        object->addActionSrcBehaviour(
             actionBehaviourDefinition.actionName,
             actionBehaviourDefinition.destinationObjectName,
             actionBehaviourDefinition.commandName,
@@ -207,7 +248,7 @@ std::shared_ptr<Object> ObjectGenerator::newInstance(std::string objectName, uin
             actionBehaviourDefinition.conditionalCommands);
         break;
       case ActionBehaviourType::DESTINATION:
-        initializedObject->addActionDstBehaviour(
+        object->addActionDstBehaviour(
             actionBehaviourDefinition.actionName,
             actionBehaviourDefinition.sourceObjectName,
             actionBehaviourDefinition.commandName,
@@ -217,9 +258,26 @@ std::shared_ptr<Object> ObjectGenerator::newInstance(std::string objectName, uin
     }
   }
 
-  initializedObject->setInitialActionDefinitions(objectDefinition->initialActionDefinitions);
+  object->setInitialActionDefinitions(objectDefinition.initialActionDefinitions);
 
-  return initializedObject;
+  std::lock_guard<std::mutex> lock(*behaviourTablesMutex_);
+  behaviourTables_[objectDefinition.objectName] = {object->getBehaviourTable(), grid};
+}
+
+std::vector<std::shared_ptr<int32_t>> ObjectGenerator::instantiateGlobalVariables(uint32_t playerId, const std::map<std::string, std::unordered_map<uint32_t, std::shared_ptr<int32_t>>> &globalVariables) const {
+  std::vector<std::shared_ptr<int32_t>> objectGlobalVariables;
+  objectGlobalVariables.reserve(globalVariables.size());
+
+  for (auto &globalVariable : globalVariables) {
+    const auto &globalVariableInstances = globalVariable.second;
+    if (globalVariableInstances.size() == 1) {
+      objectGlobalVariables.push_back(globalVariableInstances.at(0));
+    } else {
+      objectGlobalVariables.push_back(globalVariableInstances.at(playerId));
+    }
+  }
+
+  return objectGlobalVariables;
 }
 
 void ObjectGenerator::setAvatarObject(std::string objectName) {
@@ -228,14 +286,24 @@ void ObjectGenerator::setAvatarObject(std::string objectName) {
 
 void ObjectGenerator::setActionInputDefinitions(std::unordered_map<std::string, ActionInputsDefinition> actionInputsDefinitions) {
   actionInputsDefinitions_ = actionInputsDefinitions;
+  for (const auto &actionInputsDefinition : actionInputsDefinitions_) {
+    actionSymbols_->intern(actionInputsDefinition.first);
+  }
+  behaviourTables_.clear();
 }
 
 void ObjectGenerator::setActionTriggerDefinitions(std::unordered_map<std::string, ActionTriggerDefinition> actionTriggerDefinitions) {
   actionTriggerDefinitions_ = actionTriggerDefinitions;
+  for (const auto &actionTriggerDefinition : actionTriggerDefinitions_) {
+    actionSymbols_->intern(actionTriggerDefinition.first);
+  }
 }
 
 void ObjectGenerator::setActionProbabilities(std::unordered_map<std::string, float> actionProbabilities) {
   actionProbabilities_ = actionProbabilities;
+  for (const auto &actionProbability : actionProbabilities_) {
+    actionSymbols_->intern(actionProbability.first);
+  }
 }
 
 const std::unordered_map<std::string, ActionInputsDefinition>& ObjectGenerator::getActionInputDefinitions() const {
@@ -250,6 +318,14 @@ const std::unordered_map<std::string, float>& ObjectGenerator::getActionProbabil
   return actionProbabilities_;
 }
 
+const std::shared_ptr<SymbolTable> &ObjectGenerator::getActionSymbols() const {
+  return actionSymbols_;
+}
+
+const std::shared_ptr<SymbolTable> &ObjectGenerator::getObjectSymbols() const {
+  return objectSymbols_;
+}
+
 // The order of object definitions needs to be consistent across levels and maps, so we have to make sure this is ordered here.
 const std::map<std::string, std::shared_ptr<ObjectDefinition>>& ObjectGenerator::getObjectDefinitions() const {
   return objectDefinitions_;
@@ -1,9 +1,11 @@
 #pragma once
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
 #include "../Actions/Action.hpp"
+#include "../SymbolTable.hpp"
 #include "Object.hpp"
 
 namespace griddly {
@@ -62,6 +64,10 @@ class ObjectGenerator : public std::enable_shared_from_this<ObjectGenerator> {
 
   virtual const std::map<std::string, std::shared_ptr<ObjectDefinition>>& getObjectDefinitions() const;
 
+  // Ids of every action and object name defined in the GDY, shared by the behaviour tables of all objects
+  const std::shared_ptr<SymbolTable>& getActionSymbols() const;
+  const std::shared_ptr<SymbolTable>& getObjectSymbols() const;
+
  private:
   std::unordered_map<char, std::string> objectChars_;
 
@@ -75,6 +81,26 @@ class ObjectGenerator : public std::enable_shared_from_this<ObjectGenerator> {
   std::unordered_map<std::string, ActionTriggerDefinition> actionTriggerDefinitions_;
   std::unordered_map<std::string, float> actionProbabilities_;
 
+  const std::shared_ptr<SymbolTable> actionSymbols_ = std::make_shared<SymbolTable>();
+  const std::shared_ptr<SymbolTable> objectSymbols_ = std::make_shared<SymbolTable>();
+
+  // Behaviours are compiled once per object type and shared between all instances of that type
+  struct CompiledBehaviourTable {
+    std::shared_ptr<ObjectBehaviourTable> behaviourTable;
+    std::weak_ptr<Grid> grid;
+  };
+
+  std::unordered_map<std::string, CompiledBehaviourTable> behaviourTables_;
+
+  // Objects can be created by games running on different threads
+  const std::shared_ptr<std::mutex> behaviourTablesMutex_ = std::make_shared<std::mutex>();
+
   std::shared_ptr<ObjectDefinition>& getObjectDefinition(std::string objectName);
+
+  std::shared_ptr<ObjectBehaviourTable> getCompiledBehaviourTable(const std::string& objectName, const std::shared_ptr<Grid>& grid, const std::map<std::string, std::unordered_map<uint32_t, std::shared_ptr<int32_t>>>& globalVariables) const;
+  std::shared_ptr<ObjectBehaviourTable> createBehaviourTable(const ObjectDefinition& objectDefinition, const std::map<std::string, std::unordered_map<uint32_t, std::shared_ptr<int32_t>>>& globalVariables) const;
+  void compileBehaviourTable(const std::shared_ptr<Object>& object, const ObjectDefinition& objectDefinition, const std::shared_ptr<Grid>& grid);
+
+  std::vector<std::shared_ptr<int32_t>> instantiateGlobalVariables(uint32_t playerId, const std::map<std::string, std::unordered_map<uint32_t, std::shared_ptr<int32_t>>>& globalVariables) const;
 };
 }  // namespace griddly
\ No newline at end of file
@@ -7,7 +7,7 @@
 
 namespace griddly {
 
-ObjectVariable::ObjectVariable(YAML::Node commandArguments, std::unordered_map<std::string, std::shared_ptr<int32_t>>& availableVariables) {
+ObjectVariable::ObjectVariable(YAML::Node commandArguments, const std::unordered_map<std::string, uint32_t>& variableSlots) {
   auto commandArgumentValue = commandArguments.as<std::string>();
 
   auto delim = commandArgumentValue.find(".");
@@ -28,9 +28,9 @@ ObjectVariable::ObjectVariable(YAML::Node commandArguments, std::unordered_map<s
     objectVariableType_ = ObjectVariableType::UNRESOLVED;
     variableName_ = commandArgumentValue.substr(delim + 1);
   } else {
-    auto variable = availableVariables.find(commandArgumentValue);
+    auto variable = variableSlots.find(commandArgumentValue);
 
-    if (variable == availableVariables.end()) {
+    if (variable == variableSlots.end()) {
       spdlog::debug("Variable string not found, trying to parse literal={0}", commandArgumentValue);
 
       try {
@@ -45,20 +45,30 @@ ObjectVariable::ObjectVariable(YAML::Node commandArguments, std::unordered_map<s
     } else {
       spdlog::debug("Variable pointer {0} resolved.", variable->first);
       objectVariableType_ = ObjectVariableType::RESOLVED;
-      resolvedValue_ = variable->second;
+      resolvedSlot_ = variable->second;
     }
   }
 }
 
-int32_t ObjectVariable::resolve(std::shared_ptr<Action> action) const {
+int32_t ObjectVariable::resolve(const Object& object, const std::shared_ptr<Action>& action) const {
   int32_t resolved = 0;
   switch (objectVariableType_) {
     case ObjectVariableType::LITERAL:
       resolved = literalValue_;
       spdlog::debug("resolved literal {0}", resolved);
       break;
+    case ObjectVariableType::RESOLVED:
+      resolved = *object.getVariableValueAt(resolvedSlot_);
+      spdlog::debug("resolved slot value {0}", resolved);
+      break;
     default:
-      resolved = *resolve_ptr(action);
+      if (actionObject_ == ActionObject::META) {
+        resolved = action->getMetaData(variableName_);
+      } else {
+        std::shared_ptr<int32_t> owner;
+        int32_t scratch;
+        resolved = *resolve_ptr(object, action, owner, scratch);
+      }
       spdlog::debug("resolved pointer value {0}", resolved);
       break;
   }
@@ -66,36 +76,53 @@ int32_t ObjectVariable::resolve(std::shared_ptr<Action> action) const {
   return resolved;
 }
 
-std::shared_ptr<int32_t> ObjectVariable::resolve_ptr(std::shared_ptr<Action> action) const {
+int32_t* ObjectVariable::resolve_ptr(const Object& object, const std::shared_ptr<Action>& action, std::shared_ptr<int32_t>& owner, int32_t& scratch) const {
   switch (objectVariableType_) {
     case ObjectVariableType::RESOLVED:
-      return resolvedValue_;
+      // The object outlives the behaviour it is running, so the pointer does not need an owner
+      return object.getVariableValueAt(resolvedSlot_);
     case ObjectVariableType::UNRESOLVED: {
-      std::shared_ptr<int32_t> ptr;
       switch (actionObject_) {
-        case ActionObject::SRC: {
-          auto object = action->getSourceObject();
-          ptr = object->getVariableValue(variableName_);
-        } break;
-        case ActionObject::DST: {
-          auto object = action->getDestinationObject();
-          ptr = object->getVariableValue(variableName_);
-        } break;
-        case ActionObject::META: {
-          ptr = std::make_shared<int32_t>(action->getMetaData(variableName_));
+        case ActionObject::SRC:
+          owner = action->getSourceObject()->getVariableValue(variableName_);
+          break;
+        case ActionObject::DST:
+          owner = action->getDestinationObject()->getVariableValue(variableName_);
           break;
-        }
+        case ActionObject::META:
+          scratch = action->getMetaData(variableName_);
+          return &scratch;
       }
-      if (ptr == nullptr) {
+      if (owner == nullptr) {
         auto error = fmt::format("Undefined variable={0}", variableName_);
         spdlog::error(error);
         throw std::invalid_argument(error);
       }
-      return ptr;
+      return owner.get();
     }
     default:
       throw std::runtime_error("Unresolvable variable!");
   }
 }
 
-}  // namespace griddly
\ No newline at end of file
+bool ObjectVariable::isLiteral() const {
+  return objectVariableType_ == ObjectVariableType::LITERAL;
+}
+
+bool ObjectVariable::readsGlobalVariable(const std::unordered_map<std::string, uint32_t>& variableSlots, uint32_t localVariableCount) const {
+  switch (objectVariableType_) {
+    case ObjectVariableType::RESOLVED:
+      return resolvedSlot_ >= localVariableCount;
+    case ObjectVariableType::UNRESOLVED: {
+      if (actionObject_ == ActionObject::META) {
+        return false;
+      }
+      auto variable = variableSlots.find(variableName_);
+      return variable != variableSlots.end() && variable->second >= localVariableCount;
+    }
+    default:
+      return false;
+  }
+}
+
+}  // namespace griddly
@@ -8,6 +8,7 @@
 namespace griddly {
 
 class Action;
+class Object;
 
 enum class ObjectVariableType {
   LITERAL,
@@ -23,21 +24,31 @@ enum class ActionObject {
 
 class ObjectVariable {
  public:
-  ObjectVariable(YAML::Node commandArguments, std::unordered_map<std::string, std::shared_ptr<int32_t>>& availableVariables);
-  [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] int32_t resolve(std::shared_ptr<Action> action) const;
-  [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] std::shared_ptr<int32_t> resolve_ptr(std::shared_ptr<Action> action) const;
+  // variableSlots is the variable layout of the object type that the variable is compiled for
+  ObjectVariable(YAML::Node commandArguments, const std::unordered_map<std::string, uint32_t>& variableSlots);
+  [[nodiscard]] int32_t resolve(const Object& object, const std::shared_ptr<Action>& action) const;
+
+  // Pointer to the value so it can be modified. If the value belongs to another object, owner keeps it alive while it is used.
+  // Action meta data cannot be modified, so scratch is returned and the modification is discarded.
+  [[nodiscard]] int32_t* resolve_ptr(const Object& object, const std::shared_ptr<Action>& action, std::shared_ptr<int32_t>& owner, int32_t& scratch) const;
+
+  [[nodiscard]] bool isLiteral() const;
+
+  // True if the value is read from a global variable of the layout the variable was compiled for.
+  // Variables of the source and destination objects are looked up by name, so they count if the name is a global variable.
+  [[nodiscard]] bool readsGlobalVariable(const std::unordered_map<std::string, uint32_t>& variableSlots, uint32_t localVariableCount) const;
 
  private:
   ObjectVariableType objectVariableType_;
 
   // Literal value
-  int32_t literalValue_;
+  int32_t literalValue_ = 0;
 
-  // pre-resolved value
-  std::shared_ptr<int32_t> resolvedValue_;
+  // pre-resolved slot in the variables of the object the behaviour runs on
+  uint32_t resolvedSlot_ = 0;
 
   // value that needs to be resolved at time of action
   std::string variableName_;
-  ActionObject actionObject_;
+  ActionObject actionObject_ = ActionObject::SRC;
 };
 }  // namespace griddly
\ No newline at end of file
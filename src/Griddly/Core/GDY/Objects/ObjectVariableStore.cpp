@@ -0,0 +1,87 @@
+#include "ObjectVariableStore.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace griddly {
+
+ObjectVariableRow::ObjectVariableRow(std::shared_ptr<ObjectVariableStore> variableStore, uint32_t row, int32_t* firstValue)
+    : variableStore_(std::move(variableStore)), row_(row), firstValue_(firstValue) {
+}
+
+ObjectVariableRow::~ObjectVariableRow() {
+  variableStore_->releaseRow(row_);
+}
+
+uint32_t ObjectVariableRow::getRow() const {
+  return row_;
+}
+
+const std::shared_ptr<ObjectVariableStore>& ObjectVariableRow::getVariableStore() const {
+  return variableStore_;
+}
+
+ObjectVariableStore::ObjectVariableStore(std::vector<std::string> variableNames)
+    : variableNames_(std::move(variableNames)) {
+}
+
+std::shared_ptr<ObjectVariableRow> ObjectVariableStore::allocateRow(const std::vector<int32_t>& initialValues) {
+  uint32_t row;
+  if (!freeRows_.empty()) {
+    row = freeRows_.back();
+    freeRows_.pop_back();
+  } else {
+    row = static_cast<uint32_t>(allocatedRows_.size());
+    allocatedRows_.push_back(false);
+
+    if (row % ROWS_PER_CHUNK == 0) {
+      spdlog::debug("Allocating variable chunk {0} with {1} columns", chunks_.size(), variableNames_.size());
+      chunks_.emplace_back(new int32_t[ROWS_PER_CHUNK * std::max<size_t>(variableNames_.size(), 1)]{});  // NOLINT
+    }
+  }
+
+  allocatedRows_[row] = true;
+
+  for (uint32_t column = 0; column < variableNames_.size(); column++) {
+    *getValuePtr(column, row) = column < initialValues.size() ? initialValues[column] : 0;
+  }
+
+  return std::make_shared<ObjectVariableRow>(shared_from_this(), row, getValuePtr(0, row));
+}
+
+void ObjectVariableStore::releaseRow(uint32_t row) {
+  allocatedRows_[row] = false;
+  freeRows_.push_back(row);
+}
+
+int32_t* ObjectVariableStore::getValuePtr(uint32_t column, uint32_t row) const {
+  return chunks_[row / ROWS_PER_CHUNK].get() + column * ROWS_PER_CHUNK + row % ROWS_PER_CHUNK;
+}
+
+const std::vector<std::string>& ObjectVariableStore::getVariableNames() const {
+  return variableNames_;
+}
+
+uint32_t ObjectVariableStore::getColumnCount() const {
+  return static_cast<uint32_t>(variableNames_.size());
+}
+
+uint32_t ObjectVariableStore::getRowCount() const {
+  return static_cast<uint32_t>(allocatedRows_.size());
+}
+
+bool ObjectVariableStore::isRowAllocated(uint32_t row) const {
+  return row < allocatedRows_.size() && allocatedRows_[row];
+}
+
+const int32_t* ObjectVariableStore::getColumnChunk(uint32_t column, uint32_t chunk) const {
+  return chunks_[chunk].get() + column * ROWS_PER_CHUNK;
+}
+
+uint32_t ObjectVariableStore::getChunkCount() const {
+  return static_cast<uint32_t>(chunks_.size());
+}
+
+}  // namespace griddly
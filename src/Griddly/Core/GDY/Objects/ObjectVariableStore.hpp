@@ -0,0 +1,73 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace griddly {
+
+class ObjectVariableStore;
+
+// The variables of a single object, one row of the variable store of its object type.
+// The row is returned to the store when the last reference to it is released.
+class ObjectVariableRow {
+ public:
+  ObjectVariableRow(std::shared_ptr<ObjectVariableStore> variableStore, uint32_t row, int32_t* firstValue);
+  ~ObjectVariableRow();
+
+  ObjectVariableRow(const ObjectVariableRow&) = delete;
+  ObjectVariableRow& operator=(const ObjectVariableRow&) = delete;
+
+  int32_t* getValuePtr(uint32_t column) const;
+
+  uint32_t getRow() const;
+
+  const std::shared_ptr<ObjectVariableStore>& getVariableStore() const;
+
+ private:
+  const std::shared_ptr<ObjectVariableStore> variableStore_;
+  const uint32_t row_;
+  int32_t* const firstValue_;
+};
+
+// Columnar storage for the local variables of every object of one type.
+// Each variable is a column and each object owns a row. Rows are allocated in chunks, within a chunk every column is contiguous
+// and the address of a value never changes, so objects can hold pointers to their values.
+class ObjectVariableStore : public std::enable_shared_from_this<ObjectVariableStore> {
+ public:
+  static constexpr uint32_t ROWS_PER_CHUNK = 256;
+
+  explicit ObjectVariableStore(std::vector<std::string> variableNames);
+
+  std::shared_ptr<ObjectVariableRow> allocateRow(const std::vector<int32_t>& initialValues);
+
+  const std::vector<std::string>& getVariableNames() const;
+
+  uint32_t getColumnCount() const;
+
+  // Rows [0, getRowCount()) have been allocated at some point, isRowAllocated tells if they are currently in use
+  uint32_t getRowCount() const;
+  bool isRowAllocated(uint32_t row) const;
+
+  // The values of a column for the rows [chunk * ROWS_PER_CHUNK, (chunk + 1) * ROWS_PER_CHUNK)
+  const int32_t* getColumnChunk(uint32_t column, uint32_t chunk) const;
+  uint32_t getChunkCount() const;
+
+ private:
+  friend class ObjectVariableRow;
+
+  void releaseRow(uint32_t row);
+
+  int32_t* getValuePtr(uint32_t column, uint32_t row) const;
+
+  const std::vector<std::string> variableNames_;
+
+  std::vector<std::unique_ptr<int32_t[]>> chunks_;
+  std::vector<bool> allocatedRows_;
+  std::vector<uint32_t> freeRows_;
+};
+
+inline int32_t* ObjectVariableRow::getValuePtr(uint32_t column) const {
+  return firstValue_ + column * ObjectVariableStore::ROWS_PER_CHUNK;
+}
+
+}  // namespace griddly
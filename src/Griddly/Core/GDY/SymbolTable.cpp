@@ -0,0 +1,41 @@
+#include "SymbolTable.hpp"
+
+#define SPDLOG_HEADER_ONLY
+#include <spdlog/fmt/fmt.h>
+
+#include <stdexcept>
+
+namespace griddly {
+
+uint32_t SymbolTable::intern(const std::string& name) {
+  auto idIt = ids_.find(name);
+  if (idIt != ids_.end()) {
+    return idIt->second;
+  }
+
+  auto id = static_cast<uint32_t>(names_.size());
+  ids_.insert({name, id});
+  names_.push_back(name);
+  return id;
+}
+
+uint32_t SymbolTable::getId(const std::string& name) const {
+  auto idIt = ids_.find(name);
+  if (idIt == ids_.end()) {
+    return UNKNOWN_SYMBOL;
+  }
+  return idIt->second;
+}
+
+const std::string& SymbolTable::getName(uint32_t id) const {
+  if (id >= names_.size()) {
+    throw std::out_of_range(fmt::format("Symbol with id {0} does not exist.", id));
+  }
+  return names_[id];
+}
+
+uint32_t SymbolTable::size() const {
+  return static_cast<uint32_t>(names_.size());
+}
+
+}  // namespace griddly
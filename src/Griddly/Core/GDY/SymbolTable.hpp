@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace griddly {
+
+// Maps object and action names to dense integer ids, so they can be used as indexes while the environment is running.
+// Ids are assigned in the order names are first interned and are never reused.
+class SymbolTable {
+ public:
+  static constexpr uint32_t UNKNOWN_SYMBOL = std::numeric_limits<uint32_t>::max();
+
+  // Returns the id of the name, assigning a new id if the name has not been seen before
+  uint32_t intern(const std::string& name);
+
+  // Returns the id of the name, or UNKNOWN_SYMBOL if the name has not been interned
+  uint32_t getId(const std::string& name) const;
+
+  const std::string& getName(uint32_t id) const;
+
+  uint32_t size() const;
+
+ private:
+  std::unordered_map<std::string, uint32_t> ids_;
+  std::vector<std::string> names_;
+};
+
+}  // namespace griddly
@@ -1,18 +1,50 @@
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <cstring>
+#include <map>
 #include <utility>
 
+#include "DelayedActionQueue.hpp"
 #include "GDY/Actions/Action.hpp"
 #include "GameProcess.hpp"
 #include "Players/Player.hpp"
+#include "Util/StateBuffer.hpp"
 
 namespace griddly {
 
+namespace {
+const uint32_t STATE_MAGIC = 0x53594447;  // "GDYS"
+const uint32_t STATE_VERSION = 2;
+
+struct SavedObject {
+  uint32_t typeIndex;
+  uint32_t playerId;
+  glm::ivec2 location;
+  Direction direction;
+  uint32_t renderTileId;
+  uint32_t entityId;
+  size_t firstValue;
+};
+
+struct SavedDelayedAction {
+  uint32_t playerId;
+  uint32_t executionTick;
+  std::string actionName;
+  uint32_t originatingPlayerId;
+  // Index of the source object in the saved objects, or -(playerId + 1) for the default object of a player
+  int32_t sourceRef;
+  glm::ivec2 vectorToDest;
+  glm::ivec2 orientationVector;
+  std::unordered_map<std::string, int32_t> metaData;
+};
+}  // namespace
+
 GameProcess::GameProcess(
     std::string globalObserverName,
     std::shared_ptr<GDYFactory> gdyFactory,
     std::shared_ptr<Grid> grid)
-    : grid_(std::move(grid)), globalObserverName_(globalObserverName), gdyFactory_(std::move(gdyFactory)) {
+    : grid_(std::move(grid)), globalObserverName_(globalObserverName), gdyFactory_(std::move(gdyFactory)), validActionCache_(grid_) {
 }
 
 void GameProcess::addPlayer(std::shared_ptr<Player> player) {
@@ -91,6 +123,8 @@ void GameProcess::init(bool isCloned) {
     }
   }
 
+  groupVectorObservers();
+
   terminationHandler_ = gdyFactory_->createTerminationHandler(grid_, players_);
 
   // if the environment is cloned, it will not be reset before being used, so make sure the observers are reset
@@ -115,6 +149,32 @@ void GameProcess::resetObservers() {
   observer_->reset();
 }
 
+void GameProcess::groupVectorObservers() {
+  std::vector<std::shared_ptr<Observer>> observers{observer_};
+  for (const auto& p : players_) {
+    observers.push_back(p->getObserver());
+  }
+
+  std::vector<std::shared_ptr<VectorObserver>> vectorObservers;
+  for (const auto& observer : observers) {
+    auto vectorObserver = std::dynamic_pointer_cast<VectorObserver>(observer);
+    if (vectorObserver != nullptr) {
+      vectorObservers.push_back(vectorObserver);
+    }
+  }
+
+  // A single observer gains nothing from a group
+  if (vectorObservers.size() < 2) {
+    return;
+  }
+
+  spdlog::debug("Rendering {0} vector observers together.", vectorObservers.size());
+  vectorObserverGroup_ = std::make_shared<VectorObserverGroup>(grid_);
+  for (const auto& vectorObserver : vectorObservers) {
+    vectorObserverGroup_->addObserver(vectorObserver);
+  }
+}
+
 void GameProcess::reset() {
   if (!isInitialized_) {
     throw std::runtime_error("Cannot reset game process before initialization.");
@@ -135,6 +195,10 @@ void GameProcess::reset() {
   spdlog::debug("Resetting Termination Handler.");
   terminationHandler_ = gdyFactory_->createTerminationHandler(grid_, players_);
 
+  checkpoints_.clear();
+  grid_->clearCheckpoints();
+  validActionCache_.clear();
+
   requiresReset_ = false;
   spdlog::debug("Reset Complete.");
 }
@@ -146,6 +210,7 @@ void GameProcess::release() {
   }
 
   players_.clear();
+  vectorObserverGroup_.reset();
 
   grid_->reset();
 }
@@ -213,30 +278,70 @@ std::vector<uint32_t> GameProcess::getAvailableActionIdsAtLocation(glm::ivec2 lo
 
   spdlog::debug("Getting available actionIds for action [{}] at location [{0},{1}]", actionName, location.x, location.y);
 
-  std::vector<uint32_t> availableActionIds{};
   if (srcObject) {
     const auto& actionInputDefinitions = gdyFactory_->getActionInputsDefinitions();
-    const auto& actionInputDefinition = actionInputDefinitions.at(actionName);
+    validActionCache_.update();
+    return validActionCache_.getValidActionIds(srcObject, actionName, actionInputDefinitions.at(actionName));
+  }
+
+  return {};
+}
+
+std::vector<uint32_t> GameProcess::getValidActionMaskShape() const {
+  const auto& actionInputsDefinitions = gdyFactory_->getActionInputsDefinitions();
 
-    auto relativeToSource = actionInputDefinition.relative;
+  uint32_t actionIdCount = 1;
+  auto externalActionNames = gdyFactory_->getExternalActionNames();
+  for (const auto& actionName : externalActionNames) {
+    for (const auto& inputMapping : actionInputsDefinitions.at(actionName).inputMappings) {
+      actionIdCount = std::max(actionIdCount, inputMapping.first + 1);
+    }
+  }
+
+  return {grid_->getWidth(), grid_->getHeight(), static_cast<uint32_t>(externalActionNames.size()), actionIdCount};
+}
+
+void GameProcess::writeValidActionMask(uint32_t playerId, uint8_t* mask) const {
+  auto maskShape = getValidActionMaskShape();
+  auto width = maskShape[0];
+  auto height = maskShape[1];
+  auto actionTypeCount = maskShape[2];
+  auto actionIdCount = maskShape[3];
+
+  std::memset(mask, 0, static_cast<size_t>(width) * height * actionTypeCount * actionIdCount);
+
+  const auto& actionInputsDefinitions = gdyFactory_->getActionInputsDefinitions();
+  auto externalActionNames = gdyFactory_->getExternalActionNames();
+
+  std::unordered_map<std::string, uint32_t> actionTypeIds;
+  for (uint32_t actionTypeId = 0; actionTypeId < actionTypeCount; actionTypeId++) {
+    actionTypeIds.insert({externalActionNames[actionTypeId], actionTypeId});
+  }
 
-    for (const auto& inputMapping : actionInputDefinition.inputMappings) {
-      auto actionId = inputMapping.first;
-      auto mapping = inputMapping.second;
+  validActionCache_.update();
+  for (const auto& object : grid_->getObjects()) {
+    if (object->getPlayerId() != playerId) {
+      continue;
+    }
 
-      auto metaData = mapping.metaData;
+    auto location = object->getLocation();
+    if (location.x < 0 || location.y < 0 || static_cast<uint32_t>(location.x) >= width || static_cast<uint32_t>(location.y) >= height) {
+      continue;
+    }
 
-      // Create an fake action to test for availability (and not duplicate a bunch of code)
-      auto potentialAction = std::make_shared<Action>(Action(grid_, actionName, 0, 0, metaData));
-      potentialAction->init(srcObject, mapping.vectorToDest, mapping.orientationVector, relativeToSource);
+    for (const auto& actionName : object->getAvailableActionNames()) {
+      auto actionTypeIdIt = actionTypeIds.find(actionName);
+      if (actionTypeIdIt == actionTypeIds.end()) {
+        continue;
+      }
 
-      if (srcObject->isValidAction(potentialAction)) {
-        availableActionIds.push_back(actionId);
+      auto* actionIdMask = mask + ((static_cast<size_t>(location.x) * height + location.y) * actionTypeCount + actionTypeIdIt->second) * actionIdCount;
+      for (auto actionId : validActionCache_.getValidActionIds(object, actionName, actionInputsDefinitions.at(actionName))) {
+        actionIdMask[actionId] = 1;
+        actionIdMask[0] = 1;
       }
     }
   }
-
-  return availableActionIds;
 }
 
 void GameProcess::generateStateHash(StateInfo& stateInfo) {
@@ -268,6 +373,385 @@ void GameProcess::generateStateHash(StateInfo& stateInfo) {
   }
 }
 
+std::vector<uint8_t> GameProcess::saveState() const {
+  std::vector<uint8_t> buffer;
+  saveState(buffer);
+  return buffer;
+}
+
+void GameProcess::saveState(std::vector<uint8_t>& buffer) const {
+  buffer.clear();
+  StateWriter writer(buffer);
+
+  auto tickCount = *grid_->getTickCount();
+
+  writer.write(STATE_MAGIC);
+  writer.write(STATE_VERSION);
+  writer.write(grid_->getWidth());
+  writer.write(grid_->getHeight());
+  writer.write(tickCount);
+  writer.write(grid_->getRandomGenerator()->getEngine());
+  writer.write(grid_->getNextEntityId());
+
+  writer.write(static_cast<uint8_t>(requiresReset_));
+  writer.write(static_cast<uint32_t>(accumulatedRewards_.size()));
+  for (const auto& rewardIt : accumulatedRewards_) {
+    writer.write(rewardIt.first);
+    writer.write(rewardIt.second);
+  }
+
+  // _steps is the tick count, which is already saved
+  const auto& globalVariables = grid_->getGlobalVariables();
+  writer.write(static_cast<uint32_t>(globalVariables.size() - globalVariables.count("_steps")));
+  for (const auto& globalVariableIt : globalVariables) {
+    if (globalVariableIt.first == "_steps") {
+      continue;
+    }
+    writer.writeString(globalVariableIt.first);
+    writer.write(static_cast<uint32_t>(globalVariableIt.second.size()));
+    for (const auto& playerValueIt : globalVariableIt.second) {
+      writer.write(playerValueIt.first);
+      writer.write(*playerValueIt.second);
+    }
+  }
+
+  // Local variables are saved by name once per object type, then as a plain list of values for every object
+  const auto& objects = grid_->getObjects();
+  std::vector<std::shared_ptr<ObjectBehaviourTable>> objectTypes;
+  std::unordered_map<std::string, uint32_t> objectTypeIndexes;
+  std::unordered_map<const Object*, int32_t> objectIndexes;
+  for (const auto& object : objects) {
+    auto typeIt = objectTypeIndexes.insert({object->getObjectName(), static_cast<uint32_t>(objectTypes.size())});
+    if (typeIt.second) {
+      objectTypes.push_back(object->getBehaviourTable());
+    }
+    objectIndexes.insert({object.get(), static_cast<int32_t>(objectIndexes.size())});
+  }
+
+  writer.write(static_cast<uint32_t>(objectTypes.size()));
+  for (const auto& objectTypeIt : objectTypeIndexes) {
+    const auto& behaviourTable = objectTypes[objectTypeIt.second];
+    writer.writeString(objectTypeIt.first);
+    writer.write(objectTypeIt.second);
+    writer.write(behaviourTable->localVariableCount);
+    for (uint32_t slot = 0; slot < behaviourTable->localVariableCount; slot++) {
+      writer.writeString(behaviourTable->localVariableNames[slot]);
+    }
+  }
+
+  writer.write(static_cast<uint32_t>(objects.size()));
+  for (const auto& object : objects) {
+    const auto& location = object->getLocation();
+    writer.write(objectTypeIndexes.at(object->getObjectName()));
+    writer.write(object->getPlayerId());
+    writer.write(location.x);
+    writer.write(location.y);
+    writer.write(static_cast<uint8_t>(object->getObjectOrientation().getDirection()));
+    writer.write(object->getRenderTileId());
+    writer.write(object->getEntityId());
+    for (uint32_t slot = 0; slot < object->getBehaviourTable()->localVariableCount; slot++) {
+      writer.write(*object->getVariableValueAt(slot));
+    }
+  }
+
+  // Delayed actions are saved in the order they were queued, so loadState queues them again with the same order on every tick
+  auto pendingActions = grid_->getDelayedActions().getPendingActions();
+  std::sort(pendingActions.begin(), pendingActions.end(), [](const DelayedActionQueueItem& a, const DelayedActionQueueItem& b) {
+    return a.sequence < b.sequence;
+  });
+
+  // Delayed actions reference their source object by its index in the saved objects
+  std::vector<std::pair<int32_t, DelayedActionQueueItem>> delayedActions;
+  for (const auto& delayedAction : pendingActions) {
+    auto sourceObject = delayedAction.action->getSourceObject();
+    auto sourceIndexIt = objectIndexes.find(sourceObject.get());
+    if (sourceIndexIt != objectIndexes.end()) {
+      delayedActions.push_back({sourceIndexIt->second, delayedAction});
+      continue;
+    }
+
+    for (uint32_t playerId = 0; playerId <= grid_->getPlayerCount(); playerId++) {
+      if (grid_->getPlayerDefaultObject(playerId) == sourceObject) {
+        delayedActions.push_back({-static_cast<int32_t>(playerId) - 1, delayedAction});
+        break;
+      }
+    }
+  }
+
+  writer.write(static_cast<uint32_t>(delayedActions.size()));
+  for (const auto& delayedActionIt : delayedActions) {
+    const auto& action = delayedActionIt.second.action;
+    auto vectorToDest = action->getVectorToDest();
+    auto orientationVector = action->getOrientationVector();
+    auto metaData = action->getMetaData();
+
+    writer.write(delayedActionIt.second.playerId);
+    writer.write(delayedActionIt.second.priority);
+    writer.writeString(action->getActionName());
+    writer.write(action->getOriginatingPlayerId());
+    writer.write(delayedActionIt.first);
+    writer.write(vectorToDest.x);
+    writer.write(vectorToDest.y);
+    writer.write(orientationVector.x);
+    writer.write(orientationVector.y);
+    writer.write(static_cast<uint32_t>(metaData.size()));
+    for (const auto& metaDataIt : metaData) {
+      writer.writeString(metaDataIt.first);
+      writer.write(metaDataIt.second);
+    }
+  }
+}
+
+void GameProcess::loadState(const std::vector<uint8_t>& buffer) {
+  loadState(buffer.data(), buffer.size());
+}
+
+void GameProcess::loadState(const uint8_t* data, size_t size) {
+  StateReader reader(data, size);
+
+  // The whole snapshot is read and checked before the game is modified, so a bad buffer leaves the game as it was
+  if (reader.read<uint32_t>() != STATE_MAGIC || reader.read<uint32_t>() != STATE_VERSION) {
+    throw std::invalid_argument("Buffer does not contain a game state saved by this version of Griddly.");
+  }
+
+  auto width = reader.read<uint32_t>();
+  auto height = reader.read<uint32_t>();
+  if (width != grid_->getWidth() || height != grid_->getHeight()) {
+    auto error = fmt::format("Cannot load a state of size {0}x{1} into a grid of size {2}x{3}.", width, height, grid_->getWidth(), grid_->getHeight());
+    throw std::invalid_argument(error);
+  }
+
+  auto tickCount = reader.read<int32_t>();
+  auto randomEngine = reader.read<std::mt19937>();
+  auto nextEntityId = reader.read<uint32_t>();
+
+  auto requiresReset = reader.read<uint8_t>() != 0;
+  std::unordered_map<uint32_t, int32_t> accumulatedRewards;
+  auto rewardCount = reader.read<uint32_t>();
+  for (uint32_t i = 0; i < rewardCount; i++) {
+    auto playerId = reader.read<uint32_t>();
+    accumulatedRewards[playerId] = reader.read<int32_t>();
+  }
+
+  const auto& globalVariables = grid_->getGlobalVariables();
+  std::vector<std::pair<std::shared_ptr<int32_t>, int32_t>> globalValues;
+  auto globalVariableCount = reader.read<uint32_t>();
+  for (uint32_t i = 0; i < globalVariableCount; i++) {
+    auto variableName = reader.readString();
+    auto globalVariableIt = globalVariables.find(variableName);
+    auto playerValueCount = reader.read<uint32_t>();
+    for (uint32_t p = 0; p < playerValueCount; p++) {
+      auto playerId = reader.read<uint32_t>();
+      auto value = reader.read<int32_t>();
+      if (globalVariableIt == globalVariables.end() || globalVariableIt->second.find(playerId) == globalVariableIt->second.end()) {
+        auto error = fmt::format("Cannot load state, global variable {0} for player {1} does not exist in this game.", variableName, playerId);
+        throw std::invalid_argument(error);
+      }
+      globalValues.push_back({globalVariableIt->second.at(playerId), value});
+    }
+  }
+
+  auto objectTypeCount = reader.read<uint32_t>();
+  std::vector<std::string> objectTypeNames(objectTypeCount);
+  std::vector<std::vector<std::string>> objectTypeVariableNames(objectTypeCount);
+  for (uint32_t i = 0; i < objectTypeCount; i++) {
+    auto objectName = reader.readString();
+    auto typeIndex = reader.read<uint32_t>();
+    if (typeIndex >= objectTypeCount) {
+      throw std::invalid_argument("State buffer is truncated or corrupt.");
+    }
+    objectTypeNames[typeIndex] = objectName;
+    auto variableCount = reader.read<uint32_t>();
+    for (uint32_t v = 0; v < variableCount; v++) {
+      objectTypeVariableNames[typeIndex].push_back(reader.readString());
+    }
+  }
+
+  std::vector<SavedObject> savedObjects(reader.read<uint32_t>());
+  std::vector<int32_t> savedObjectValues;
+  for (auto& savedObject : savedObjects) {
+    savedObject.typeIndex = reader.read<uint32_t>();
+    if (savedObject.typeIndex >= objectTypeCount) {
+      throw std::invalid_argument("State buffer is truncated or corrupt.");
+    }
+    savedObject.playerId = reader.read<uint32_t>();
+    savedObject.location.x = reader.read<int32_t>();
+    savedObject.location.y = reader.read<int32_t>();
+    auto direction = reader.read<uint8_t>();
+    if (direction > static_cast<uint8_t>(Direction::NONE)) {
+      throw std::invalid_argument("State buffer is truncated or corrupt.");
+    }
+    savedObject.direction = static_cast<Direction>(direction);
+    savedObject.renderTileId = reader.read<uint32_t>();
+    savedObject.entityId = reader.read<uint32_t>();
+    savedObject.firstValue = savedObjectValues.size();
+    for (uint32_t v = 0; v < objectTypeVariableNames[savedObject.typeIndex].size(); v++) {
+      savedObjectValues.push_back(reader.read<int32_t>());
+    }
+  }
+
+  std::vector<SavedDelayedAction> savedDelayedActions(reader.read<uint32_t>());
+  for (auto& savedDelayedAction : savedDelayedActions) {
+    savedDelayedAction.playerId = reader.read<uint32_t>();
+    savedDelayedAction.executionTick = reader.read<uint32_t>();
+    savedDelayedAction.actionName = reader.readString();
+    savedDelayedAction.originatingPlayerId = reader.read<uint32_t>();
+    savedDelayedAction.sourceRef = reader.read<int32_t>();
+    savedDelayedAction.vectorToDest.x = reader.read<int32_t>();
+    savedDelayedAction.vectorToDest.y = reader.read<int32_t>();
+    savedDelayedAction.orientationVector.x = reader.read<int32_t>();
+    savedDelayedAction.orientationVector.y = reader.read<int32_t>();
+    auto metaDataCount = reader.read<uint32_t>();
+    for (uint32_t m = 0; m < metaDataCount; m++) {
+      auto metaDataName = reader.readString();
+      savedDelayedAction.metaData[metaDataName] = reader.read<int32_t>();
+    }
+
+    if (savedDelayedAction.sourceRef >= static_cast<int32_t>(savedObjects.size()) || -savedDelayedAction.sourceRef - 1 > static_cast<int32_t>(grid_->getPlayerCount())) {
+      throw std::invalid_argument("State buffer is truncated or corrupt.");
+    }
+  }
+
+  if (!reader.atEnd()) {
+    throw std::invalid_argument("State buffer is truncated or corrupt.");
+  }
+
+  // A loaded state cannot be rolled back to the checkpoints of the previous state
+  checkpoints_.clear();
+  grid_->clearCheckpoints();
+
+  // Remove the current objects, keeping them so they can be reused for saved objects of the same type and player.
+  // Objects shared with a forked game are still in use there, so they cannot be reused
+  std::map<std::pair<std::string, uint32_t>, std::vector<std::shared_ptr<Object>>> reusableObjects;
+  std::vector<std::shared_ptr<Object>> currentObjects(grid_->getObjects().begin(), grid_->getObjects().end());
+  for (const auto& object : currentObjects) {
+    grid_->removeObject(object);
+    if (!object->isShared()) {
+      reusableObjects[{object->getObjectName(), object->getPlayerId()}].push_back(object);
+    }
+  }
+
+  grid_->clearDelayedActions();
+  grid_->setTickCount(tickCount);
+  grid_->getRandomGenerator()->setEngine(randomEngine);
+
+  for (const auto& globalValue : globalValues) {
+    *globalValue.first = globalValue.second;
+  }
+
+  // Saved variable columns -> local variable slots of each object type, resolved from the first object of the type
+  std::vector<std::vector<int32_t>> objectTypeSlots(objectTypeCount);
+  std::vector<std::shared_ptr<Object>> loadedObjects;
+  loadedObjects.reserve(savedObjects.size());
+  auto objectGenerator = gdyFactory_->getObjectGenerator();
+  for (const auto& savedObject : savedObjects) {
+    const auto& objectName = objectTypeNames[savedObject.typeIndex];
+
+    std::shared_ptr<Object> object;
+    auto reusableObjectsIt = reusableObjects.find({objectName, savedObject.playerId});
+    if (reusableObjectsIt != reusableObjects.end() && !reusableObjectsIt->second.empty()) {
+      object = reusableObjectsIt->second.back();
+      reusableObjectsIt->second.pop_back();
+    } else {
+      object = objectGenerator->newInstance(objectName, savedObject.playerId, grid_);
+    }
+
+    const auto& variableNames = objectTypeVariableNames[savedObject.typeIndex];
+    auto& slots = objectTypeSlots[savedObject.typeIndex];
+    if (slots.empty() && !variableNames.empty()) {
+      const auto& behaviourTable = object->getBehaviourTable();
+      for (const auto& variableName : variableNames) {
+        auto slotIt = behaviourTable->variableSlots.find(variableName);
+        auto isLocal = slotIt != behaviourTable->variableSlots.end() && slotIt->second < behaviourTable->localVariableCount;
+        slots.push_back(isLocal ? static_cast<int32_t>(slotIt->second) : -1);
+      }
+    }
+
+    for (uint32_t v = 0; v < slots.size(); v++) {
+      if (slots[v] >= 0) {
+        *object->getVariableValueAt(slots[v]) = savedObjectValues[savedObject.firstValue + v];
+      }
+    }
+
+    // Reused objects still have the ids they had in the previous state
+    object->setRenderTileId(savedObject.renderTileId);
+    object->setEntityId(savedObject.entityId);
+    grid_->addObject(savedObject.location, object, false, nullptr, DiscreteOrientation(savedObject.direction));
+    loadedObjects.push_back(object);
+  }
+
+  grid_->setNextEntityId(nextEntityId);
+
+  for (const auto& savedDelayedAction : savedDelayedActions) {
+    auto sourceObject = savedDelayedAction.sourceRef >= 0
+                            ? loadedObjects[savedDelayedAction.sourceRef]
+                            : grid_->getPlayerDefaultObject(-savedDelayedAction.sourceRef - 1);
+    auto remainingTicks = std::max<int32_t>(static_cast<int32_t>(savedDelayedAction.executionTick) - tickCount, 0);
+
+    auto action = grid_->createAction(savedDelayedAction.actionName, savedDelayedAction.originatingPlayerId, remainingTicks, savedDelayedAction.metaData);
+
+    // The saved vectors are already relative to the source, so relative is set to false here
+    action->init(sourceObject, savedDelayedAction.vectorToDest, savedDelayedAction.orientationVector, false);
+    grid_->delayAction(savedDelayedAction.playerId, action);
+  }
+
+  accumulatedRewards_ = accumulatedRewards;
+  requiresReset_ = requiresReset;
+
+  updatePlayerAvatars();
+}
+
+void GameProcess::updatePlayerAvatars() {
+  auto playerAvatarObjects = grid_->getPlayerAvatarObjects();
+  for (auto& p : players_) {
+    auto playerAvatarIt = playerAvatarObjects.find(p->getId());
+    if (playerAvatarIt != playerAvatarObjects.end()) {
+      p->setAvatar(playerAvatarIt->second);
+    }
+  }
+}
+
+void GameProcess::pushCheckpoint() {
+  if (!isInitialized_) {
+    throw std::runtime_error("Cannot create a checkpoint before the game process is initialized.");
+  }
+
+  checkpoints_.push_back({accumulatedRewards_, requiresReset_});
+  grid_->pushCheckpoint();
+}
+
+void GameProcess::rollback() {
+  if (checkpoints_.empty()) {
+    throw std::runtime_error("There is no checkpoint to roll back to.");
+  }
+
+  grid_->rollback();
+
+  accumulatedRewards_ = std::move(checkpoints_.back().accumulatedRewards);
+  requiresReset_ = checkpoints_.back().requiresReset;
+  checkpoints_.pop_back();
+
+  // Avatars that were removed since the checkpoint are back in the grid
+  updatePlayerAvatars();
+}
+
+void GameProcess::discardCheckpoint() {
+  if (checkpoints_.empty()) {
+    throw std::runtime_error("There is no checkpoint to discard.");
+  }
+
+  grid_->discardCheckpoint();
+  checkpoints_.pop_back();
+}
+
+size_t GameProcess::getCheckpointCount() const {
+  return checkpoints_.size();
+}
+
+uint64_t GameProcess::getStateHash() const {
+  return grid_->getStateHash();
+}
+
 StateInfo GameProcess::getState() const {
   StateInfo stateInfo;
 
@@ -7,6 +7,8 @@
 #include "GDY/TerminationHandler.hpp"
 #include "Grid.hpp"
 #include "Observers/Observer.hpp"
+#include "Observers/VectorObserverGroup.hpp"
+#include "ValidActionCache.hpp"
 
 namespace griddly {
 
@@ -81,8 +83,38 @@ class GameProcess : public std::enable_shared_from_this<GameProcess> {
   virtual std::vector<uint32_t> getAvailableActionIdsAtLocation(
       glm::ivec2 location, std::string actionName) const;
 
+  // Shape of the valid action mask of a player, [grid width, grid height, action types, action ids].
+  // Action types are in the order of the external action names, the last dimension fits the largest action id of any of them.
+  std::vector<uint32_t> getValidActionMaskShape() const;
+
+  // Writes the valid actions of a player's objects into a dense mask holding the product of getValidActionMaskShape() bytes in row-major order.
+  // The mask is built in one pass over the player's objects rather than one query per location and action name,
+  // and preconditions are only checked for objects that the changes since the last query may affect.
+  // Like the valid action trees, action id 0 is set for every action type that has a valid action at a location.
+  virtual void writeValidActionMask(uint32_t playerId, uint8_t* mask) const;
+
   virtual StateInfo getState() const;
 
+  // Hash of the objects and global variables, kept up to date as the game changes so it is cheap to get after every step.
+  // Unlike the hash in getState it is the same for equal states in every process.
+  virtual uint64_t getStateHash() const;
+
+  // Writes a compact binary snapshot of the game (objects and their entity ids, variables, delayed actions, tick count and random generator) into the buffer.
+  // The snapshot can only be loaded into a game process created from the same GDY with the same grid size.
+  virtual void saveState(std::vector<uint8_t>& buffer) const;
+  std::vector<uint8_t> saveState() const;
+
+  // Restores a snapshot written by saveState. Objects of the current state are reused where the object type and player match.
+  virtual void loadState(const uint8_t* data, size_t size);
+  void loadState(const std::vector<uint8_t>& buffer);
+
+  // Checkpoints for tree search. Changes to the game after a checkpoint are recorded so rollback can undo them without cloning the game.
+  // Checkpoints can be nested and are dropped when the game is reset or a state is loaded.
+  virtual void pushCheckpoint();
+  virtual void rollback();
+  virtual void discardCheckpoint();
+  virtual size_t getCheckpointCount() const;
+
   virtual uint32_t getNumPlayers() const;
 
   virtual void seedRandomGenerator(uint32_t seed) = 0;
@@ -124,6 +156,22 @@ class GameProcess : public std::enable_shared_from_this<GameProcess> {
  private:
   static void generateStateHash(StateInfo& stateInfo) ;
   void resetObservers();
+  void groupVectorObservers();
+  void updatePlayerAvatars();
+
+  struct Checkpoint {
+    std::unordered_map<uint32_t, int32_t> accumulatedRewards;
+    bool requiresReset;
+  };
+
+  // The process state at each checkpoint, the grid keeps its own changes
+  std::vector<Checkpoint> checkpoints_;
+
+  // Valid actions of each object, checked again only when the grid changes around the object
+  mutable ValidActionCache validActionCache_;
+
+  // Renders the vector observers of the players and the global observer in one pass over the grid
+  std::shared_ptr<VectorObserverGroup> vectorObserverGroup_;
 
   
 };
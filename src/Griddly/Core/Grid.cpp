@@ -4,31 +4,36 @@
 #include <spdlog/fmt/fmt.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <utility>
 #include <vector>
 
-#include "DelayedActionQueueItem.hpp"
+#include "DelayedActionQueue.hpp"
+#include "GridCollisionDetector.hpp"
 
 namespace griddly {
 
+namespace {
+// Adds the action id to the ids of the object, keeping the order the actions were added in
+void addCollisionActionId(std::vector<std::vector<uint32_t>>& objectActionIds, uint32_t objectNameId, uint32_t actionId) {
+  if (objectNameId >= objectActionIds.size()) {
+    objectActionIds.resize(objectNameId + 1);
+  }
+
+  auto& actionIds = objectActionIds[objectNameId];
+  if (std::find(actionIds.begin(), actionIds.end(), actionId) == actionIds.end()) {
+    actionIds.push_back(actionId);
+  }
+}
+}  // namespace
+
 Grid::Grid() : gameTicks_(std::make_shared<int32_t>(0)) {
-#ifndef NDEBUG
-  spdlog::set_level(spdlog::level::debug);
-#else
-  spdlog::set_level(spdlog::level::info);
-#endif
   collisionDetectorFactory_ = std::make_shared<CollisionDetectorFactory>(CollisionDetectorFactory());
 }
 
 Grid::Grid(std::shared_ptr<CollisionDetectorFactory> collisionDetectorFactory) : gameTicks_(std::make_shared<int32_t>(0)) {
-#ifndef NDEBUG
-  spdlog::set_level(spdlog::level::debug);
-#else
-  spdlog::set_level(spdlog::level::info);
-#endif
-
   collisionDetectorFactory_ = std::move(collisionDetectorFactory);
 }
 
@@ -53,31 +58,76 @@ void Grid::resetMap(uint32_t width, uint32_t height) {
   reset();
 
   globalVariables_["_steps"].insert({0, gameTicks_});
-
-  if (updatedLocations_.empty()) {
-    for (auto p = 0; p < playerCount_ + 1; p++) {
-      updatedLocations_.emplace_back();
-    }
-  }
 }
 
 void Grid::reset() {
-  occupiedLocations_.clear();
+  tiles_.assign(width_ * height_, nullptr);
+
+  // Observers holding a cursor from before the reset will have to redraw everything
+  updatedLocations_.resize(std::max(width_ * height_, 1u));
+  locationUpdateSequence_.assign(width_ * height_, 0);
+  updatedLocationsTail_ = updatedLocationsHead_;
+  updatedLocationsReadCursor_ = updatedLocationsHead_;
+  tileHashes_.assign(width_ * height_, 0);
+  objectsHash_ = 0;
+  stateHashCursor_ = updatedLocationsHead_;
   objects_.clear();
+  nextEntityId_ = 1;
   objectCounters_.clear();
   objectIds_.clear();
   objectVariableIds_.clear();
-  delayedActions_ = {};
+  objectVariableStores_.clear();
+  delayedActions_.clear();
   defaultObject_.clear();
 
-  collisionObjectActionNames_.clear();
-  collisionSourceObjectActionNames_.clear();
+  collisionObjectActionIds_.clear();
+  collisionSourceObjectActionIds_.clear();
   collisionDetectors_.clear();
   collisionSourceObjects_.clear();
+  triggerContacts_.clear();
+
+  journal_.clear();
+  randomGenerator_->clearCheckpoints();
 
   *gameTicks_ = 0;
 }
 
+void Grid::shareImmutableObjects(const Grid& grid) {
+  if (grid.width_ != width_ || grid.height_ != height_) {
+    auto error = fmt::format("Cannot share the objects of a grid of size [{0}, {1}] with a grid of size [{2}, {3}].", grid.width_, grid.height_, width_, height_);
+    spdlog::error(error);
+    throw std::invalid_argument(error);
+  }
+
+  tiles_ = grid.tiles_;
+
+  for (const auto& object : grid.objects_) {
+    const auto& location = object->getLocation();
+    if (!object->isImmutable()) {
+      getMutableTile(getTileIndex(location)).erase(object->getZIdx());
+      continue;
+    }
+
+    object->markAsShared();
+    objects_.insert(object);
+    nextEntityId_ = std::max(nextEntityId_, object->getEntityId() + 1);
+
+    const auto& objectName = object->getObjectName();
+    auto& objectCounter = objectCounters_[objectName][object->getPlayerId()];
+    if (objectCounter == nullptr) {
+      objectCounter = std::make_shared<int32_t>(0);
+    }
+    *objectCounter += 1;
+    invalidateLocation(location);
+
+    if (!collisionDetectors_.empty()) {
+      for (auto actionId : getCollisionActionIds(collisionObjectActionIds_, *object)) {
+        collisionDetectors_[actionId]->upsert(object);
+      }
+    }
+  }
+}
+
 void Grid::setGlobalVariables(std::unordered_map<std::string, std::unordered_map<uint32_t, int32_t>> globalVariableDefinitions) {
   globalVariables_.clear();
   for (const auto& variable : globalVariableDefinitions) {
@@ -87,6 +137,7 @@ void Grid::setGlobalVariables(std::unordered_map<std::string, std::unordered_map
     if (variableName == "_steps") {
       auto variableValue = playerVariables.at(0);
       *gameTicks_ = variableValue;
+      delayedActions_.setCurrentTick(static_cast<uint32_t>(variableValue));
       globalVariables_["_steps"].insert({0, gameTicks_});
     } else {
       for (auto playerVariable : playerVariables) {
@@ -121,14 +172,98 @@ void Grid::resetGlobalVariables(std::unordered_map<std::string, GlobalVariableDe
 }
 
 bool Grid::invalidateLocation(glm::ivec2 location) {
-  for (int p = 0; p < playerCount_ + 1; p++) {
-    updatedLocations_[p].insert(location);
+  if (!isInBounds(location)) {
+    return false;
+  }
+
+  // If this location has already been recorded since the last observer read it, every observer will still see it
+  auto& lastUpdateSequence = locationUpdateSequence_[getTileIndex(location)];
+  if (lastUpdateSequence > updatedLocationsReadCursor_) {
+    return true;
+  }
+
+  const auto capacity = updatedLocations_.size();
+  updatedLocations_[updatedLocationsHead_ % capacity] = location;
+  lastUpdateSequence = ++updatedLocationsHead_;
+
+  if (updatedLocationsHead_ - updatedLocationsTail_ > capacity) {
+    updatedLocationsTail_ = updatedLocationsHead_ - capacity;
   }
+
   return true;
 }
 
-void Grid::purgeUpdatedLocations(uint32_t player) {
-  updatedLocations_[player].clear();
+bool Grid::getUpdatedLocations(uint64_t& cursor, std::vector<glm::ivec2>& updatedLocations) const {
+  updatedLocations.clear();
+
+  const bool available = cursor >= updatedLocationsTail_ && cursor <= updatedLocationsHead_;
+  if (available) {
+    const auto capacity = updatedLocations_.size();
+    for (auto sequence = cursor; sequence < updatedLocationsHead_; sequence++) {
+      updatedLocations.push_back(updatedLocations_[sequence % capacity]);
+    }
+  }
+
+  cursor = updatedLocationsHead_;
+  updatedLocationsReadCursor_ = updatedLocationsHead_;
+  return available;
+}
+
+uint64_t Grid::getStateHash() {
+  if (getUpdatedLocations(stateHashCursor_, stateHashUpdatedLocations_)) {
+    for (const auto& location : stateHashUpdatedLocations_) {
+      auto tileIndex = getTileIndex(location);
+      objectsHash_ ^= tileHashes_[tileIndex];
+      tileHashes_[tileIndex] = hashTile(tileIndex);
+      objectsHash_ ^= tileHashes_[tileIndex];
+    }
+  } else {
+    // Too many updates since the last hash to know which tiles changed
+    objectsHash_ = 0;
+    for (uint32_t tileIndex = 0; tileIndex < tileHashes_.size(); tileIndex++) {
+      tileHashes_[tileIndex] = hashTile(tileIndex);
+      objectsHash_ ^= tileHashes_[tileIndex];
+    }
+  }
+
+  uint64_t globalVariablesHash = 0;
+  for (const auto& globalVariable : globalVariables_) {
+    if (globalVariable.first == "_steps") {
+      continue;
+    }
+
+    auto nameHash = hashStateString(globalVariable.first);
+    for (const auto& playerVariable : globalVariable.second) {
+      auto variableHash = nameHash;
+      combineStateHash(variableHash, playerVariable.first);
+      combineStateHash(variableHash, static_cast<uint32_t>(*playerVariable.second));
+      globalVariablesHash ^= variableHash;
+    }
+  }
+
+  return objectsHash_ ^ mixStateHash(globalVariablesHash);
+}
+
+uint64_t Grid::hashTile(uint32_t tileIndex) const {
+  uint64_t tileHash = 0;
+  for (const auto& objectIt : getTile(tileIndex)) {
+    const auto& object = objectIt.second;
+    auto objectHash = hashStateString(object->getObjectName());
+    combineStateHash(objectHash, tileIndex);
+
+    auto orientation = object->getObjectOrientation().getUnitVector();
+    combineStateHash(objectHash, static_cast<uint32_t>(orientation.x));
+    combineStateHash(objectHash, static_cast<uint32_t>(orientation.y));
+
+    // The local variables include the player id
+    auto localVariableCount = object->getBehaviourTable()->localVariableCount;
+    for (uint32_t slot = 0; slot < localVariableCount; slot++) {
+      combineStateHash(objectHash, static_cast<uint32_t>(*object->getVariableValueAt(slot)));
+    }
+
+    tileHash ^= objectHash;
+  }
+  return tileHash;
 }
 
 bool Grid::updateLocation(std::shared_ptr<Object> object, glm::ivec2 previousLocation, glm::ivec2 newLocation) {
@@ -137,44 +272,38 @@ bool Grid::updateLocation(std::shared_ptr<Object> object, glm::ivec2 previousLoc
   }
 
   auto objectZIdx = object->getZIdx();
-  auto newLocationObjects = occupiedLocations_[newLocation];
+  auto newTileIndex = getTileIndex(newLocation);
+  const auto& newLocationObjects = getTile(newTileIndex);
 
   if (newLocationObjects.find(objectZIdx) != newLocationObjects.end()) {
     spdlog::debug("Cannot move object {0} to location [{1}, {2}] as it is occupied.", object->getObjectName(), newLocation.x, newLocation.y);
     return false;
   }
 
-  occupiedLocations_[previousLocation].erase(objectZIdx);
-  occupiedLocations_[newLocation][objectZIdx] = object;
+  if (isInBounds(previousLocation)) {
+    getMutableTile(getTileIndex(previousLocation)).erase(objectZIdx);
+  }
+  getMutableTile(newTileIndex)[objectZIdx] = object;
+  journal_.recordObjectMoved(object, previousLocation);
 
   invalidateLocation(previousLocation);
   invalidateLocation(newLocation);
 
   // Update spatial hashes if they exists
   if (!collisionDetectors_.empty()) {
-    auto objectName = object->getObjectName();
-
-    auto collisionDetectorActionNamesIt = collisionObjectActionNames_.find(object->getObjectName());
-    if (collisionDetectorActionNamesIt != collisionObjectActionNames_.end()) {
-      auto collisionDetectorActionNames = collisionDetectorActionNamesIt->second;
-      for (const auto& actionName : collisionDetectorActionNames) {
-        auto collisionDetector = collisionDetectors_.at(actionName);
-        spdlog::debug("Updating object {0} location in collision detector for action {1}", objectName, actionName);
-        collisionDetector->upsert(object);
-      }
+    for (auto actionId : getCollisionActionIds(collisionObjectActionIds_, *object)) {
+      spdlog::debug("Updating object {0} location in collision detector for action {1}", object->getObjectName(), collisionActionSymbols_->getName(actionId));
+      collisionDetectors_[actionId]->upsert(object);
+      invalidateCollisionContacts(actionId, previousLocation);
+      invalidateCollisionContacts(actionId, newLocation);
     }
+
+    updateCollisionSource(object, false);
   }
 
   return true;
 }
 
-const std::unordered_set<glm::ivec2>& Grid::getUpdatedLocations(uint32_t playerId) const {
-  if (playerId >= updatedLocations_.size()) {
-    return EMPTY_LOCATIONS;
-  }
-  return updatedLocations_[playerId];
-}
-
 std::unordered_map<uint32_t, int32_t> Grid::executeAndRecord(uint32_t playerId, const std::shared_ptr<Action>& action) {
   if (recordEvents_) {
     auto event = buildGridEvent(action, playerId, *gameTicks_);
@@ -188,16 +317,13 @@ std::unordered_map<uint32_t, int32_t> Grid::executeAndRecord(uint32_t playerId,
 std::unordered_map<uint32_t, int32_t> Grid::executeAction(uint32_t playerId, std::shared_ptr<Action> action) {
   auto sourceObject = action->getSourceObject();
 
-  if (objects_.find(sourceObject) == objects_.end() && action->getDelay() > 0) {
-    spdlog::debug("Delayed action for object that no longer exists.");
-    return {};
-  }
-
   float executionProbability = 1.0;
 
-  auto executionProbabilityIt = actionProbabilities_.find(action->getActionName());
-  if (executionProbabilityIt != actionProbabilities_.end()) {
-    executionProbability = executionProbabilityIt->second;
+  if (!actionProbabilities_.empty()) {
+    auto actionId = action->getActionId(*actionSymbols_);
+    if (actionId < actionProbabilities_.size()) {
+      executionProbability = actionProbabilities_[actionId];
+    }
   }
 
   spdlog::debug("Executing action {0} with probability {1}", action->getDescription(), executionProbability);
@@ -213,13 +339,15 @@ std::unordered_map<uint32_t, int32_t> Grid::executeAction(uint32_t playerId, std
   auto destinationObject = action->getDestinationObject();
 
   // Need to get this name before anything happens to the object for example if the object is removed in onActionDst.
-  auto originalDestinationObjectName = destinationObject->getObjectName();
-  if (originalDestinationObjectName == "_empty") {
+  // The destination object is kept alive by this function, so its name can be referenced rather than copied.
+  static const std::string boundaryObjectName = "_boundary";
+  const auto* originalDestinationObjectName = &destinationObject->getObjectName();
+  if (*originalDestinationObjectName == "_empty") {
     // Check that the destination of the action is not outside the grid
     auto destinationLocation = action->getDestinationLocation();
     if (destinationLocation.x >= width_ || destinationLocation.x < 0 ||
         destinationLocation.y >= height_ || destinationLocation.y < 0) {
-      originalDestinationObjectName = "_boundary";
+      originalDestinationObjectName = &boundaryObjectName;
     }
   }
 
@@ -252,7 +380,7 @@ std::unordered_map<uint32_t, int32_t> Grid::executeAction(uint32_t playerId, std
       }
     }
 
-    auto srcBehaviourResult = sourceObject->onActionSrc(originalDestinationObjectName, action);
+    auto srcBehaviourResult = sourceObject->onActionSrc(*originalDestinationObjectName, action);
     accumulateRewards(rewardAccumulator, srcBehaviourResult.rewards);
     return rewardAccumulator;
   }
@@ -319,9 +447,23 @@ std::unordered_map<uint32_t, int32_t> Grid::performActions(uint32_t playerId, st
 }
 
 void Grid::delayAction(uint32_t playerId, std::shared_ptr<Action> action) {
+  // removeObject cancels the actions an object has already delayed, the ones it delays after it is removed are never queued
+  if (objects_.find(action->getSourceObject()) == objects_.end()) {
+    spdlog::debug("Delayed action for object that no longer exists.");
+    return;
+  }
+
   auto executionTarget = *(gameTicks_) + action->getDelay();
   spdlog::debug("Delaying action={0} to execution target time {1}", action->getDescription(), executionTarget);
-  delayedActions_.push(std::make_shared<DelayedActionQueueItem>(DelayedActionQueueItem{playerId, executionTarget, action}));
+
+  if (journal_.isRecording()) {
+    DelayedActionQueueItem delayedAction(playerId, executionTarget, action);
+    delayedAction.sequence = delayedActions_.push(playerId, executionTarget, std::move(action));
+    journal_.recordDelayedActionPushed(std::move(delayedAction));
+    return;
+  }
+
+  delayedActions_.push(playerId, executionTarget, std::move(action));
 }
 
 std::unordered_map<uint32_t, int32_t> Grid::processDelayedActions() {
@@ -330,16 +472,17 @@ std::unordered_map<uint32_t, int32_t> Grid::processDelayedActions() {
   spdlog::debug("{0} Delayed actions at game tick {1}", delayedActions_.size(), *gameTicks_);
   // Perform any delayed actions
 
-  std::vector<std::shared_ptr<DelayedActionQueueItem>> actionsToExecute;
-  while (!delayedActions_.empty() && delayedActions_.top()->priority <= *(gameTicks_)) {
-    // Get the top element and remove it
-    actionsToExecute.push_back(delayedActions_.top());
-    delayedActions_.pop();
-  }
+  // Actions that are cancelled while the actions of this tick are executed are not taken from the queue
+  delayedActions_.advance(static_cast<uint32_t>(*gameTicks_));
+
+  DelayedActionQueueItem delayedAction;
+  while (delayedActions_.popReady(delayedAction)) {
+    if (journal_.isRecording()) {
+      journal_.recordDelayedActionTaken(delayedAction);
+    }
 
-  for (const auto& delayedAction : actionsToExecute) {
-    auto action = delayedAction->action;
-    auto playerId = delayedAction->playerId;
+    auto action = std::move(delayedAction.action);
+    auto playerId = delayedAction.playerId;
 
     spdlog::debug("Popped delayed action {0} at game tick {1}", action->getDescription(), *gameTicks_);
 
@@ -350,6 +493,34 @@ std::unordered_map<uint32_t, int32_t> Grid::processDelayedActions() {
   return delayedRewards;
 }
 
+void Grid::updateCollisionSource(const std::shared_ptr<Object>& object, bool removed) {
+  for (auto actionId : getCollisionActionIds(collisionSourceObjectActionIds_, *object)) {
+    auto& triggerContacts = triggerContacts_[actionId];
+    if (removed) {
+      triggerContacts.sourceIndex->remove(object);
+      triggerContacts.sourceContacts.erase(object.get());
+    } else {
+      triggerContacts.sourceIndex->upsert(object);
+      triggerContacts.sourceContacts[object.get()].stale = true;
+    }
+  }
+}
+
+void Grid::invalidateCollisionContacts(uint32_t actionId, glm::ivec2 location) {
+  auto& triggerContacts = triggerContacts_[actionId];
+  if (triggerContacts.sourceIndex == nullptr) {
+    return;
+  }
+
+  triggerContacts.sourceIndex->searchInto(location, collisionInvalidationBuffer_);
+  for (const auto& sourceObject : collisionInvalidationBuffer_) {
+    auto contactsIt = triggerContacts.sourceContacts.find(sourceObject.get());
+    if (contactsIt != triggerContacts.sourceContacts.end()) {
+      contactsIt->second.stale = true;
+    }
+  }
+}
+
 std::unordered_map<uint32_t, int32_t> Grid::processCollisions() {
   std::unordered_map<uint32_t, int32_t> collisionRewards;
 
@@ -359,31 +530,31 @@ std::unordered_map<uint32_t, int32_t> Grid::processCollisions() {
 
   // Check for collisions
   for (const auto& object : collisionSourceObjects_) {
-    const auto& objectName = object->getObjectName();
-    auto collisionActionNamesIt = collisionSourceObjectActionNames_.find(objectName);
-    if (collisionActionNamesIt != collisionSourceObjectActionNames_.end()) {
-      const auto& collisionActionNames = collisionSourceObjectActionNames_.at(objectName);
+    const auto& collisionActionIds = getCollisionActionIds(collisionSourceObjectActionIds_, *object);
+    if (!collisionActionIds.empty()) {
+      const auto& objectName = object->getObjectName();
       auto location = object->getLocation();
       auto playerId = object->getPlayerId();
 
-      for (const auto& actionName : collisionActionNames) {
+      for (auto actionId : collisionActionIds) {
+        const auto& actionName = collisionActionSymbols_->getName(actionId);
         spdlog::debug("Collision detector under action {0} for object {1} being queried", actionName, objectName);
-        auto collisionDetector = collisionDetectors_.at(actionName);
-        auto searchResults = collisionDetector->search(location);
-        auto& actionTriggerDefinition = actionTriggerDefinitions_.at(actionName);
+        auto& contacts = triggerContacts_[actionId].sourceContacts[object.get()];
 
-        auto objectsInCollisionRange = searchResults.objectSet;
+        // Only query the collision detector if something has changed near the source object since the last query
+        if (contacts.stale) {
+          collisionDetectors_[actionId]->searchInto(location, contacts.objects);
+          contacts.objects.erase(std::remove(contacts.objects.begin(), contacts.objects.end(), object), contacts.objects.end());
+          contacts.stale = false;
+        }
 
-        for (const auto& collisionObject : objectsInCollisionRange) {
-          if (collisionObject == object) {
-            {
-              continue;
-            }
-          }
+        // Executing the actions can add, move or remove objects, which changes the contacts
+        collisionSearchBuffer_.assign(contacts.objects.begin(), contacts.objects.end());
 
+        for (const auto& collisionObject : collisionSearchBuffer_) {
           spdlog::debug("Collision detected for action {0} {1}->{2}", actionName, collisionObject->getObjectName(), objectName);
 
-          std::shared_ptr<Action> collisionAction = std::make_shared<Action>(Action(shared_from_this(), actionName, playerId, 0));
+          auto collisionAction = createAction(actionName, playerId);
           collisionAction->init(object, collisionObject);
 
           auto rewards = executeAndRecord(0, collisionAction);
@@ -398,6 +569,7 @@ std::unordered_map<uint32_t, int32_t> Grid::processCollisions() {
 }
 
 std::unordered_map<uint32_t, int32_t> Grid::update() {
+  journal_.recordTick(*gameTicks_);
   *(gameTicks_) += 1;
 
   std::unordered_map<uint32_t, int32_t> rewards;
@@ -412,7 +584,7 @@ std::unordered_map<uint32_t, int32_t> Grid::update() {
   return rewards;
 }
 
-DelayedActionQueue Grid::getDelayedActions() {
+const DelayedActionQueue& Grid::getDelayedActions() const {
   return delayedActions_;
 }
 
@@ -420,8 +592,13 @@ std::shared_ptr<int32_t> Grid::getTickCount() const {
   return gameTicks_;
 }
 
+void Grid::clearDelayedActions() {
+  delayedActions_.clear(static_cast<uint32_t>(*gameTicks_));
+}
+
 void Grid::setTickCount(int32_t tickCount) {
   *gameTicks_ = tickCount;
+  delayedActions_.setCurrentTick(static_cast<uint32_t>(tickCount));
 }
 
 const std::unordered_set<std::shared_ptr<Object>>& Grid::getObjects() {
@@ -429,16 +606,25 @@ const std::unordered_set<std::shared_ptr<Object>>& Grid::getObjects() {
 }
 
 const TileObjects& Grid::getObjectsAt(glm::ivec2 location) const {
-  auto i = occupiedLocations_.find(location);
-  if (i == occupiedLocations_.end()) {
+  if (!isInBounds(location)) {
     return EMPTY_OBJECTS;
   }
-  return i->second;
+  return getTile(getTileIndex(location));
+}
+
+TileObjects& Grid::getMutableTile(uint32_t tileIndex) {
+  auto& tile = tiles_[tileIndex];
+  if (tile == nullptr) {
+    tile = std::make_shared<TileObjects>();
+  } else if (tile.use_count() > 1) {
+    tile = std::make_shared<TileObjects>(*tile);
+  }
+  return *tile;
 }
 
 std::shared_ptr<Object> Grid::getObject(glm::ivec2 location) const {
-  if (occupiedLocations_.count(location) > 0) {
-    const auto& objectsAtLocation = occupiedLocations_.at(location);
+  if (isInBounds(location)) {
+    const auto& objectsAtLocation = getTile(getTileIndex(location));
     if (!objectsAtLocation.empty()) {
       // Get the highest index object
       return objectsAtLocation.rbegin()->second;
@@ -489,6 +675,9 @@ const std::unordered_map<std::string, std::vector<std::string>> Grid::getObjectV
 void Grid::initObject(std::string objectName, std::vector<std::string> variableNames) {
   objectIds_.insert({objectName, objectIds_.size()});
 
+  // Every object type has an id, so objects that do not collide also cache theirs
+  collisionObjectSymbols_->intern(objectName);
+
   for (auto& variableName : variableNames) {
     objectVariableIds_.insert({variableName, objectVariableIds_.size()});
   }
@@ -496,6 +685,19 @@ void Grid::initObject(std::string objectName, std::vector<std::string> variableN
   objectVariableMap_[objectName] = variableNames;
 }
 
+std::shared_ptr<ObjectVariableStore> Grid::getObjectVariableStore(const std::string& objectName, const std::vector<std::string>& variableNames) {
+  auto& objectVariableStore = objectVariableStores_[objectName];
+  if (objectVariableStore == nullptr || objectVariableStore->getVariableNames() != variableNames) {
+    spdlog::debug("Creating variable store for object {0} with {1} variables", objectName, variableNames.size());
+    objectVariableStore = std::make_shared<ObjectVariableStore>(variableNames);
+  }
+  return objectVariableStore;
+}
+
+const std::unordered_map<std::string, std::shared_ptr<ObjectVariableStore>>& Grid::getObjectVariableStores() const {
+  return objectVariableStores_;
+}
+
 std::unordered_map<uint32_t, std::shared_ptr<int32_t>> Grid::getObjectCounter(std::string objectName) {
   auto objectCounterIt = objectCounters_.find(objectName);
   if (objectCounterIt == objectCounters_.end()) {
@@ -511,35 +713,79 @@ const std::map<std::string, std::unordered_map<uint32_t, std::shared_ptr<int32_t
 }
 
 void Grid::addActionProbability(std::string actionName, float probability) {
-  actionProbabilities_[actionName] = probability;
+  auto actionId = actionSymbols_->intern(actionName);
+  if (actionId >= actionProbabilities_.size()) {
+    actionProbabilities_.resize(actionId + 1, 1.0);
+  }
+  actionProbabilities_[actionId] = probability;
+}
+
+void Grid::setActionSymbols(std::shared_ptr<SymbolTable> actionSymbols) {
+  // Re-index any probabilities that have already been added
+  std::vector<float> actionProbabilities;
+  for (uint32_t actionId = 0; actionId < actionProbabilities_.size(); actionId++) {
+    auto newActionId = actionSymbols->intern(actionSymbols_->getName(actionId));
+    if (newActionId >= actionProbabilities.size()) {
+      actionProbabilities.resize(newActionId + 1, 1.0);
+    }
+    actionProbabilities[newActionId] = actionProbabilities_[actionId];
+  }
+
+  actionSymbols_ = std::move(actionSymbols);
+  actionProbabilities_ = std::move(actionProbabilities);
+}
+
+const std::shared_ptr<SymbolTable>& Grid::getActionSymbols() const {
+  return actionSymbols_;
+}
+
+std::shared_ptr<Action> Grid::createAction(std::string actionName, uint32_t playerId, uint32_t delay, std::unordered_map<std::string, int32_t> metaData) {
+  return std::allocate_shared<Action>(ActionPoolAllocator<Action>(actionPool_), shared_from_this(), std::move(actionName), playerId, delay, std::move(metaData));
+}
+
+const std::shared_ptr<ActionPool>& Grid::getActionPool() const {
+  return actionPool_;
 }
 
 void Grid::addCollisionDetector(std::vector<std::string> objectNames, std::string actionName, std::shared_ptr<CollisionDetector> collisionDetector) {
+  auto actionId = collisionActionSymbols_->intern(actionName);
   for (const auto& objectName : objectNames) {
-    collisionObjectActionNames_[objectName].insert(actionName);
+    addCollisionActionId(collisionObjectActionIds_, collisionObjectSymbols_->intern(objectName), actionId);
   }
 
-  collisionDetectors_.insert({actionName, collisionDetector});
+  if (actionId >= collisionDetectors_.size()) {
+    collisionDetectors_.resize(actionId + 1);
+    triggerContacts_.resize(actionId + 1);
+  }
+
+  // The first collision detector added for an action is kept
+  if (collisionDetectors_[actionId] == nullptr) {
+    collisionDetectors_[actionId] = std::move(collisionDetector);
+  }
 }
 
 void Grid::addActionTrigger(std::string actionName, ActionTriggerDefinition actionTriggerDefinition) {
   std::shared_ptr<CollisionDetector> collisionDetector = collisionDetectorFactory_->newCollisionDetector(width_, height_, actionTriggerDefinition);
 
+  auto actionId = collisionActionSymbols_->intern(actionName);
+
   std::vector<std::string> objectNames;
   for (const auto& sourceObjectName : actionTriggerDefinition.sourceObjectNames) {
     // TODO: I dont think we need to add source names to all object names?
     // objectNames.push_back(sourceObjectName);
-    collisionSourceObjectActionNames_[sourceObjectName].insert(actionName);
+    addCollisionActionId(collisionSourceObjectActionIds_, collisionObjectSymbols_->intern(sourceObjectName), actionId);
   }
 
   for (const auto& destinationObjectName : actionTriggerDefinition.destinationObjectNames) {
     objectNames.push_back(destinationObjectName);
-    collisionObjectActionNames_[destinationObjectName].insert(actionName);
   }
 
   actionTriggerDefinitions_.insert({actionName, actionTriggerDefinition});
 
   addCollisionDetector(objectNames, actionName, collisionDetector);
+
+  // Both trigger types only find objects within the range box, so the sources affected by a change are found with an area query
+  triggerContacts_[actionId].sourceIndex = std::make_shared<GridCollisionDetector>(width_, height_, actionTriggerDefinition.range, TriggerType::RANGE_BOX_AREA);
 }
 
 void Grid::addPlayerDefaultObject(std::shared_ptr<Object> object) {
@@ -567,12 +813,18 @@ void Grid::addObject(glm::ivec2 location, std::shared_ptr<Object> object, bool a
 
   spdlog::debug("Adding object={0} belonging to player {1} to location: [{2},{3}]", objectName, playerId, location.x, location.y);
 
+  if (!isInBounds(location)) {
+    spdlog::error("Cannot add object={0} to location: [{1},{2}], location is outside the grid.", objectName, location.x, location.y);
+    return;
+  }
+
   auto canAddObject = objects_.insert(object).second;
   if (canAddObject) {
     object->init(location, orientation);
 
     auto objectZIdx = object->getZIdx();
-    auto& objectsAtLocation = occupiedLocations_[location];
+    auto tileIndex = getTileIndex(location);
+    const auto& objectsAtLocation = getTile(tileIndex);
 
     auto objectAtZIt = objectsAtLocation.find(objectZIdx);
 
@@ -590,8 +842,10 @@ void Grid::addObject(glm::ivec2 location, std::shared_ptr<Object> object, bool a
       }
 
       *objectCounters_[objectName][playerId] += 1;
-      objectsAtLocation.insert({objectZIdx, object});
+      getMutableTile(tileIndex).insert({objectZIdx, object});
+      assignEntityId(*object);
       invalidateLocation(location);
+      journal_.recordObjectAdded(object);
     }
 
     if (applyInitialActions) {
@@ -603,19 +857,15 @@ void Grid::addObject(glm::ivec2 location, std::shared_ptr<Object> object, bool a
     }
 
     if (!collisionDetectors_.empty()) {
-      const auto& collisionDetectorActionNamesIt = collisionObjectActionNames_.find(objectName);
-      if (collisionDetectorActionNamesIt != collisionObjectActionNames_.end()) {
-        const auto& collisionDetectorActionNames = collisionObjectActionNames_.at(objectName);
-        for (const auto& actionName : collisionDetectorActionNames) {
-          auto collisionDetector = collisionDetectors_.at(actionName);
-          spdlog::debug("Adding object {0} to collision detector for action {1}", objectName, actionName);
-          collisionDetector->upsert(object);
-        }
+      for (auto actionId : getCollisionActionIds(collisionObjectActionIds_, *object)) {
+        spdlog::debug("Adding object {0} to collision detector for action {1}", objectName, collisionActionSymbols_->getName(actionId));
+        collisionDetectors_[actionId]->upsert(object);
+        invalidateCollisionContacts(actionId, location);
       }
 
-      auto collisionActionNamesIt = collisionSourceObjectActionNames_.find(objectName);
-      if (collisionActionNamesIt != collisionSourceObjectActionNames_.end()) {
+      if (!getCollisionActionIds(collisionSourceObjectActionIds_, *object).empty()) {
         collisionSourceObjects_.insert(object);
+        updateCollisionSource(object, false);
       }
     }
 
@@ -632,6 +882,121 @@ std::shared_ptr<RandomGenerator> Grid::getRandomGenerator() const {
   return randomGenerator_;
 }
 
+uint32_t Grid::getNextEntityId() const {
+  return nextEntityId_;
+}
+
+void Grid::setNextEntityId(uint32_t nextEntityId) {
+  nextEntityId_ = nextEntityId;
+}
+
+void Grid::assignEntityId(Object& object) {
+  auto entityId = object.getEntityId();
+  if (entityId == 0) {
+    object.setEntityId(nextEntityId_++);
+  } else {
+    // Objects cloned from another grid keep their ids
+    nextEntityId_ = std::max(nextEntityId_, entityId + 1);
+  }
+}
+
+void Grid::pushCheckpoint() {
+  journal_.pushCheckpoint(eventHistory_.size(), nextEntityId_);
+  randomGenerator_->pushCheckpoint();
+}
+
+void Grid::rollback() {
+  auto checkpoint = journal_.popCheckpoint(rollbackChanges_);
+  randomGenerator_->rollback();
+
+  // The delayed actions at the checkpoint are the ones pending now and the ones taken since, without the ones delayed since
+  std::unordered_set<uint64_t> delayedSinceCheckpoint;
+  for (const auto& change : rollbackChanges_) {
+    if (change.type == GridChangeType::DELAYED_ACTION_PUSHED) {
+      delayedSinceCheckpoint.insert(change.delayedAction.sequence);
+    }
+  }
+
+  auto delayedActions = delayedActions_.getPendingActions();
+  delayedActions.erase(std::remove_if(delayedActions.begin(), delayedActions.end(), [&delayedSinceCheckpoint](const DelayedActionQueueItem& delayedAction) {
+                         return delayedSinceCheckpoint.find(delayedAction.sequence) != delayedSinceCheckpoint.end();
+                       }),
+                       delayedActions.end());
+
+  for (auto& change : rollbackChanges_) {
+    if (change.type == GridChangeType::DELAYED_ACTION_TAKEN && delayedSinceCheckpoint.find(change.delayedAction.sequence) == delayedSinceCheckpoint.end()) {
+      delayedActions.push_back(std::move(change.delayedAction));
+    }
+  }
+
+  // Undoing the changes goes through the same functions that made them, which must not record them again for earlier checkpoints
+  journal_.setSuspended(true);
+  for (auto changeIt = rollbackChanges_.rbegin(); changeIt != rollbackChanges_.rend(); ++changeIt) {
+    auto& change = *changeIt;
+    switch (change.type) {
+      case GridChangeType::VARIABLE:
+        *change.variable = change.previousValue;
+        invalidateLocation(change.location);
+        break;
+      case GridChangeType::TICK:
+        *gameTicks_ = change.previousValue;
+        break;
+      case GridChangeType::OBJECT_ADDED:
+        removeObject(change.object);
+        break;
+      case GridChangeType::OBJECT_REMOVED:
+        addObject(change.location, change.object, false, nullptr, change.orientation);
+        break;
+      case GridChangeType::OBJECT_MOVED: {
+        auto location = change.object->getLocation();
+        change.object->init(change.location, change.object->getObjectOrientation());
+        updateLocation(change.object, location, change.location);
+      } break;
+      case GridChangeType::OBJECT_APPEARANCE:
+        change.object->init(change.object->getLocation(), change.orientation);
+        change.object->setRenderTileId(change.renderTileId);
+        invalidateLocation(change.object->getLocation());
+        break;
+      case GridChangeType::DELAYED_ACTION_PUSHED:
+      case GridChangeType::DELAYED_ACTION_TAKEN:
+        break;
+    }
+  }
+  journal_.setSuspended(false);
+  rollbackChanges_.clear();
+
+  delayedActions_.restore(std::move(delayedActions), static_cast<uint32_t>(*gameTicks_));
+
+  if (eventHistory_.size() > checkpoint.historySize) {
+    eventHistory_.erase(eventHistory_.begin() + checkpoint.historySize, eventHistory_.end());
+  }
+
+  // Objects added after the rollback get the same ids as the ones that were undone
+  nextEntityId_ = checkpoint.nextEntityId;
+}
+
+void Grid::discardCheckpoint() {
+  journal_.discardCheckpoint();
+  randomGenerator_->discardCheckpoint();
+}
+
+void Grid::clearCheckpoints() {
+  journal_.clear();
+  randomGenerator_->clearCheckpoints();
+}
+
+size_t Grid::getCheckpointCount() const {
+  return journal_.getCheckpointCount();
+}
+
+void Grid::recordVariableChange(std::shared_ptr<int32_t> variable, glm::ivec2 location) {
+  journal_.recordVariable(std::move(variable), location);
+}
+
+void Grid::recordObjectChange(const std::shared_ptr<Object>& object) {
+  journal_.recordObjectAppearance(object, object->getObjectOrientation(), object->getRenderTileId());
+}
+
 bool Grid::removeObject(std::shared_ptr<Object> object) {
   auto objectName = object->getObjectName();
   auto playerId = object->getPlayerId();
@@ -639,10 +1004,24 @@ bool Grid::removeObject(std::shared_ptr<Object> object) {
   auto objectZIdx = object->getZIdx();
   spdlog::debug("Removing object={0} with playerId={1} from environment.", object->getDescription(), playerId);
 
-  if (objects_.erase(object) > 0 && occupiedLocations_[location].erase(objectZIdx) > 0) {
+  if (objects_.erase(object) > 0 && isInBounds(location) && getMutableTile(getTileIndex(location)).erase(objectZIdx) > 0) {
     *objectCounters_[objectName][playerId] -= 1;
     invalidateLocation(location);
 
+    // Actions this object delayed are never executed
+    if (journal_.isRecording()) {
+      journal_.recordObjectRemoved(object, location, object->getObjectOrientation());
+
+      cancelledActions_.clear();
+      delayedActions_.cancel(object, &cancelledActions_);
+      for (auto& cancelledAction : cancelledActions_) {
+        journal_.recordDelayedActionTaken(std::move(cancelledAction));
+      }
+      cancelledActions_.clear();
+    } else {
+      delayedActions_.cancel(object);
+    }
+
     // if we are removing a player's avatar
     if (!playerAvatars_.empty() && playerId != 0) {
       auto playerAvatarIt = playerAvatars_.find(playerId);
@@ -653,15 +1032,12 @@ bool Grid::removeObject(std::shared_ptr<Object> object) {
     }
 
     if (!collisionDetectors_.empty()) {
-      auto collisionDetectorActionNamesIt = collisionObjectActionNames_.find(objectName);
-      if (collisionDetectorActionNamesIt != collisionObjectActionNames_.end()) {
-        auto collisionDetectorActionNames = collisionDetectorActionNamesIt->second;
-        for (const auto& actionName : collisionDetectorActionNames) {
-          auto collisionDetector = collisionDetectors_.at(actionName);
-          collisionDetector->remove(object);
-        }
+      for (auto actionId : getCollisionActionIds(collisionObjectActionIds_, *object)) {
+        collisionDetectors_[actionId]->remove(object);
+        invalidateCollisionContacts(actionId, location);
       }
 
+      updateCollisionSource(object, true);
       collisionSourceObjects_.erase(object);
     }
 
@@ -692,20 +1068,41 @@ void Grid::purgeHistory() {
   eventHistory_.clear();
 }
 
-const std::unordered_map<std::string, std::shared_ptr<CollisionDetector>>& Grid::getCollisionDetectors() const {
-  return collisionDetectors_;
+std::unordered_map<std::string, std::shared_ptr<CollisionDetector>> Grid::getCollisionDetectors() const {
+  std::unordered_map<std::string, std::shared_ptr<CollisionDetector>> collisionDetectors;
+  for (uint32_t actionId = 0; actionId < collisionDetectors_.size(); actionId++) {
+    if (collisionDetectors_[actionId] != nullptr) {
+      collisionDetectors.insert({collisionActionSymbols_->getName(actionId), collisionDetectors_[actionId]});
+    }
+  }
+  return collisionDetectors;
+}
+
+bool Grid::hasCollisionDetector(const std::string& actionName) const {
+  auto actionId = collisionActionSymbols_->getId(actionName);
+  return actionId < collisionDetectors_.size() && collisionDetectors_[actionId] != nullptr;
 }
 
 const std::unordered_map<std::string, ActionTriggerDefinition>& Grid::getActionTriggerDefinitions() const {
   return actionTriggerDefinitions_;
 }
 
-const std::unordered_map<std::string, std::unordered_set<std::string>>& Grid::getSourceObjectCollisionActionNames() const {
-  return collisionSourceObjectActionNames_;
+std::unordered_map<std::string, std::unordered_set<std::string>> Grid::getCollisionActionNames(const std::vector<std::vector<uint32_t>>& objectActionIds) const {
+  std::unordered_map<std::string, std::unordered_set<std::string>> collisionActionNames;
+  for (uint32_t objectNameId = 0; objectNameId < objectActionIds.size(); objectNameId++) {
+    for (auto actionId : objectActionIds[objectNameId]) {
+      collisionActionNames[collisionObjectSymbols_->getName(objectNameId)].insert(collisionActionSymbols_->getName(actionId));
+    }
+  }
+  return collisionActionNames;
+}
+
+std::unordered_map<std::string, std::unordered_set<std::string>> Grid::getSourceObjectCollisionActionNames() const {
+  return getCollisionActionNames(collisionSourceObjectActionIds_);
 }
 
-const std::unordered_map<std::string, std::unordered_set<std::string>>& Grid::getObjectCollisionActionNames() const {
-  return collisionObjectActionNames_;
+std::unordered_map<std::string, std::unordered_set<std::string>> Grid::getObjectCollisionActionNames() const {
+  return getCollisionActionNames(collisionObjectActionIds_);
 }
 
 }  // namespace griddly
\ No newline at end of file
@@ -9,12 +9,15 @@
 #include <vector>
 
 #include "CollisionDetectorFactory.hpp"
-#include "DelayedActionQueueItem.hpp"
+#include "DelayedActionQueue.hpp"
+#include "GridJournal.hpp"
+#include "GDY/Actions/ActionPool.hpp"
 #include "GDY/Actions/Action.hpp"
 #include "GDY/Objects/Object.hpp"
 #include "LevelGenerators/LevelGenerator.hpp"
 #include "Util/util.hpp"
 #include "Util/RandomGenerator.hpp"
+#include "Util/StateHash.hpp"
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/glm.hpp>
@@ -37,6 +40,18 @@ struct ActionTriggerDefinition {
   uint32_t range = 1;
 };
 
+// The objects in range of a trigger's source object, kept until something moves in the neighbourhood of the source
+struct CollisionContacts {
+  std::vector<std::shared_ptr<Object>> objects;
+  bool stale = true;
+};
+
+struct TriggerContacts {
+  // Index of the trigger's source objects, used to find the sources near an object that was added, moved or removed
+  std::shared_ptr<CollisionDetector> sourceIndex;
+  std::unordered_map<const Object*, CollisionContacts> sourceContacts;
+};
+
 // Structure to hold information about the events that have happened at each time step
 struct GridEvent {
   uint32_t playerId;
@@ -83,15 +98,35 @@ class Grid : public std::enable_shared_from_this<Grid> {
   virtual void addActionTrigger(std::string actionName, ActionTriggerDefinition actionTriggerDefinition);
   virtual void addActionProbability(std::string actionName, float probability);
 
-  virtual DelayedActionQueue getDelayedActions();
+  // Creates an action in this grid. Actions are allocated from a pool owned by the grid and their memory is reused
+  // once they are no longer referenced, including actions that were delayed.
+  std::shared_ptr<Action> createAction(std::string actionName, uint32_t playerId, uint32_t delay = 0, std::unordered_map<std::string, int32_t> metaData = {});
+  const std::shared_ptr<ActionPool>& getActionPool() const;
+
+  // Action ids used by the grid, shared with the object generator so actions only need to resolve their id once
+  virtual void setActionSymbols(std::shared_ptr<SymbolTable> actionSymbols);
+  virtual const std::shared_ptr<SymbolTable>& getActionSymbols() const;
+
+  virtual const DelayedActionQueue& getDelayedActions() const;
+  virtual void clearDelayedActions();
 
   virtual bool updateLocation(std::shared_ptr<Object> object, glm::ivec2 previousLocation, glm::ivec2 newLocation);
 
   // Mark a particular location to be repainted
   virtual bool invalidateLocation(glm::ivec2 location);
 
-  virtual const std::unordered_set<glm::ivec2>& getUpdatedLocations(uint32_t player) const;
-  virtual void purgeUpdatedLocations(uint32_t player);
+  /**
+   * Copies the locations that have been invalidated since the cursor into updatedLocations and moves the cursor to the latest update.
+   * Returns false if the updates since the cursor are no longer available, in which case every location should be treated as updated.
+   */
+  virtual bool getUpdatedLocations(uint64_t& cursor, std::vector<glm::ivec2>& updatedLocations) const;
+
+  /**
+   * Hash of the objects and global variables in the grid, without the step count. Equal states have equal hashes in any process.
+   * Each object is hashed from its name, location, orientation and local variables and the object hashes are combined with xor,
+   * so only the tiles invalidated since the last call are hashed again.
+   */
+  virtual uint64_t getStateHash();
 
   virtual uint32_t getWidth() const;
   virtual uint32_t getHeight() const;
@@ -130,6 +165,16 @@ class Grid : public std::enable_shared_from_this<Grid> {
    */
   virtual const std::unordered_map<std::string, uint32_t>& getObjectVariableIds() const;
 
+  /**
+   * Gets the columnar store holding the local variables of every object of a type, creating it if it does not exist or has a different layout
+   */
+  virtual std::shared_ptr<ObjectVariableStore> getObjectVariableStore(const std::string& objectName, const std::vector<std::string>& variableNames);
+
+  /**
+   * Get the variable stores of all the object types in this grid
+   */
+  virtual const std::unordered_map<std::string, std::shared_ptr<ObjectVariableStore>>& getObjectVariableStores() const;
+
   /**
    * Gets an ordered list of objectVariableNames
    */
@@ -159,17 +204,61 @@ class Grid : public std::enable_shared_from_this<Grid> {
   virtual void purgeHistory();
 
   // These are public so they can be tested
-  virtual const std::unordered_map<std::string, std::shared_ptr<CollisionDetector>>& getCollisionDetectors() const;
+  virtual std::unordered_map<std::string, std::shared_ptr<CollisionDetector>> getCollisionDetectors() const;
   virtual const std::unordered_map<std::string, ActionTriggerDefinition>& getActionTriggerDefinitions() const;
-  virtual const std::unordered_map<std::string, std::unordered_set<std::string>>& getSourceObjectCollisionActionNames() const;
-  virtual const std::unordered_map<std::string, std::unordered_set<std::string>>& getObjectCollisionActionNames() const;
+  virtual std::unordered_map<std::string, std::unordered_set<std::string>> getSourceObjectCollisionActionNames() const;
+  virtual std::unordered_map<std::string, std::unordered_set<std::string>> getObjectCollisionActionNames() const;
+
+  virtual bool hasCollisionDetector(const std::string& actionName) const;
 
   virtual void addCollisionDetector(std::vector<std::string> objectNames, std::string actionName, std::shared_ptr<CollisionDetector> collisionDetector);
 
   virtual void reset();
 
+  /**
+   * Shares the tiles of another grid with the same dimensions, and the objects on them that can never change (see Object::isImmutable).
+   * The other objects are removed from this grid's copy of their tile and should be cloned into this grid with addObject.
+   * Either grid copies a tile the first time it writes to it, so the memory of this grid grows with how far it diverges from the other.
+   */
+  virtual void shareImmutableObjects(const Grid& grid);
+
+  /**
+   * Objects are given the next entity id when they are first added to the grid, counting up from 1, and keep it for as long as they exist.
+   * Ids are assigned in the order objects are added, so a level played with the same actions gets the same ids. Clones copy the ids
+   * of their objects and the next id, so the same entity has the same id in both.
+   */
+  virtual uint32_t getNextEntityId() const;
+  virtual void setNextEntityId(uint32_t nextEntityId);
+
   virtual void seedRandomGenerator(uint32_t seed);
 
+  /**
+   * Starts recording the changes made to the grid so they can be undone with rollback. Checkpoints can be nested.
+   * Objects, variables, the tick count, delayed actions, the event history and the random generator are restored.
+   */
+  virtual void pushCheckpoint();
+
+  /**
+   * Undoes every change since the latest checkpoint and removes the checkpoint
+   */
+  virtual void rollback();
+
+  /**
+   * Removes the latest checkpoint and keeps the changes made since it
+   */
+  virtual void discardCheckpoint();
+
+  virtual void clearCheckpoints();
+  virtual size_t getCheckpointCount() const;
+
+  inline bool isRecordingChanges() const {
+    return journal_.isRecording();
+  }
+
+  // Called by objects before they modify a variable or their appearance, so the change can be rolled back
+  virtual void recordVariableChange(std::shared_ptr<int32_t> variable, glm::ivec2 location);
+  virtual void recordObjectChange(const std::shared_ptr<Object>& object);
+
   virtual std::shared_ptr<RandomGenerator> getRandomGenerator() const;
 
  private:
@@ -180,31 +269,91 @@ class Grid : public std::enable_shared_from_this<Grid> {
 
   std::unordered_map<uint32_t, int32_t> executeAndRecord(uint32_t playerId, const std::shared_ptr<Action>& action);
 
+  // Keep the trigger contacts up to date with objects that are added, moved or removed
+  void updateCollisionSource(const std::shared_ptr<Object>& object, bool removed);
+  void invalidateCollisionContacts(uint32_t actionId, glm::ivec2 location);
+
+  // The ids of the collision actions of the object in objectActionIds, which is indexed by object name id
+  inline const std::vector<uint32_t>& getCollisionActionIds(const std::vector<std::vector<uint32_t>>& objectActionIds, const Object& object) const {
+    auto objectNameId = object.getObjectNameId(collisionObjectSymbols_);
+    return objectNameId < objectActionIds.size() ? objectActionIds[objectNameId] : EMPTY_COLLISION_ACTION_IDS;
+  }
+
+  std::unordered_map<std::string, std::unordered_set<std::string>> getCollisionActionNames(const std::vector<std::vector<uint32_t>>& objectActionIds) const;
+
+  inline bool isInBounds(const glm::ivec2& location) const {
+    return location.x >= 0 && location.x < static_cast<int32_t>(width_) && location.y >= 0 && location.y < static_cast<int32_t>(height_);
+  }
+
+  inline uint32_t getTileIndex(const glm::ivec2& location) const {
+    return location.y * width_ + location.x;
+  }
+
+  inline const TileObjects& getTile(uint32_t tileIndex) const {
+    const auto& tile = tiles_[tileIndex];
+    return tile == nullptr ? EMPTY_OBJECTS : *tile;
+  }
+
+  // Copies the tile first if it is shared with a forked grid
+  TileObjects& getMutableTile(uint32_t tileIndex);
+
+  uint64_t hashTile(uint32_t tileIndex) const;
+
+  // Gives the object the next entity id if it does not have one yet
+  void assignEntityId(Object& object);
+
   uint32_t height_{};
   uint32_t width_{};
 
   const std::shared_ptr<int32_t> gameTicks_;
 
-  // For every game tick record a list of locations that should be updated.
-  // This is so we can highly optimize observers to only re-render changed grid locations
-  std::vector<std::unordered_set<glm::ivec2>> updatedLocations_;
+  // A ring buffer of the locations that have been invalidated, shared by all observers.
+  // Each observer keeps its own cursor into the sequence of updates so it only re-renders changed grid locations
+  std::vector<glm::ivec2> updatedLocations_;
+
+  // Sequence numbers of the next invalidated location and of the oldest one still held in updatedLocations_
+  uint64_t updatedLocationsHead_ = 0;
+  uint64_t updatedLocationsTail_ = 0;
+
+  // The latest cursor handed to an observer, a location that has been invalidated at or after this point does not need to be recorded again
+  mutable uint64_t updatedLocationsReadCursor_ = 0;
+
+  // For each tile, the sequence number + 1 of the last time it was recorded in updatedLocations_ (0 if never)
+  std::vector<uint64_t> locationUpdateSequence_;
+
+  // The hash of the objects in each tile and the xor of all of them, up to date with the locations invalidated before stateHashCursor_
+  std::vector<uint64_t> tileHashes_;
+  uint64_t objectsHash_ = 0;
+  uint64_t stateHashCursor_ = 0;
+  std::vector<glm::ivec2> stateHashUpdatedLocations_;
 
   std::unordered_map<std::string, uint32_t> objectIds_;
   std::unordered_map<std::string, uint32_t> objectVariableIds_;
   std::unordered_map<std::string, std::vector<std::string>> objectVariableMap_;
+  std::unordered_map<std::string, std::shared_ptr<ObjectVariableStore>> objectVariableStores_;
   std::unordered_set<std::shared_ptr<Object>> objects_;
-  std::unordered_map<glm::ivec2, TileObjects> occupiedLocations_;
+  uint32_t nextEntityId_ = 1;
+
+  // The objects in each tile of the grid, stored densely in row-major order (see getTileIndex).
+  // Tiles are allocated when an object is first added to them and can be shared with forked grids (see shareImmutableObjects)
+  std::vector<std::shared_ptr<TileObjects>> tiles_;
+
   std::unordered_map<std::string, std::unordered_map<uint32_t, std::shared_ptr<int32_t>>> objectCounters_;
   std::unordered_map<uint32_t, std::shared_ptr<Object>> playerAvatars_;
   std::map<std::string, std::unordered_map<uint32_t, std::shared_ptr<int32_t>>> globalVariables_;
 
   // return reference to this if there are no object in getObjectAt
   const std::map<uint32_t, std::shared_ptr<Object>> EMPTY_OBJECTS = {};
-  const std::unordered_set<glm::ivec2> EMPTY_LOCATIONS = {};
 
-  // A priority queue of actions that are delayed in time (time is measured in game ticks)
+  // Actions that are delayed in time (time is measured in game ticks)
   DelayedActionQueue delayedActions_;
-  std::unordered_map<std::string, float> actionProbabilities_;
+
+  std::shared_ptr<SymbolTable> actionSymbols_ = std::make_shared<SymbolTable>();
+
+  std::shared_ptr<ActionPool> actionPool_ = std::make_shared<ActionPool>();
+
+  // Execution probability of each action id, actions without a probability are always executed
+  std::vector<float> actionProbabilities_;
 
   // There is at least 1 player
   uint32_t playerCount_ = 1;
@@ -214,18 +363,33 @@ class Grid : public std::enable_shared_from_this<Grid> {
 
   // If there are collisions that need to be processed in this game environment
 
-  // All objects that can collide
-  std::unordered_map<std::string, std::unordered_set<std::string>> collisionObjectActionNames_;
+  // The names of the collision actions and of the objects that collide are interned, so moving an object looks its collisions up by id.
+  // The tables are not cleared on reset, so the ids that objects have cached stay valid
+  std::shared_ptr<SymbolTable> collisionActionSymbols_ = std::make_shared<SymbolTable>();
+  std::shared_ptr<SymbolTable> collisionObjectSymbols_ = std::make_shared<SymbolTable>();
+
+  // All objects that can collide, object name id -> collision action ids
+  std::vector<std::vector<uint32_t>> collisionObjectActionIds_;
+
+  // Only the source objects that can collide, object name id -> collision action ids
+  std::vector<std::vector<uint32_t>> collisionSourceObjectActionIds_;
 
-  // Only the source objects that can collide
-  std::unordered_map<std::string, std::unordered_set<std::string>> collisionSourceObjectActionNames_;
+  const std::vector<uint32_t> EMPTY_COLLISION_ACTION_IDS = {};
 
   // keep a list of the objects that are named as collision sources, this makes collision processing significantly faster with large maps with many non-colliding objects
   std::unordered_set<std::shared_ptr<Object>> collisionSourceObjects_;
 
-  // Collision detectors are grouped by action name (i.e each trigger)
+  // Collision detectors are grouped by action id (i.e each trigger), ids without a collision detector hold nullptr
   std::shared_ptr<CollisionDetectorFactory> collisionDetectorFactory_;
-  std::unordered_map<std::string, std::shared_ptr<CollisionDetector>> collisionDetectors_;
+  std::vector<std::shared_ptr<CollisionDetector>> collisionDetectors_;
+
+  // Contacts of the source objects of each trigger by action id, only sources with stale contacts query the collision detector.
+  // Collision detectors that are not added by a trigger have no source index
+  std::vector<TriggerContacts> triggerContacts_;
+
+  // Reused between collision detector queries
+  std::vector<std::shared_ptr<Object>> collisionSearchBuffer_;
+  std::vector<std::shared_ptr<Object>> collisionInvalidationBuffer_;
   std::unordered_map<std::string, ActionTriggerDefinition> actionTriggerDefinitions_;
 
   // An object that is used if the source of destination location of an action is '_empty'
@@ -234,6 +398,11 @@ class Grid : public std::enable_shared_from_this<Grid> {
 
   std::shared_ptr<RandomGenerator> randomGenerator_ = std::make_shared<RandomGenerator>(RandomGenerator());
 
+  // Changes made since the checkpoints, only recorded while there is a checkpoint
+  GridJournal journal_;
+  std::vector<GridChange> rollbackChanges_;
+  std::vector<DelayedActionQueueItem> cancelledActions_;
+
 };
 
 }  // namespace griddly
\ No newline at end of file
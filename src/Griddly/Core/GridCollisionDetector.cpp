@@ -0,0 +1,261 @@
+#include "GridCollisionDetector.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace griddly {
+
+namespace {
+
+inline uint32_t lowestSetBit(uint64_t bits) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward64(&index, bits);
+  return static_cast<uint32_t>(index);
+#else
+  return static_cast<uint32_t>(__builtin_ctzll(bits));
+#endif
+}
+
+}  // namespace
+
+GridCollisionDetector::GridCollisionDetector(uint32_t gridWidth, uint32_t gridHeight, uint32_t range, TriggerType triggerType)
+    : CollisionDetector(gridWidth, gridHeight, range),
+      triggerType_(triggerType),
+      wordsPerRow_((gridWidth + 63) / 64),
+      occupiedCells_(wordsPerRow_ * gridHeight, 0),
+      rowCounts_(gridHeight, 0),
+      cellHeads_(gridWidth * gridHeight, NO_NODE) {
+}
+
+template <class Visitor>
+void GridCollisionDetector::forEachInRange(glm::ivec2 location, Visitor&& visitor) const {
+  auto range = static_cast<int32_t>(range_);
+
+  auto bottom = std::max(0, location.y - range);
+  auto top = std::min(static_cast<int32_t>(gridHeight_) - 1, location.y + range);
+  auto left = std::max(0, location.x - range);
+  auto right = std::min(static_cast<int32_t>(gridWidth_) - 1, location.x + range);
+
+  if (triggerType_ == TriggerType::NONE) {
+    throw std::invalid_argument("Misconfigured collision detector!, specify 'RANGE_BOX_BOUNDARY' or 'RANGE_BOX_AREA' in configuration");
+  }
+
+  if (bottom > top || left > right) {
+    return;
+  }
+
+  switch (triggerType_) {
+    case TriggerType::RANGE_BOX_AREA: {
+      for (auto y = bottom; y <= top; y++) {
+        visitRow(y, left, right, visitor);
+      }
+    } break;
+    case TriggerType::RANGE_BOX_BOUNDARY: {
+      auto boundaryBottom = location.y - range;
+      auto boundaryTop = location.y + range;
+      auto boundaryLeft = location.x - range;
+      auto boundaryRight = location.x + range;
+
+      if (boundaryBottom == bottom) {
+        visitRow(boundaryBottom, left, right, visitor);
+      }
+
+      if (range > 0 && boundaryTop == top) {
+        visitRow(boundaryTop, left, right, visitor);
+      }
+
+      for (auto y = std::max(bottom, boundaryBottom + 1); y <= std::min(top, boundaryTop - 1); y++) {
+        if (boundaryLeft == left) {
+          visitCell(boundaryLeft, y, visitor);
+        }
+
+        if (range > 0 && boundaryRight == right) {
+          visitCell(boundaryRight, y, visitor);
+        }
+      }
+    } break;
+    case TriggerType::NONE:
+      break;
+  }
+}
+
+template <class Visitor>
+void GridCollisionDetector::visitRow(int32_t y, int32_t left, int32_t right, Visitor&& visitor) const {
+  if (rowCounts_[y] == 0) {
+    return;
+  }
+
+  const auto* rowWords = occupiedCells_.data() + y * wordsPerRow_;
+  auto firstWord = static_cast<uint32_t>(left) / 64;
+  auto lastWord = static_cast<uint32_t>(right) / 64;
+
+  for (auto word = firstWord; word <= lastWord; word++) {
+    auto bits = rowWords[word];
+
+    if (word == firstWord) {
+      bits &= ~uint64_t(0) << (left % 64);
+    }
+
+    if (word == lastWord && right % 64 != 63) {
+      bits &= (uint64_t(1) << (right % 64 + 1)) - 1;
+    }
+
+    while (bits != 0) {
+      auto x = static_cast<int32_t>(word * 64 + lowestSetBit(bits));
+      bits &= bits - 1;
+
+      for (auto nodeId = cellHeads_[y * gridWidth_ + x]; nodeId != NO_NODE; nodeId = nodes_[nodeId].next) {
+        visitor(nodes_[nodeId].object, glm::ivec2(x, y));
+      }
+    }
+  }
+}
+
+template <class Visitor>
+void GridCollisionDetector::visitCell(int32_t x, int32_t y, Visitor&& visitor) const {
+  if (rowCounts_[y] == 0) {
+    return;
+  }
+
+  for (auto nodeId = cellHeads_[y * gridWidth_ + x]; nodeId != NO_NODE; nodeId = nodes_[nodeId].next) {
+    visitor(nodes_[nodeId].object, glm::ivec2(x, y));
+  }
+}
+
+bool GridCollisionDetector::upsert(std::shared_ptr<Object> object) {
+  auto location = object->getLocation();
+  auto isInGrid = location.x >= 0 && location.y >= 0 && location.x < static_cast<int32_t>(gridWidth_) && location.y < static_cast<int32_t>(gridHeight_);
+  auto cell = location.y * gridWidth_ + location.x;
+
+  auto objectNodeIt = objectNodes_.find(object.get());
+  if (objectNodeIt != objectNodes_.end()) {
+    auto nodeId = objectNodeIt->second;
+    if (isInGrid && nodes_[nodeId].cell == cell) {
+      return false;
+    }
+
+    eraseNode(nodeId);
+    objectNodes_.erase(objectNodeIt);
+
+    if (isInGrid) {
+      insertNode(object, cell);
+    }
+    return false;
+  }
+
+  if (!isInGrid) {
+    spdlog::debug("object at location [{0},{1}] is outside of the grid and cannot be indexed.", location.x, location.y);
+    return true;
+  }
+
+  insertNode(object, cell);
+  return true;
+}
+
+bool GridCollisionDetector::remove(std::shared_ptr<Object> object) {
+  auto objectNodeIt = objectNodes_.find(object.get());
+  if (objectNodeIt == objectNodes_.end()) {
+    return false;
+  }
+
+  eraseNode(objectNodeIt->second);
+  objectNodes_.erase(objectNodeIt);
+  return true;
+}
+
+SearchResult GridCollisionDetector::search(glm::ivec2 location) {
+  SearchResult searchResult;
+
+  forEachInRange(location, [this, &location, &searchResult](const std::shared_ptr<Object>& object, glm::ivec2 collisionLocation) {
+    searchResult.objectSet.insert(object);
+
+    // Boundary triggers only report the objects on the top and bottom edges as closest objects
+    if (triggerType_ == TriggerType::RANGE_BOX_AREA || std::abs(location.x - collisionLocation.x) != static_cast<int32_t>(range_)) {
+      searchResult.closestObjects.push_back(object);
+    }
+  });
+
+  // Area triggers report the closest objects nearest first by Chebyshev distance, ties are kept in row order from the lowest row, then left to right
+  if (triggerType_ == TriggerType::RANGE_BOX_AREA) {
+    std::stable_sort(searchResult.closestObjects.begin(), searchResult.closestObjects.end(), [&location](const std::shared_ptr<Object>& a, const std::shared_ptr<Object>& b) {
+      auto aDistance = glm::abs(a->getLocation() - location);
+      auto bDistance = glm::abs(b->getLocation() - location);
+      return std::max(aDistance.x, aDistance.y) < std::max(bDistance.x, bDistance.y);
+    });
+  }
+
+  return searchResult;
+}
+
+void GridCollisionDetector::searchInto(glm::ivec2 location, std::vector<std::shared_ptr<Object>>& collidedObjects) {
+  collidedObjects.clear();
+  forEachInRange(location, [&collidedObjects](const std::shared_ptr<Object>& object, glm::ivec2 /*collisionLocation*/) {
+    collidedObjects.push_back(object);
+  });
+}
+
+void GridCollisionDetector::insertNode(const std::shared_ptr<Object>& object, uint32_t cell) {
+  uint32_t nodeId;
+  if (!freeNodes_.empty()) {
+    nodeId = freeNodes_.back();
+    freeNodes_.pop_back();
+  } else {
+    nodeId = static_cast<uint32_t>(nodes_.size());
+    nodes_.emplace_back();
+  }
+
+  auto& node = nodes_[nodeId];
+  node.object = object;
+  node.cell = cell;
+  node.previous = NO_NODE;
+  node.next = cellHeads_[cell];
+
+  if (node.next != NO_NODE) {
+    nodes_[node.next].previous = nodeId;
+  }
+  cellHeads_[cell] = nodeId;
+
+  auto x = cell % gridWidth_;
+  auto y = cell / gridWidth_;
+  occupiedCells_[y * wordsPerRow_ + x / 64] |= uint64_t(1) << (x % 64);
+  rowCounts_[y]++;
+
+  objectNodes_[object.get()] = nodeId;
+
+  spdlog::debug("object at location [{0},{1}] added to collision index.", x, y);
+}
+
+void GridCollisionDetector::eraseNode(uint32_t nodeId) {
+  auto& node = nodes_[nodeId];
+  auto cell = node.cell;
+
+  if (node.previous != NO_NODE) {
+    nodes_[node.previous].next = node.next;
+  } else {
+    cellHeads_[cell] = node.next;
+  }
+
+  if (node.next != NO_NODE) {
+    nodes_[node.next].previous = node.previous;
+  }
+
+  auto x = cell % gridWidth_;
+  auto y = cell / gridWidth_;
+  if (cellHeads_[cell] == NO_NODE) {
+    occupiedCells_[y * wordsPerRow_ + x / 64] &= ~(uint64_t(1) << (x % 64));
+  }
+  rowCounts_[y]--;
+
+  node.object = nullptr;
+  freeNodes_.push_back(nodeId);
+
+  spdlog::debug("object at location [{0},{1}] removed from collision index.", x, y);
+}
+
+}  // namespace griddly
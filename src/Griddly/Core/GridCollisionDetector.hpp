@@ -0,0 +1,60 @@
+#pragma once
+
+#include <unordered_map>
+
+#include "CollisionDetector.hpp"
+#include "Grid.hpp"
+
+namespace griddly {
+
+// Collision detector backed by a dense index of the grid cells.
+// Each detector only holds the destination objects of its trigger. Occupied cells are kept in a bitmask per row, so
+// range queries are bounded scans over contiguous words that only visit the cells that contain objects.
+class GridCollisionDetector : public CollisionDetector {
+ public:
+  GridCollisionDetector(uint32_t gridWidth, uint32_t gridHeight, uint32_t range, TriggerType triggerType);
+
+  bool upsert(std::shared_ptr<Object> object) override;
+
+  bool remove(std::shared_ptr<Object> object) override;
+
+  SearchResult search(glm::ivec2 location) override;
+
+  void searchInto(glm::ivec2 location, std::vector<std::shared_ptr<Object>>& collidedObjects) override;
+
+ private:
+  static constexpr uint32_t NO_NODE = UINT32_MAX;
+
+  // Objects in the same cell are linked together
+  struct CellNode {
+    std::shared_ptr<Object> object;
+    uint32_t cell = 0;
+    uint32_t previous = NO_NODE;
+    uint32_t next = NO_NODE;
+  };
+
+  template <class Visitor>
+  void forEachInRange(glm::ivec2 location, Visitor&& visitor) const;
+
+  template <class Visitor>
+  void visitRow(int32_t y, int32_t left, int32_t right, Visitor&& visitor) const;
+
+  template <class Visitor>
+  void visitCell(int32_t x, int32_t y, Visitor&& visitor) const;
+
+  void insertNode(const std::shared_ptr<Object>& object, uint32_t cell);
+  void eraseNode(uint32_t nodeId);
+
+  const TriggerType triggerType_;
+  const uint32_t wordsPerRow_;
+
+  std::vector<uint64_t> occupiedCells_;
+  std::vector<uint32_t> rowCounts_;
+  std::vector<uint32_t> cellHeads_;
+
+  std::vector<CellNode> nodes_;
+  std::vector<uint32_t> freeNodes_;
+  std::unordered_map<const Object*, uint32_t> objectNodes_;
+};
+
+}  // namespace griddly
@@ -0,0 +1,131 @@
+#include "GridJournal.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace griddly {
+
+GridChange& GridJournal::nextChange(GridChangeType type) {
+  auto& change = changes_.emplace_back();
+  change.type = type;
+  return change;
+}
+
+void GridJournal::recordTick(int32_t previousTick) {
+  if (!isRecording()) {
+    return;
+  }
+  nextChange(GridChangeType::TICK).previousValue = previousTick;
+}
+
+void GridJournal::recordVariable(std::shared_ptr<int32_t> variable, glm::ivec2 location) {
+  if (!isRecording()) {
+    return;
+  }
+  auto& change = nextChange(GridChangeType::VARIABLE);
+  change.previousValue = *variable;
+  change.variable = std::move(variable);
+  change.location = location;
+}
+
+void GridJournal::recordObjectAdded(std::shared_ptr<Object> object) {
+  if (!isRecording()) {
+    return;
+  }
+  nextChange(GridChangeType::OBJECT_ADDED).object = std::move(object);
+}
+
+void GridJournal::recordObjectRemoved(std::shared_ptr<Object> object, glm::ivec2 location, DiscreteOrientation orientation) {
+  if (!isRecording()) {
+    return;
+  }
+  auto& change = nextChange(GridChangeType::OBJECT_REMOVED);
+  change.object = std::move(object);
+  change.location = location;
+  change.orientation = orientation;
+}
+
+void GridJournal::recordObjectMoved(std::shared_ptr<Object> object, glm::ivec2 previousLocation) {
+  if (!isRecording()) {
+    return;
+  }
+  auto& change = nextChange(GridChangeType::OBJECT_MOVED);
+  change.object = std::move(object);
+  change.location = previousLocation;
+}
+
+void GridJournal::recordObjectAppearance(std::shared_ptr<Object> object, DiscreteOrientation orientation, uint32_t renderTileId) {
+  if (!isRecording()) {
+    return;
+  }
+  auto& change = nextChange(GridChangeType::OBJECT_APPEARANCE);
+  change.object = std::move(object);
+  change.orientation = orientation;
+  change.renderTileId = renderTileId;
+}
+
+void GridJournal::recordDelayedActionPushed(DelayedActionQueueItem item) {
+  if (!isRecording()) {
+    return;
+  }
+  nextChange(GridChangeType::DELAYED_ACTION_PUSHED).delayedAction = std::move(item);
+}
+
+void GridJournal::recordDelayedActionTaken(DelayedActionQueueItem item) {
+  if (!isRecording()) {
+    return;
+  }
+  nextChange(GridChangeType::DELAYED_ACTION_TAKEN).delayedAction = std::move(item);
+}
+
+void GridJournal::pushCheckpoint(size_t historySize, uint32_t nextEntityId) {
+  checkpoints_.push_back({changes_.size(), historySize, nextEntityId});
+}
+
+GridJournal::Checkpoint GridJournal::popCheckpoint(std::vector<GridChange>& changes) {
+  if (checkpoints_.empty()) {
+    throw std::runtime_error("There is no checkpoint to roll back to.");
+  }
+
+  auto checkpoint = checkpoints_.back();
+  checkpoints_.pop_back();
+
+  changes.clear();
+  changes.insert(changes.end(), std::make_move_iterator(changes_.begin() + checkpoint.firstChange), std::make_move_iterator(changes_.end()));
+  changes_.resize(checkpoint.firstChange);
+
+  return checkpoint;
+}
+
+void GridJournal::discardCheckpoint() {
+  if (checkpoints_.empty()) {
+    throw std::runtime_error("There is no checkpoint to discard.");
+  }
+
+  checkpoints_.pop_back();
+
+  // Without a checkpoint nothing can be undone any more
+  if (checkpoints_.empty()) {
+    changes_.clear();
+  }
+}
+
+void GridJournal::clear() {
+  changes_.clear();
+  checkpoints_.clear();
+  suspended_ = false;
+}
+
+size_t GridJournal::getCheckpointCount() const {
+  return checkpoints_.size();
+}
+
+size_t GridJournal::getChangeCount() const {
+  return changes_.size();
+}
+
+void GridJournal::setSuspended(bool suspended) {
+  suspended_ = suspended;
+}
+
+}  // namespace griddly
@@ -0,0 +1,90 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+#include "DelayedActionQueueItem.hpp"
+#include "GDY/Actions/Direction.hpp"
+
+namespace griddly {
+
+class Object;
+
+enum class GridChangeType {
+  VARIABLE,
+  TICK,
+  OBJECT_ADDED,
+  OBJECT_REMOVED,
+  OBJECT_MOVED,
+  OBJECT_APPEARANCE,
+  DELAYED_ACTION_PUSHED,
+  DELAYED_ACTION_TAKEN,
+};
+
+// A single mutation of the grid, holding what is needed to undo it
+struct GridChange {
+  GridChangeType type = GridChangeType::VARIABLE;
+
+  // VARIABLE: the variable and its previous value, location is redrawn when the change is undone
+  std::shared_ptr<int32_t> variable;
+  int32_t previousValue = 0;
+
+  // OBJECT_*: the object, its previous location, orientation and render tile
+  std::shared_ptr<Object> object;
+  glm::ivec2 location{};
+  DiscreteOrientation orientation;
+  uint32_t renderTileId = 0;
+
+  // DELAYED_ACTION_*: the action that was delayed, or taken from the queue by executing or cancelling it
+  DelayedActionQueueItem delayedAction;
+};
+
+// Records the mutations of a grid since a checkpoint so they can be undone in reverse order.
+// Changes are only recorded while there is at least one checkpoint, so the journal costs nothing when it is not used.
+class GridJournal {
+ public:
+  struct Checkpoint {
+    size_t firstChange = 0;
+    size_t historySize = 0;
+    uint32_t nextEntityId = 1;
+  };
+
+  inline bool isRecording() const {
+    return !checkpoints_.empty() && !suspended_;
+  }
+
+  void recordTick(int32_t previousTick);
+  void recordVariable(std::shared_ptr<int32_t> variable, glm::ivec2 location);
+  void recordObjectAdded(std::shared_ptr<Object> object);
+  void recordObjectRemoved(std::shared_ptr<Object> object, glm::ivec2 location, DiscreteOrientation orientation);
+  void recordObjectMoved(std::shared_ptr<Object> object, glm::ivec2 previousLocation);
+  void recordObjectAppearance(std::shared_ptr<Object> object, DiscreteOrientation orientation, uint32_t renderTileId);
+  void recordDelayedActionPushed(DelayedActionQueueItem item);
+  void recordDelayedActionTaken(DelayedActionQueueItem item);
+
+  // historySize is the length of the event history and nextEntityId the grid's next entity id when the checkpoint is made
+  void pushCheckpoint(size_t historySize, uint32_t nextEntityId);
+
+  // Removes the latest checkpoint and moves the changes made since it into changes, oldest first
+  Checkpoint popCheckpoint(std::vector<GridChange>& changes);
+
+  // Removes the latest checkpoint, its changes are kept for the checkpoint below it
+  void discardCheckpoint();
+
+  void clear();
+
+  size_t getCheckpointCount() const;
+  size_t getChangeCount() const;
+
+  // Changes are not recorded while they are being undone
+  void setSuspended(bool suspended);
+
+ private:
+  GridChange& nextChange(GridChangeType type);
+
+  std::vector<GridChange> changes_;
+  std::vector<Checkpoint> checkpoints_;
+  bool suspended_ = false;
+};
+
+}  // namespace griddly
@@ -9,11 +9,6 @@
 namespace griddly {
 
 MapGenerator::MapGenerator(uint32_t playerCount, std::shared_ptr<ObjectGenerator> objectGenerator) : playerCount_(playerCount), objectGenerator_(std::move(objectGenerator)) {
-#ifndef NDEBUG
-  spdlog::set_level(spdlog::level::debug);
-#else
-  spdlog::set_level(spdlog::level::info);
-#endif
 }
 
 MapGenerator::~MapGenerator() = default;
@@ -39,6 +34,8 @@ void MapGenerator::reset(std::shared_ptr<Grid> grid) {
     grid->addPlayerDefaultObject(defaultObject);
   }
 
+  grid->setActionSymbols(objectGenerator_->getActionSymbols());
+
   for (auto& actionTriggerDefinitionIt : objectGenerator_->getActionTriggerDefinitions()) {
     grid->addActionTrigger(actionTriggerDefinitionIt.first, actionTriggerDefinitionIt.second);
   }
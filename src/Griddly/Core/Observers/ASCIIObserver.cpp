@@ -37,7 +37,7 @@ void ASCIIObserver::resetShape() {
 
   observationChannels_ = config_.asciiPadWidth;
 
-  observationShape_ = {observationChannels_, gridWidth_, gridHeight_};
+  setObservationShape({observationChannels_, gridWidth_, gridHeight_});
   observationStrides_ = {1, observationChannels_, observationChannels_ * gridWidth_};
 
   size_t obsBufferSize = observationChannels_ * gridWidth_ * gridHeight_;
@@ -48,14 +48,52 @@ void ASCIIObserver::resetShape() {
     *(observation_.get() + x) = '.';
   }
 
+  if (outputBuffer_ != nullptr) {
+    copyObservation(observation_.get(), observationStrides_, outputBuffer_, outputStrides_);
+  }
+
+  resetOutputLayout();
+}
+
+void ASCIIObserver::setOutputBuffer(uint8_t* outputBuffer, std::vector<uint32_t> strides) {
+  // Only the changes since the last update are rendered, so the new buffer starts with the current observation
+  const auto* currentOutput = output_;
+  auto currentStrides = getStrides();
+
+  bindOutputBuffer(outputBuffer, std::move(strides));
+
+  auto* newOutput = outputBuffer_ != nullptr ? outputBuffer_ : observation_.get();
+  if (newOutput != currentOutput) {
+    copyObservation(currentOutput, currentStrides, newOutput, getStrides());
+  }
+
+  resetOutputLayout();
+}
+
+void ASCIIObserver::resetOutputLayout() {
+  output_ = outputBuffer_ != nullptr ? outputBuffer_ : observation_.get();
+  auto strides = getStrides();
+  if (strides.empty()) {
+    return;
+  }
+
+  channelStride_ = strides[0];
+  xStride_ = strides[1];
+  yStride_ = strides[2];
 }
 
 void ASCIIObserver::renderLocation(glm::ivec2 objectLocation, glm::ivec2 outputLocation, bool resetLocation) const {
-  auto charPtr = observation_.get() + observationChannels_ * (gridWidth_ * outputLocation.y + outputLocation.x);
+  auto charPtr = output_ + xStride_ * outputLocation.x + yStride_ * outputLocation.y;
 
   if (resetLocation) {
-    auto size = sizeof(uint8_t) * observationChannels_;
-    memset(charPtr, ' ', size);
+    if (channelStride_ == 1) {
+      auto size = sizeof(uint8_t) * observationChannels_;
+      memset(charPtr, ' ', size);
+    } else {
+      for (uint32_t c = 0; c < observationChannels_; c++) {
+        charPtr[c * channelStride_] = ' ';
+      }
+    }
   }
 
   char mapCharacter;
@@ -73,7 +111,9 @@ void ASCIIObserver::renderLocation(glm::ivec2 objectLocation, glm::ivec2 outputL
 
       if (playerIdx > 0) {
         auto playerIdxString = std::to_string(playerIdx);
-        memcpy(charPtr + 1, playerIdxString.c_str(), sizeof(char) * playerIdxString.length());
+        for (size_t c = 0; c < playerIdxString.length(); c++) {
+          charPtr[(c + 1) * channelStride_] = playerIdxString[c];
+        }
       }
     }
 
@@ -97,8 +137,12 @@ uint8_t& ASCIIObserver::update() {
     auto avatarDirection = avatarOrientation.getDirection();
 
     // Have to reset the observation
-    auto size = sizeof(uint8_t) * observationChannels_ * gridWidth_ * gridHeight_;
-    memset(observation_.get(), ' ', size);
+    if (outputBuffer_ != nullptr) {
+      fillOutputBuffer(' ');
+    } else {
+      auto size = sizeof(uint8_t) * observationChannels_ * gridWidth_ * gridHeight_;
+      memset(observation_.get(), ' ', size);
+    }
 
     if (config_.rotateWithAvatar) {
       // Assuming here that gridWidth and gridHeight are odd numbers
@@ -167,33 +211,41 @@ uint8_t& ASCIIObserver::update() {
       }
     }
   } else {
-    const auto& updatedLocations = grid_->getUpdatedLocations(config_.playerId);
-
-    for (auto& location : updatedLocations) {
-      if (location.x >= config_.gridXOffset &&
-          location.x < gridWidth_ + config_.gridXOffset &&
-          location.y >= config_.gridYOffset &&
-          location.y < gridHeight_ + config_.gridYOffset) {
-        auto outputLocation = glm::ivec2(
-            location.x - config_.gridXOffset,
-            location.y - config_.gridYOffset);
-
-        spdlog::debug("Rendering location {0}, {1}.", location.x, location.y);
-
-        if (outputLocation.x < gridWidth_ && outputLocation.x >= 0 && outputLocation.y < gridHeight_ && outputLocation.y >= 0) {
-          renderLocation(location, outputLocation, true);
+    if (grid_->getUpdatedLocations(updatedLocationsCursor_, updatedLocations_)) {
+      for (auto& location : updatedLocations_) {
+        if (location.x >= config_.gridXOffset &&
+            location.x < gridWidth_ + config_.gridXOffset &&
+            location.y >= config_.gridYOffset &&
+            location.y < gridHeight_ + config_.gridYOffset) {
+          auto outputLocation = glm::ivec2(
+              location.x - config_.gridXOffset,
+              location.y - config_.gridYOffset);
+
+          spdlog::debug("Rendering location {0}, {1}.", location.x, location.y);
+
+          if (outputLocation.x < gridWidth_ && outputLocation.x >= 0 && outputLocation.y < gridHeight_ && outputLocation.y >= 0) {
+            renderLocation(location, outputLocation, true);
+          }
+        }
+      }
+    } else {
+      spdlog::debug("Updated locations are no longer available, rendering all locations.");
+
+      for (uint32_t outy = 0; outy < gridHeight_; outy++) {
+        for (uint32_t outx = 0; outx < gridWidth_; outx++) {
+          auto outputLocation = glm::ivec2(outx, outy);
+          auto location = glm::ivec2(outputLocation.x + config_.gridXOffset, outputLocation.y + config_.gridYOffset);
+          if (location.x < gridBoundary_.x && location.x >= 0 && location.y < gridBoundary_.y && location.y >= 0) {
+            renderLocation(location, outputLocation, true);
+          }
         }
       }
     }
   }
 
-  spdlog::debug("Purging update locations.");
-
-  grid_->purgeUpdatedLocations(config_.playerId);
-
   spdlog::debug("ASCII renderer done.");
 
-  return *observation_.get();
+  return *output_;
 }
 
 }  // namespace griddly
@@ -24,13 +24,24 @@ class ASCIIObserver : public Observer, public TensorObservationInterface, public
   void reset() override;
   void resetShape() override;
 
+  void setOutputBuffer(uint8_t* outputBuffer, std::vector<uint32_t> strides) override;
+
   ObserverType getObserverType() const override;
 
  protected:
   void renderLocation(glm::ivec2 objectLocation, glm::ivec2 outputLocation, bool resetLocation = false) const;
 
  private:
+  void resetOutputLayout();
+
   std::shared_ptr<uint8_t> observation_;
+
+  // Where observations are rendered, either observation_ or the caller's output buffer
+  uint8_t* output_ = nullptr;
+  uint32_t channelStride_ = 1;
+  uint32_t xStride_ = 0;
+  uint32_t yStride_ = 0;
+
   uint32_t observationChannels_;
   uint32_t channelsBeforePlayerCount_;
   uint32_t channelsBeforeRotation_;
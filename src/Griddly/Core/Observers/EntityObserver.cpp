@@ -1,7 +1,20 @@
 #include "EntityObserver.hpp"
+
+#include <algorithm>
+
 namespace griddly {
 
-EntityObserver::EntityObserver(std::shared_ptr<Grid> grid) : Observer(std::move(grid)) {
+namespace {
+// Replaces the buffer with a larger one that starts with the first rows of the previous one
+template <class T>
+void growEntityBuffer(std::shared_ptr<std::vector<T>>& buffer, size_t rowSize, size_t rowsToKeep, size_t rowCapacity) {
+  auto grownBuffer = std::make_shared<std::vector<T>>(rowCapacity * rowSize);
+  std::copy(buffer->begin(), buffer->begin() + rowsToKeep * rowSize, grownBuffer->begin());
+  buffer = std::move(grownBuffer);
+}
+}  // namespace
+
+EntityObserver::EntityObserver(std::shared_ptr<Grid> grid) : Observer(grid), validActionCache_(grid) {
 }
 
 void EntityObserver::init(EntityObserverConfig& config) {
@@ -52,6 +65,7 @@ void EntityObserver::init(EntityObserverConfig& config) {
 
     entityFeatures_.insert({objectName, featureNames});
     entityConfig_.insert({objectName, config});
+    entityObservations_.entities[objectName].featureCount = config.totalFeatures;
   }
 }
 
@@ -69,6 +83,7 @@ const std::unordered_map<std::string, std::vector<std::string>>& EntityObserver:
 
 void EntityObserver::reset() {
   Observer::reset();
+  validActionCache_.clear();
 
   // there are no additional steps until this observer can be used.
   observerState_ = ObserverState::READY;
@@ -81,8 +96,6 @@ EntityObservations& EntityObserver::update() {
     buildMasks(entityObservations_);
   }
 
-  grid_->purgeUpdatedLocations(config_.playerId);
-
   return entityObservations_;
 }
 
@@ -129,10 +142,23 @@ glm::ivec2 EntityObserver::resolveLocation(const glm::ivec2& location) const {
   return resolvedLocation;
 }
 
+uint32_t EntityObserver::addEntityRow(EntityTypeObservations& entityTypeObservations) {
+  auto row = entityTypeObservations.entityCount++;
+  auto rowCapacity = entityTypeObservations.ids->size();
+  if (row == rowCapacity) {
+    auto grownRowCapacity = std::max<size_t>(16, rowCapacity * 2);
+    growEntityBuffer(entityTypeObservations.features, entityTypeObservations.featureCount, row, grownRowCapacity);
+    growEntityBuffer(entityTypeObservations.ids, 1, row, grownRowCapacity);
+    growEntityBuffer(entityTypeObservations.locations, 2, row, grownRowCapacity);
+  }
+
+  return row;
+}
+
 void EntityObserver::buildObservations(EntityObservations& entityObservations) {
-  entityObservations.observations.clear();
-  entityObservations.locations.clear();
-  entityObservations.ids.clear();
+  for (auto& entityTypeObservations : entityObservations.entities) {
+    entityTypeObservations.second.entityCount = 0;
+  }
 
   const auto& observableGrid = getObservableGrid();
 
@@ -150,8 +176,10 @@ void EntityObserver::buildObservations(EntityObservations& entityObservations) {
       spdlog::debug("Adding entity {0} to location ({1},{2})", name, resolvedLocation.x, resolvedLocation.y);
 
       const auto& entityConfig = entityConfig_.at(name);
+      auto& entityTypeObservations = entityObservations.entities.at(name);
+      auto row = addEntityRow(entityTypeObservations);
 
-      std::vector<float> featureVector(entityConfig.totalFeatures);
+      auto* featureVector = entityTypeObservations.features->data() + row * entityTypeObservations.featureCount;
       featureVector[0] = static_cast<float>(resolvedLocation.x);
       featureVector[1] = static_cast<float>(resolvedLocation.y);
       featureVector[2] = static_cast<float>(zIdx);
@@ -170,10 +198,11 @@ void EntityObserver::buildObservations(EntityObservations& entityObservations) {
         featureVector[entityConfig.variableOffset + i] = static_cast<float>(variableValue);
       }
 
-      entityObservations.observations[name].push_back(featureVector);
-      auto hash = std::hash<std::shared_ptr<Object>>()(object);
-      entityObservations.ids[name].push_back(hash);
-      entityObservations.locations[hash] = {static_cast<uint32_t>(resolvedLocation.x), static_cast<uint32_t>(resolvedLocation.y)};
+      (*entityTypeObservations.ids)[row] = object->getEntityId();
+
+      auto* entityLocation = entityTypeObservations.locations->data() + row * 2;
+      entityLocation[0] = static_cast<uint32_t>(resolvedLocation.x);
+      entityLocation[1] = static_cast<uint32_t>(resolvedLocation.y);
     }
   }
 }
@@ -184,6 +213,8 @@ void EntityObserver::buildMasks(EntityObservations& entityObservations) {
   entityObservations.actorIds.clear();
   entityObservations.actorMasks.clear();
 
+  validActionCache_.update();
+
   for (const auto& actionNamesAtLocation : getAvailableActionNames(config_.playerId)) {
     auto location = actionNamesAtLocation.first;
     auto actionNames = actionNamesAtLocation.second;
@@ -201,7 +232,7 @@ void EntityObserver::buildMasks(EntityObservations& entityObservations) {
         mask[0] = 1;  // NOP is always available
 
         auto objectAtLocation = grid_->getObject(location);
-        auto entityId = std::hash<std::shared_ptr<Object>>()(objectAtLocation);
+        auto entityId = objectAtLocation != nullptr ? objectAtLocation->getEntityId() : 0;
         auto actionIdsForName = getAvailableActionIdsAtLocation(locationVec, actionName);
 
         for (auto id : actionIdsForName) {
@@ -245,29 +276,10 @@ std::vector<uint32_t> EntityObserver::getAvailableActionIdsAtLocation(glm::ivec2
 
   spdlog::debug("Getting available actionIds for action [{}] at location [{0},{1}]", actionName, location.x, location.y);
 
-  std::vector<uint32_t> availableActionIds{};
   if (srcObject) {
-    const auto& actionInputDefinitions = config_.actionInputsDefinitions;
-    const auto& actionInputDefinition = actionInputDefinitions.at(actionName);
-
-    auto relativeToSource = actionInputDefinition.relative;
-
-    for (const auto& inputMapping : actionInputDefinition.inputMappings) {
-      auto actionId = inputMapping.first;
-      auto mapping = inputMapping.second;
-
-      auto metaData = mapping.metaData;
-
-      // Create an fake action to test for availability (and not duplicate a bunch of code)
-      auto potentialAction = std::make_shared<Action>(Action(grid_, actionName, 0, 0, metaData));
-      potentialAction->init(srcObject, mapping.vectorToDest, mapping.orientationVector, relativeToSource);
-
-      if (srcObject->isValidAction(potentialAction)) {
-        availableActionIds.push_back(actionId);
-      }
-    }
+    return validActionCache_.getValidActionIds(srcObject, actionName, config_.actionInputsDefinitions.at(actionName));
   }
 
-  return availableActionIds;
+  return {};
 }
 }  // namespace griddly
\ No newline at end of file
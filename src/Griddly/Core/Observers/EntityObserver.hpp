@@ -1,19 +1,37 @@
 #pragma once
 
+#include <memory>
+
 #include "../Grid.hpp"
+#include "../ValidActionCache.hpp"
 #include "Observer.hpp"
 #include "ObserverConfigInterface.hpp"
 #include "TensorObservationInterface.hpp"
 
 namespace griddly {
 
+// The observed entities of one type, one row per entity. The buffers are reused between updates and only grow, rows past entityCount are unused.
+// A buffer that has to grow is replaced rather than reallocated, so anything still holding the previous one can keep reading it.
+struct EntityTypeObservations {
+  uint32_t featureCount = 0;
+  uint32_t entityCount = 0;
+
+  // [entityCount, featureCount] features of each entity, in the order of the observer's feature names
+  std::shared_ptr<std::vector<float>> features = std::make_shared<std::vector<float>>();
+
+  // [entityCount] entity ids assigned by the grid
+  std::shared_ptr<std::vector<uint32_t>> ids = std::make_shared<std::vector<uint32_t>>();
+
+  // [entityCount, 2] location of each entity in the observation
+  std::shared_ptr<std::vector<uint32_t>> locations = std::make_shared<std::vector<uint32_t>>();
+};
+
 struct EntityObservations {
-  std::unordered_map<std::string, std::vector<std::vector<float>>> observations{};
-  std::unordered_map<size_t, std::array<uint32_t, 2>> locations{};
-  std::unordered_map<std::string, std::vector<size_t>> ids{};
+  // Every entity type of the observer, including the ones with no entities in view
+  std::unordered_map<std::string, EntityTypeObservations> entities{};
 
   std::map<std::string, std::vector<std::vector<uint32_t>>> actorMasks{};
-  std::map<std::string, std::vector<size_t>> actorIds{};
+  std::map<std::string, std::vector<uint32_t>> actorIds{};
 };
 
 struct EntityObserverConfig : public ObserverConfig {
@@ -57,6 +75,9 @@ class EntityObserver : public Observer, public ObservationInterface<EntityObserv
   void buildObservations(EntityObservations& entityObservations);
   void buildMasks(EntityObservations& entityObservations);
 
+  // Makes room for one more entity, returning the row it is written to
+  static uint32_t addEntityRow(EntityTypeObservations& entityTypeObservations);
+
   glm::ivec2 resolveLocation(const glm::ivec2& location) const;
 
   std::unordered_map<glm::ivec2, std::unordered_set<std::string>> getAvailableActionNames(uint32_t playerId) const;
@@ -71,5 +92,7 @@ class EntityObserver : public Observer, public ObservationInterface<EntityObserv
 
   std::unordered_map<std::string, std::vector<std::string>> entityFeatures_;
 
+  mutable ValidActionCache validActionCache_;
+
 };
 }  // namespace griddly
\ No newline at end of file
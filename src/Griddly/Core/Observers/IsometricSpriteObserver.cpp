@@ -38,7 +38,7 @@ void IsometricSpriteObserver::resetShape() {
   pixelWidth_ = (gridWidth_ + gridHeight_) * tileSize.x / 2;
   pixelHeight_ = (gridWidth_ + gridHeight_) * (config.isoTileHeight / 2) + tileSize.y;
 
-  observationShape_ = {3, pixelWidth_, pixelHeight_};
+  setObservationShape({3, pixelWidth_, pixelHeight_});
 
   isoHeightRatio_ = static_cast<float>(config.isoTileHeight) / static_cast<float>(tileSize.y);
 
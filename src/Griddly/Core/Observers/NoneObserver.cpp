@@ -12,7 +12,14 @@ NoneObserver::NoneObserver(std::shared_ptr<Grid> grid) : Observer(grid) {
 }
 
 uint8_t& NoneObserver::update() {
-  return *emptyObs_.get();
+  return outputBuffer_ != nullptr ? *outputBuffer_ : *emptyObs_.get();
+}
+
+void NoneObserver::setOutputBuffer(uint8_t* outputBuffer, std::vector<uint32_t> strides) {
+  bindOutputBuffer(outputBuffer, std::move(strides));
+  if (outputBuffer_ != nullptr) {
+    *outputBuffer_ = 0;
+  }
 }
 
 void NoneObserver::resetShape() {
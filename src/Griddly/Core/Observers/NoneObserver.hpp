@@ -13,6 +13,8 @@ class NoneObserver : public Observer, public TensorObservationInterface {
   uint8_t& update() override;
   void resetShape() override;
 
+  void setOutputBuffer(uint8_t* outputBuffer, std::vector<uint32_t> strides) override;
+
   [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] [[nodiscard]] ObserverType getObserverType() const override;
 
  private:
@@ -26,6 +26,9 @@ void Observer::reset() {
   }
   resetShape();
 
+  // Read every update the grid still holds, the grid will ask for a full redraw if some have been dropped
+  updatedLocationsCursor_ = 0;
+
   doTrackAvatar_ = avatarObject_ != nullptr && config_.trackAvatar;
 
   // if the observer is "READY", then it has already been initialized once, so keep it in the ready state, we're just resetting it.
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "../Grid.hpp"
 
@@ -83,6 +84,10 @@ class Observer {
 
   bool doTrackAvatar_ = false;
 
+  // Position of this observer in the grid's sequence of updated locations
+  uint64_t updatedLocationsCursor_ = 0;
+  std::vector<glm::ivec2> updatedLocations_;
+
  private:
   ObserverConfig config_;
 };
@@ -0,0 +1,74 @@
+#include "TensorObservationInterface.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <cstring>
+#include <utility>
+
+namespace griddly {
+
+void TensorObservationInterface::setObservationShape(std::vector<uint32_t> observationShape) {
+  if (outputBuffer_ != nullptr && observationShape != observationShape_) {
+    spdlog::warn("Observation shape has changed, the observer no longer renders into its output buffer.");
+    outputBuffer_ = nullptr;
+    outputStrides_.clear();
+  }
+
+  observationShape_ = std::move(observationShape);
+}
+
+void TensorObservationInterface::bindOutputBuffer(uint8_t* outputBuffer, std::vector<uint32_t> strides) {
+  if (outputBuffer == nullptr) {
+    outputBuffer_ = nullptr;
+    outputStrides_.clear();
+    return;
+  }
+
+  if (observationShape_.size() != 3) {
+    throw std::runtime_error("The observation shape is not known yet, the observer must be reset before it is given an output buffer.");
+  }
+
+  if (strides.size() != observationShape_.size()) {
+    auto error = fmt::format("Output buffer has {0} strides but the observation has {1} dimensions.", strides.size(), observationShape_.size());
+    spdlog::error(error);
+    throw std::invalid_argument(error);
+  }
+
+  outputBuffer_ = outputBuffer;
+  outputStrides_ = std::move(strides);
+}
+
+void TensorObservationInterface::copyObservation(const uint8_t* source, const std::vector<uint32_t>& sourceStrides, uint8_t* destination, const std::vector<uint32_t>& destinationStrides) const {
+  // The first dimension is the innermost one for every observer, so it is copied in runs when both layouts are packed along it
+  bool packedRuns = sourceStrides[0] == 1 && destinationStrides[0] == 1;
+  for (uint32_t k = 0; k < observationShape_[2]; k++) {
+    for (uint32_t j = 0; j < observationShape_[1]; j++) {
+      const auto* sourceRun = source + j * sourceStrides[1] + k * sourceStrides[2];
+      auto* destinationRun = destination + j * destinationStrides[1] + k * destinationStrides[2];
+      if (packedRuns) {
+        std::memcpy(destinationRun, sourceRun, observationShape_[0]);
+      } else {
+        for (uint32_t i = 0; i < observationShape_[0]; i++) {
+          destinationRun[i * destinationStrides[0]] = sourceRun[i * sourceStrides[0]];
+        }
+      }
+    }
+  }
+}
+
+void TensorObservationInterface::fillOutputBuffer(uint8_t value) const {
+  for (uint32_t k = 0; k < observationShape_[2]; k++) {
+    for (uint32_t j = 0; j < observationShape_[1]; j++) {
+      auto* run = outputBuffer_ + j * outputStrides_[1] + k * outputStrides_[2];
+      if (outputStrides_[0] == 1) {
+        std::memset(run, value, observationShape_[0]);
+      } else {
+        for (uint32_t i = 0; i < observationShape_[0]; i++) {
+          run[i * outputStrides_[0]] = value;
+        }
+      }
+    }
+  }
+}
+
+}  // namespace griddly
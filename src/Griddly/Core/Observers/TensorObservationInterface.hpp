@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
 #include "ObservationInterface.hpp"
@@ -15,12 +16,38 @@ class TensorObservationInterface : public ObservationInterface<uint8_t> {
   }
 
   virtual std::vector<uint32_t> getStrides() const {
-    return observationStrides_;
+    return outputBuffer_ != nullptr ? outputStrides_ : observationStrides_;
   }
 
+  /**
+   * Render observations into memory owned by the caller instead of the observer's own buffer, so a batch of environments can each write
+   * into their slice of one preallocated array. Element [i, j, k] is written to outputBuffer + i * strides[0] + j * strides[1] + k * strides[2].
+   *
+   * The shape is only known once the observer has been reset. The memory must stay valid and must not be written to by the caller while
+   * it is in use, as observers only redraw what has changed. The observer goes back to its own buffer if a reset changes its shape
+   * or if outputBuffer is nullptr.
+   */
+  virtual void setOutputBuffer(uint8_t* outputBuffer, std::vector<uint32_t> strides) = 0;
+
  protected:
+  // Observers stop using the output buffer if their shape changes, as it was laid out for the previous one
+  void setObservationShape(std::vector<uint32_t> observationShape);
+
+  // Checks the strides against the shape and starts using the buffer
+  void bindOutputBuffer(uint8_t* outputBuffer, std::vector<uint32_t> strides);
+
+  // Copies an observation of the current shape between two memory layouts
+  void copyObservation(const uint8_t* source, const std::vector<uint32_t>& sourceStrides, uint8_t* destination, const std::vector<uint32_t>& destinationStrides) const;
+
+  // Sets every element of the observation in the output buffer
+  void fillOutputBuffer(uint8_t value) const;
+
   std::vector<uint32_t> observationShape_{};
   std::vector<uint32_t> observationStrides_{};
+
+  // nullptr while the observer renders into its own buffer
+  uint8_t* outputBuffer_ = nullptr;
+  std::vector<uint32_t> outputStrides_{};
 };
 
 }  // namespace griddly
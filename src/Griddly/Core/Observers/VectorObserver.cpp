@@ -4,8 +4,13 @@
 #include <spdlog/fmt/fmt.h>
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
 
+#include "VectorObserverGroup.hpp"
+
 namespace griddly {
 
 VectorObserver::VectorObserver(std::shared_ptr<Grid> grid) : Observer(grid) {}
@@ -30,6 +35,27 @@ ObserverType VectorObserver::getObserverType() const {
   return ObserverType::VECTOR;
 }
 
+uint32_t VectorObserver::getPackedChannelCount() const {
+  return packedChannels_;
+}
+
+void VectorObserver::getSparseObservation(std::vector<uint32_t>& indices, std::vector<uint8_t>& values) const {
+  indices.clear();
+  values.clear();
+  for (uint32_t y = 0; y < gridHeight_; y++) {
+    for (uint32_t x = 0; x < gridWidth_; x++) {
+      const auto* memPtr = output_ + x * xStride_ + y * yStride_;
+      for (uint32_t c = 0; c < observationChannels_; c++) {
+        auto value = memPtr[c * channelStride_];
+        if (value != 0) {
+          indices.insert(indices.end(), {c, x, y});
+          values.push_back(value);
+        }
+      }
+    }
+  }
+}
+
 void VectorObserver::resetShape() {
   auto config = getConfig();
   gridWidth_ = config.overrideGridWidth > 0 ? config.overrideGridWidth : grid_->getWidth();
@@ -38,13 +64,27 @@ void VectorObserver::resetShape() {
   gridBoundary_.x = grid_->getWidth();
   gridBoundary_.y = grid_->getHeight();
 
-  observationChannels_ = static_cast<uint32_t>(grid_->getObjectIds().size());
+  auto objectTypeCount = static_cast<uint32_t>(grid_->getObjectIds().size());
+  if (config.format == VectorObservationFormat::TYPE_IDS) {
+    if (objectTypeCount > 255) {
+      throw std::invalid_argument(fmt::format("TYPE_IDS vector observations can only hold 255 object types, there are {0}.", objectTypeCount));
+    }
+
+    observationChannels_ = static_cast<uint32_t>(config.objectLayers.size());
+  } else {
+    observationChannels_ = objectTypeCount;
+  }
 
   // Always in order objects, player, orientation, variables.
+  playerIdChannels_.clear();
   if (config.includePlayerId) {
     channelsBeforePlayerCount_ = observationChannels_;
     observationChannels_ += config.playerCount + 1;  // additional one-hot for "no-player"
 
+    for (uint32_t playerId = 0; playerId <= config.playerCount; playerId++) {
+      playerIdChannels_.push_back(channelsBeforePlayerCount_ + getEgocentricPlayerId(playerId));
+    }
+
     spdlog::debug("Adding {0} playerId channels at: {1}", observationChannels_ - channelsBeforePlayerCount_, channelsBeforePlayerCount_);
   }
 
@@ -54,46 +94,130 @@ void VectorObserver::resetShape() {
     spdlog::debug("Adding {0} rotation channels at: {1}", observationChannels_ - channelsBeforeRotation_, channelsBeforeRotation_);
   }
 
+  packedChannels_ = 0;
+  if (config.format == VectorObservationFormat::BIT_PACKED) {
+    packedChannels_ = observationChannels_;
+    observationChannels_ = (packedChannels_ + 7) / 8;
+    spdlog::debug("Packing {0} channels into {1} bytes", packedChannels_, observationChannels_);
+  }
+
   if (config.includeVariables) {
     channelsBeforeVariables_ = observationChannels_;
     observationChannels_ += static_cast<uint32_t>(grid_->getObjectVariableIds().size());
     spdlog::debug("Adding {0} variable channels at: {1}", observationChannels_ - channelsBeforeVariables_, channelsBeforeVariables_);
   }
 
-  observationShape_ = {observationChannels_, gridWidth_, gridHeight_};
+  setObservationShape({observationChannels_, gridWidth_, gridHeight_});
+  renderPlans_.clear();
+  windowValid_ = false;
   observationStrides_ = {1, observationChannels_, observationChannels_ * gridWidth_};
 
   observation_ = std::shared_ptr<uint8_t>(new uint8_t[observationChannels_ * gridWidth_ * gridHeight_]{}); //NOLINT
 
+  if (outputBuffer_ != nullptr) {
+    fillOutputBuffer(0);
+  }
+
+  resetOutputLayout();
+}
+
+void VectorObserver::setOutputBuffer(uint8_t* outputBuffer, std::vector<uint32_t> strides) {
+  // Only the changes since the last update are rendered, so the new buffer starts with the current observation
+  const auto* currentOutput = output_;
+  auto currentStrides = getStrides();
+
+  bindOutputBuffer(outputBuffer, std::move(strides));
+
+  auto* newOutput = outputBuffer_ != nullptr ? outputBuffer_ : observation_.get();
+  if (newOutput != currentOutput) {
+    copyObservation(currentOutput, currentStrides, newOutput, getStrides());
+  }
+
+  resetOutputLayout();
+}
+
+void VectorObserver::resetOutputLayout() {
+  output_ = outputBuffer_ != nullptr ? outputBuffer_ : observation_.get();
+  auto strides = getStrides();
+  if (strides.empty()) {
+    return;
+  }
+
+  channelStride_ = strides[0];
+  xStride_ = strides[1];
+  yStride_ = strides[2];
+}
+
+const VectorObserver::ObjectRenderPlan& VectorObserver::getRenderPlan(const Object& object) const {
+  const auto& behaviourTable = object.getBehaviourTable();
+  auto renderPlanIt = renderPlans_.find(behaviourTable.get());
+  if (renderPlanIt != renderPlans_.end()) {
+    return renderPlanIt->second;
+  }
+
+  spdlog::debug("Creating render plan for object {0}", object.getObjectName());
+  auto objectId = grid_->getObjectIds().at(object.getObjectName());
+  ObjectRenderPlan renderPlan{behaviourTable, true, objectId, 1, {}};
+
+  if (config_.format == VectorObservationFormat::TYPE_IDS) {
+    const auto& objectLayers = config_.objectLayers;
+    auto layerIt = std::find(objectLayers.begin(), objectLayers.end(), static_cast<uint32_t>(object.getZIdx()));
+    renderPlan.rendersObject = layerIt != objectLayers.end();
+    renderPlan.objectChannel = static_cast<uint32_t>(layerIt - objectLayers.begin());
+    renderPlan.objectValue = static_cast<uint8_t>(objectId + 1);
+  }
+
+  if (config_.includeVariables) {
+    // If the variable is one of the variables defined in the objects, it is rendered to the channel of its index
+    const auto& objectVariableIds = grid_->getObjectVariableIds();
+    const auto& variableNames = behaviourTable->variableNames;
+    for (uint32_t slot = 0; slot < variableNames.size(); slot++) {
+      auto objectVariableIt = objectVariableIds.find(variableNames[slot]);
+      if (objectVariableIt != objectVariableIds.end()) {
+        renderPlan.variableChannels.emplace_back(slot, channelsBeforeVariables_ + objectVariableIt->second);
+      }
+    }
+  }
+
+  return renderPlans_.emplace(behaviourTable.get(), std::move(renderPlan)).first->second;
+}
+
+void VectorObserver::setChannel(uint8_t* memPtr, uint32_t channel, uint8_t value) const {
+  if (channel < packedChannels_) {
+    memPtr[(channel / 8) * channelStride_] |= static_cast<uint8_t>(1 << (channel % 8));
+  } else {
+    memPtr[channel * channelStride_] = value;
+  }
 }
 
 void VectorObserver::renderLocation(glm::ivec2 objectLocation, glm::ivec2 outputLocation, bool resetLocation) const {
-  auto config = getConfig();
-  auto memPtr = observation_.get() + observationChannels_ * (gridWidth_ * outputLocation.y + outputLocation.x);
+  renderObjects(grid_->getObjectsAt(objectLocation), outputLocation, resetLocation);
+}
+
+void VectorObserver::renderObjects(const TileObjects& objects, glm::ivec2 outputLocation, bool resetLocation) const {
+  auto memPtr = output_ + xStride_ * outputLocation.x + yStride_ * outputLocation.y;
 
   if (resetLocation) {
-    auto size = sizeof(uint8_t) * observationChannels_;
-    memset(memPtr, 0, size);
+    clearLocation(outputLocation);
   }
 
   // Only put the *include* information of the first object
   bool processTopLayer = true;
-  for (auto& objectIt : grid_->getObjectsAt(objectLocation)) {
-    auto object = objectIt.second;
-    auto objectName = object->getObjectName();
-    spdlog::debug("Rendering object {0}", objectName);
-    auto memPtrObject = memPtr + grid_->getObjectIds().at(objectName);
-    *memPtrObject = 1;
+  for (const auto& objectIt : objects) {
+    const auto& object = objectIt.second;
+    const auto& renderPlan = getRenderPlan(*object);
+    if (renderPlan.rendersObject) {
+      setChannel(memPtr, renderPlan.objectChannel, renderPlan.objectValue);
+    }
 
     if (processTopLayer) {
-      if (config.includePlayerId) {
-        auto playerIdx = getEgocentricPlayerId(object->getPlayerId());
-
-        auto playerMemPtr = memPtr + channelsBeforePlayerCount_ + playerIdx;
-        *playerMemPtr = 1;
+      if (config_.includePlayerId) {
+        auto playerId = object->getPlayerId();
+        auto playerIdChannel = playerId < playerIdChannels_.size() ? playerIdChannels_[playerId] : channelsBeforePlayerCount_ + getEgocentricPlayerId(playerId);
+        setChannel(memPtr, playerIdChannel);
       }
 
-      if (config.includeRotation) {
+      if (config_.includeRotation) {
         uint32_t directionIdx = 0;
         switch (object->getObjectOrientation().getDirection()) {
           case Direction::UP:
@@ -110,24 +234,11 @@ void VectorObserver::renderLocation(glm::ivec2 objectLocation, glm::ivec2 output
             directionIdx = 3;
             break;
         }
-        auto orientationMemPtr = memPtr + channelsBeforeRotation_ + directionIdx;
-        *orientationMemPtr = 1;
+        setChannel(memPtr, channelsBeforeRotation_ + directionIdx);
       }
 
-      if (config.includeVariables) {
-        for (auto& variableIt : object->getAvailableVariables()) {
-          auto variableValue = *variableIt.second;
-          auto variableName = variableIt.first;
-
-          // If the variable is one of the variables defined in the object, get the index of the variable and set it to the variable's value
-          auto objectVariableIt = grid_->getObjectVariableIds().find(variableName);
-          if (objectVariableIt != grid_->getObjectVariableIds().end()) {
-            uint32_t variableIdx = objectVariableIt->second;
-
-            auto variableMemPtr = memPtr + channelsBeforeVariables_ + variableIdx;
-            *variableMemPtr = variableValue;
-          }
-        }
+      for (const auto& variableChannel : renderPlan.variableChannels) {
+        memPtr[variableChannel.second * channelStride_] = *object->getVariableValueAt(variableChannel.first);
       }
 
       processTopLayer = false;
@@ -135,119 +246,191 @@ void VectorObserver::renderLocation(glm::ivec2 objectLocation, glm::ivec2 output
   }
 }
 
-uint8_t& VectorObserver::update() {
-  auto config = getConfig();
-  spdlog::debug("Vector renderer updating.");
+void VectorObserver::clearLocation(glm::ivec2 outputLocation) const {
+  auto memPtr = output_ + xStride_ * outputLocation.x + yStride_ * outputLocation.y;
+  if (channelStride_ == 1) {
+    auto size = sizeof(uint8_t) * observationChannels_;
+    memset(memPtr, 0, size);
+  } else {
+    for (uint32_t c = 0; c < observationChannels_; c++) {
+      memPtr[c * channelStride_] = 0;
+    }
+  }
+}
 
-  if (observerState_ != ObserverState::READY) {
-    throw std::runtime_error("Observer not ready, must be initialized and reset before update() can be called.");
+glm::ivec2 VectorObserver::getWindowOutputLocation(const PartialObservableGrid& window, Direction direction, glm::ivec2 location) const {
+  auto windowLocation = glm::ivec2(location.x - window.left, location.y - window.bottom);
+  switch (direction) {
+    default:
+    case Direction::UP:
+    case Direction::NONE:
+      return windowLocation;
+    case Direction::DOWN:
+      return {static_cast<int32_t>(gridWidth_) - 1 - windowLocation.x, static_cast<int32_t>(gridHeight_) - 1 - windowLocation.y};
+    case Direction::RIGHT:
+      return {windowLocation.y, static_cast<int32_t>(gridHeight_) - 1 - windowLocation.x};
+    case Direction::LEFT:
+      return {static_cast<int32_t>(gridWidth_) - 1 - windowLocation.y, windowLocation.x};
   }
+}
 
+bool VectorObserver::windowFillsObservation(const PartialObservableGrid& window, Direction direction) const {
+  auto windowWidth = static_cast<int64_t>(window.right) - window.left + 1;
+  auto windowHeight = static_cast<int64_t>(window.top) - window.bottom + 1;
+  if (direction == Direction::LEFT || direction == Direction::RIGHT) {
+    std::swap(windowWidth, windowHeight);
+  }
+  return windowWidth == gridWidth_ && windowHeight == gridHeight_;
+}
+
+void VectorObserver::clearObservation() {
+  if (outputBuffer_ != nullptr) {
+    fillOutputBuffer(0);
+  } else {
+    auto size = sizeof(uint8_t) * observationChannels_ * gridWidth_ * gridHeight_;
+    memset(observation_.get(), 0, size);
+  }
+}
+
+bool VectorObserver::beginUpdate(bool updatesAvailable) {
+  PartialObservableGrid window;
+  auto direction = Direction::NONE;
   if (doTrackAvatar_) {
     spdlog::debug("Tracking Avatar.");
+    direction = config_.rotateWithAvatar ? avatarObject_->getObjectOrientation().getDirection() : Direction::NONE;
+    window = getAvatarObservableGrid(avatarObject_->getLocation(), direction);
+  } else {
+    window = {
+        config_.gridYOffset + static_cast<int32_t>(gridHeight_) - 1,
+        config_.gridYOffset,
+        config_.gridXOffset,
+        config_.gridXOffset + static_cast<int32_t>(gridWidth_) - 1};
+  }
 
-    auto avatarLocation = avatarObject_->getLocation();
-    auto avatarOrientation = avatarObject_->getObjectOrientation();
-    auto avatarDirection = avatarOrientation.getDirection();
+  // The previous window can be reused if it has only been moved, everything is redrawn if the avatar has rotated
+  auto redraw = !windowValid_ || !updatesAvailable || direction != windowDirection_ || !windowFillsObservation(window, direction) || !moveWindow(window, direction);
 
-    // Have to reset the observation
-    auto size = sizeof(uint8_t) * observationChannels_ * gridWidth_ * gridHeight_;
-    memset(observation_.get(), 0, size);
+  windowValid_ = true;
+  window_ = window;
+  windowDirection_ = direction;
+
+  if (redraw) {
+    // Clearing the whole observation at once is much cheaper than clearing it cell by cell
+    clearObservation();
+  }
+
+  return redraw;
+}
+
+bool VectorObserver::windowContains(glm::ivec2 location) const {
+  return location.x >= window_.left && location.x <= window_.right && location.y >= window_.bottom && location.y <= window_.top;
+}
+
+glm::ivec2 VectorObserver::getOutputLocation(glm::ivec2 location) const {
+  return getWindowOutputLocation(window_, windowDirection_, location);
+}
+
+bool VectorObserver::moveWindow(const PartialObservableGrid& window, Direction direction) {
+  // The cell that a location was rendered to in the previous window, relative to the cell it is rendered to now
+  auto windowCorner = glm::ivec2(window.left, window.bottom);
+  auto shift = getWindowOutputLocation(window_, direction, windowCorner) - getWindowOutputLocation(window, direction, windowCorner);
 
-    if (config.rotateWithAvatar) {
-      // Assuming here that gridWidth and gridHeight are odd numbers
-      auto pGrid = getAvatarObservableGrid(avatarLocation, avatarDirection);
-      uint32_t outx = 0, outy = 0;
-      switch (avatarDirection) {
-        default:
-        case Direction::UP:
-        case Direction::NONE:
-          for (auto objx = pGrid.left; objx <= pGrid.right; objx++) {
-            outy = 0;
-            for (auto objy = pGrid.bottom; objy <= pGrid.top; objy++) {
-              renderLocation({objx, objy}, {outx, outy});
-              outy++;
-            }
-            outx++;
-          }
-          break;
-        case Direction::DOWN:
-          outx = gridWidth_ - 1;
-          for (auto objx = pGrid.left; objx <= pGrid.right; objx++) {
-            outy = gridHeight_ - 1;
-            for (auto objy = pGrid.bottom; objy <= pGrid.top; objy++) {
-              renderLocation({objx, objy}, {outx, outy});
-              outy--;
-            }
-            outx--;
-          }
-          break;
-        case Direction::RIGHT:
-          outy = gridHeight_ - 1;
-          for (auto objx = pGrid.left; objx <= pGrid.right; objx++) {
-            outx = 0;
-            for (auto objy = pGrid.bottom; objy <= pGrid.top; objy++) {
-              renderLocation({objx, objy}, {outx, outy});
-              outx++;
-            }
-            outy--;
-          }
-          break;
-        case Direction::LEFT:
-          for (auto objx = pGrid.left; objx <= pGrid.right; objx++) {
-            outx = gridWidth_ - 1;
-            for (auto objy = pGrid.bottom; objy <= pGrid.top; objy++) {
-              renderLocation({objx, objy}, {outx, outy});
-              outx--;
-            }
-            outy++;
-          }
-          break;
+  auto width = static_cast<int32_t>(gridWidth_);
+  auto height = static_cast<int32_t>(gridHeight_);
+  if (std::abs(shift.x) >= width || std::abs(shift.y) >= height) {
+    return false;
+  }
+
+  if (shift == glm::ivec2(0, 0)) {
+    return true;
+  }
+
+  shiftOutput(shift);
+
+  // Render the cells that have come into view
+  for (auto objx = window.left; objx <= window.right; objx++) {
+    for (auto objy = window.bottom; objy <= window.top; objy++) {
+      auto outputLocation = getWindowOutputLocation(window, direction, {objx, objy});
+      auto previousLocation = outputLocation + shift;
+      if (previousLocation.x >= 0 && previousLocation.x < width && previousLocation.y >= 0 && previousLocation.y < height) {
+        continue;
       }
 
-    } else {
-      auto pGrid = getAvatarObservableGrid(avatarLocation, Direction::NONE);
-
-      uint32_t outx = 0, outy = 0;
-      for (auto objx = pGrid.left; objx <= pGrid.right; objx++) {
-        outy = 0;
-        for (auto objy = pGrid.bottom; objy <= pGrid.top; objy++) {
-          if (objx < gridBoundary_.x && objx >= 0 && objy < gridBoundary_.y && objy >= 0) {
-            renderLocation({objx, objy}, {outx, outy});
-          }
-          outy++;
-        }
-        outx++;
+      if (objx < gridBoundary_.x && objx >= 0 && objy < gridBoundary_.y && objy >= 0) {
+        renderLocation({objx, objy}, outputLocation, true);
+      } else {
+        clearLocation(outputLocation);
       }
     }
-  } else {
-    const auto& updatedLocations = grid_->getUpdatedLocations(config.playerId);
+  }
 
-    for (auto& location : updatedLocations) {
-      if (location.x >= config.gridXOffset &&
-          location.x < gridWidth_ + config.gridXOffset &&
-          location.y >= config.gridYOffset &&
-          location.y < gridHeight_ + config.gridYOffset) {
-        auto outputLocation = glm::ivec2(
-            location.x - config.gridXOffset,
-            location.y - config.gridYOffset);
+  return true;
+}
 
-        spdlog::debug("Rendering location {0}, {1}.", location.x, location.y);
+void VectorObserver::shiftOutput(glm::ivec2 shift) {
+  // Cells are moved from (x + shift.x, y + shift.y) to (x, y), in the order that reads each cell before it is overwritten
+  auto width = static_cast<int32_t>(gridWidth_);
+  auto height = static_cast<int32_t>(gridHeight_);
+  auto firstX = std::max(0, -shift.x);
+  auto runLength = width - std::abs(shift.x);
+  bool packedRows = channelStride_ == 1 && xStride_ == observationChannels_;
+
+  for (int32_t i = 0; i < height - std::abs(shift.y); i++) {
+    auto y = shift.y > 0 ? i : height - 1 - i;
+    auto* destinationRow = output_ + y * yStride_;
+    const auto* sourceRow = output_ + (y + shift.y) * yStride_;
+
+    if (packedRows) {
+      memmove(destinationRow + firstX * xStride_, sourceRow + (firstX + shift.x) * xStride_, runLength * observationChannels_);
+      continue;
+    }
 
-        if (outputLocation.x < gridWidth_ && outputLocation.x >= 0 && outputLocation.y < gridHeight_ && outputLocation.y >= 0) {
-          renderLocation(location, outputLocation, true);
-        }
+    for (int32_t j = 0; j < runLength; j++) {
+      auto x = shift.x > 0 ? firstX + j : firstX + runLength - 1 - j;
+      for (uint32_t c = 0; c < observationChannels_; c++) {
+        destinationRow[x * xStride_ + c * channelStride_] = sourceRow[(x + shift.x) * xStride_ + c * channelStride_];
       }
     }
   }
+}
 
-  spdlog::debug("Purging update locations.");
+uint8_t& VectorObserver::update() {
+  spdlog::debug("Vector renderer updating.");
 
-  grid_->purgeUpdatedLocations(config.playerId);
+  if (observerState_ != ObserverState::READY) {
+    throw std::runtime_error("Observer not ready, must be initialized and reset before update() can be called.");
+  }
+
+  auto group = group_.lock();
+  if (group != nullptr) {
+    group->update();
+    return *output_;
+  }
+
+  if (beginUpdate(grid_->getUpdatedLocations(updatedLocationsCursor_, updatedLocations_))) {
+    spdlog::debug("Rendering all locations.");
+
+    auto left = std::max(window_.left, 0);
+    auto right = std::min(window_.right, gridBoundary_.x - 1);
+    auto bottom = std::max(window_.bottom, 0);
+    auto top = std::min(window_.top, gridBoundary_.y - 1);
+    for (auto objy = bottom; objy <= top; objy++) {
+      for (auto objx = left; objx <= right; objx++) {
+        renderLocation({objx, objy}, getOutputLocation({objx, objy}));
+      }
+    }
+  } else {
+    for (const auto& location : updatedLocations_) {
+      if (windowContains(location)) {
+        spdlog::debug("Rendering location {0}, {1}.", location.x, location.y);
+        renderLocation(location, getOutputLocation(location), true);
+      }
+    }
+  }
 
   spdlog::debug("Vector renderer done.");
 
-  return *observation_.get();
+  return *output_;
 }
 
 }  // namespace griddly
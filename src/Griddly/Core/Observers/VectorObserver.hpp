@@ -1,3 +1,8 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+
 #include "../Grid.hpp"
 #include "Observer.hpp"
 #include "TensorObservationInterface.hpp"
@@ -5,13 +10,37 @@
 
 namespace griddly {
 
+// How the channels of each cell of a vector observation are stored
+enum class VectorObservationFormat {
+  // One byte per channel
+  DENSE,
+
+  // The object, player id and rotation channels only hold 0 or 1, so they are packed 8 to a byte with the first channel in the lowest bit.
+  // The variable channels follow, one byte each
+  BIT_PACKED,
+
+  // One channel per object layer (z index) instead of one per object type, holding the id of the object type in that layer plus one, or 0 if it is empty.
+  // The player id, rotation and variable channels follow as in DENSE
+  TYPE_IDS,
+
+  // Rendered like DENSE, the python bindings return the indices and values of the elements that are not zero
+  SPARSE,
+};
+
 struct VectorObserverConfig : public ObserverConfig {
   // Config for VECTOR observers only
   bool includeVariables = false;
   bool includeRotation = false;
   bool includePlayerId = false;
+
+  VectorObservationFormat format = VectorObservationFormat::DENSE;
+
+  // The z index of each layer of a TYPE_IDS observation
+  std::vector<uint32_t> objectLayers{};
 };
 
+class VectorObserverGroup;
+
 class VectorObserver : public Observer, public TensorObservationInterface, public ObserverConfigInterface<VectorObserverConfig> {
  public:
   explicit VectorObserver(std::shared_ptr<Grid> grid);
@@ -25,17 +54,93 @@ class VectorObserver : public Observer, public TensorObservationInterface, publi
   void reset() override;
   void resetShape() override;
 
+  void setOutputBuffer(uint8_t* outputBuffer, std::vector<uint32_t> strides) override;
+
   ObserverType getObserverType() const override;
 
+  // The number of channels that are packed into the first bytes of each cell of a BIT_PACKED observation, 0 for other formats
+  uint32_t getPackedChannelCount() const;
+
+  // The [channel, x, y] indices and the values of the elements of the last observation that are not zero, ordered by y, x and then channel
+  void getSparseObservation(std::vector<uint32_t>& indices, std::vector<uint8_t>& values) const;
+
  protected:
   void renderLocation(glm::ivec2 objectLocation, glm::ivec2 outputLocation, bool resetLocation = false) const;
+  void renderObjects(const TileObjects& objects, glm::ivec2 outputLocation, bool resetLocation = false) const;
+  void clearLocation(glm::ivec2 outputLocation) const;
 
  private:
+  // The group renders its observers through the steps of update, reading the objects of each cell once for all of them
+  friend class VectorObserverGroup;
+  // The channels that objects of one type are rendered to, resolved once per behaviour table instead of looking up names for every object
+  struct ObjectRenderPlan {
+    // Holding the table stops its address from being reused by the table of another object type
+    std::shared_ptr<ObjectBehaviourTable> behaviourTable;
+
+    // Layers that are not part of a TYPE_IDS observation are not rendered
+    bool rendersObject;
+    uint32_t objectChannel;
+    uint8_t objectValue;
+
+    // (variable slot, channel) of the variables of the object type that have a channel
+    std::vector<std::pair<uint32_t, uint32_t>> variableChannels;
+  };
+
+  const ObjectRenderPlan& getRenderPlan(const Object& object) const;
+
+  // Writes a value to a channel of the cell at memPtr, channels that are bit packed can only be set to 1
+  void setChannel(uint8_t* memPtr, uint32_t channel, uint8_t value = 1) const;
+
+  void resetOutputLayout();
+
+  // Sets every element of the observation to zero
+  void clearObservation();
+
+  // Moves the observation to the window of grid locations this update renders. Returns true if the whole window has to be rendered,
+  // in which case the observation has been cleared, otherwise only the updated locations inside the window have to be.
+  bool beginUpdate(bool updatesAvailable);
+
+  bool windowContains(glm::ivec2 location) const;
+  glm::ivec2 getOutputLocation(glm::ivec2 location) const;
+
+  // The window is the observed area around the avatar while tracking it, rotated to face the same way as the avatar if rotateWithAvatar is set
+  glm::ivec2 getWindowOutputLocation(const PartialObservableGrid& window, Direction direction, glm::ivec2 location) const;
+  bool windowFillsObservation(const PartialObservableGrid& window, Direction direction) const;
+
+  // Moves the previous window to where the new one overlaps it and renders the part of the window that has come into view.
+  // Returns false if the windows do not overlap
+  bool moveWindow(const PartialObservableGrid& window, Direction direction);
+
+  // Moves every cell of the observation from (x + shift.x, y + shift.y) to (x, y), cells that are not overwritten keep their values
+  void shiftOutput(glm::ivec2 shift);
+
   std::shared_ptr<uint8_t> observation_;
+
+  // Where observations are rendered, either observation_ or the caller's output buffer
+  uint8_t* output_ = nullptr;
+  uint32_t channelStride_ = 1;
+  uint32_t xStride_ = 0;
+  uint32_t yStride_ = 0;
+
   uint32_t observationChannels_;
   uint32_t channelsBeforePlayerCount_;
   uint32_t channelsBeforeRotation_;
   uint32_t channelsBeforeVariables_;
+  uint32_t packedChannels_ = 0;
+
+  // The player id channel of objects owned by each player, from the point of view of this observer's player
+  std::vector<uint32_t> playerIdChannels_;
+
+  // Built as object types are first rendered, cleared when the shape is reset
+  mutable std::unordered_map<const ObjectBehaviourTable*, ObjectRenderPlan> renderPlans_;
+
+  // The grid locations rendered by the last update, invalid until the first update after a reset
+  bool windowValid_ = false;
+  PartialObservableGrid window_{};
+  Direction windowDirection_ = Direction::NONE;
+
+  // Set while the observer is rendered by a group, which then updates every observer in it
+  std::weak_ptr<VectorObserverGroup> group_;
 
   VectorObserverConfig config_;
 };
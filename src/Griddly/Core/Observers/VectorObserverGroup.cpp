@@ -0,0 +1,105 @@
+#include "VectorObserverGroup.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace griddly {
+
+VectorObserverGroup::VectorObserverGroup(std::shared_ptr<Grid> grid) : grid_(std::move(grid)) {
+}
+
+void VectorObserverGroup::addObserver(std::shared_ptr<VectorObserver> observer) {
+  if (observer->grid_ != grid_) {
+    throw std::invalid_argument("Only observers of the same grid can be rendered together.");
+  }
+
+  if (!observer->group_.expired()) {
+    throw std::invalid_argument("The observer is already rendered by another group.");
+  }
+
+  observer->group_ = shared_from_this();
+  observers_.push_back(std::move(observer));
+}
+
+const std::vector<std::shared_ptr<VectorObserver>>& VectorObserverGroup::getObservers() const {
+  return observers_;
+}
+
+void VectorObserverGroup::update() {
+  spdlog::debug("Vector observer group updating {0} observers.", observers_.size());
+
+  auto updatesAvailable = grid_->getUpdatedLocations(updatedLocationsCursor_, updatedLocations_);
+
+  redrawObservers_.clear();
+  updateObservers_.clear();
+  for (const auto& observer : observers_) {
+    // Observers that have not been reset are left for their own update to report
+    if (observer->observerState_ != ObserverState::READY) {
+      continue;
+    }
+
+    // Keeps the observer in step with the grid if it is ever updated on its own
+    observer->updatedLocationsCursor_ = updatedLocationsCursor_;
+
+    if (observer->beginUpdate(updatesAvailable)) {
+      redrawObservers_.push_back(observer.get());
+    } else {
+      updateObservers_.push_back(observer.get());
+    }
+  }
+
+  if (!updateObservers_.empty()) {
+    for (const auto& location : updatedLocations_) {
+      const TileObjects* objects = nullptr;
+      for (auto* observer : updateObservers_) {
+        if (observer->windowContains(location)) {
+          if (objects == nullptr) {
+            objects = &grid_->getObjectsAt(location);
+          }
+          observer->renderObjects(*objects, observer->getOutputLocation(location), true);
+        }
+      }
+    }
+  }
+
+  if (!redrawObservers_.empty()) {
+    renderWindows(redrawObservers_);
+  }
+}
+
+void VectorObserverGroup::renderWindows(const std::vector<VectorObserver*>& observers) const {
+  auto gridWidth = static_cast<int32_t>(grid_->getWidth());
+  auto gridHeight = static_cast<int32_t>(grid_->getHeight());
+
+  // Only the part of the grid that one of the windows covers is traversed
+  auto left = gridWidth;
+  auto right = -1;
+  auto bottom = gridHeight;
+  auto top = -1;
+  for (const auto* observer : observers) {
+    const auto& window = observer->window_;
+    left = std::min(left, std::max(window.left, 0));
+    right = std::max(right, std::min(window.right, gridWidth - 1));
+    bottom = std::min(bottom, std::max(window.bottom, 0));
+    top = std::max(top, std::min(window.top, gridHeight - 1));
+  }
+
+  for (auto y = bottom; y <= top; y++) {
+    for (auto x = left; x <= right; x++) {
+      auto location = glm::ivec2(x, y);
+      const TileObjects* objects = nullptr;
+      for (const auto* observer : observers) {
+        if (observer->windowContains(location)) {
+          if (objects == nullptr) {
+            objects = &grid_->getObjectsAt(location);
+          }
+          observer->renderObjects(*objects, observer->getOutputLocation(location));
+        }
+      }
+    }
+  }
+}
+
+}  // namespace griddly
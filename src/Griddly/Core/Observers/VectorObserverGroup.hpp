@@ -0,0 +1,41 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+#include "VectorObserver.hpp"
+
+namespace griddly {
+
+// Renders several vector observers of the same grid in one pass over it, such as the observers of every player of a game and its global observer.
+// The objects of each cell that has to be rendered are read once and written to every observer that can see the cell, each one with its own
+// player id channels, window and format. Updating any observer in the group updates all of them.
+class VectorObserverGroup : public std::enable_shared_from_this<VectorObserverGroup> {
+ public:
+  explicit VectorObserverGroup(std::shared_ptr<Grid> grid);
+
+  // The observer must render the grid of the group and cannot be in another group
+  void addObserver(std::shared_ptr<VectorObserver> observer);
+
+  const std::vector<std::shared_ptr<VectorObserver>>& getObservers() const;
+
+  // Brings the observations of every observer in the group up to date with the grid
+  void update();
+
+ private:
+  // Renders every cell of the grid that is inside the window of one of the observers
+  void renderWindows(const std::vector<VectorObserver*>& observers) const;
+
+  const std::shared_ptr<Grid> grid_;
+  std::vector<std::shared_ptr<VectorObserver>> observers_;
+
+  uint64_t updatedLocationsCursor_ = 0;
+  std::vector<glm::ivec2> updatedLocations_;
+
+  // The observers that render their whole window in this update and those that only render the updated locations
+  std::vector<VectorObserver*> redrawObservers_;
+  std::vector<VectorObserver*> updateObservers_;
+};
+
+}  // namespace griddly
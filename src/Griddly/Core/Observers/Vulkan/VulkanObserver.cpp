@@ -6,6 +6,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtx/color_space.hpp>
 #include <memory>
+#include <mutex>
 #include <utility>
 
 #include "VulkanConfiguration.hpp"
@@ -14,8 +15,6 @@
 
 namespace griddly {
 
-std::shared_ptr<vk::VulkanInstance> VulkanObserver::instance_ = nullptr;
-
 VulkanObserver::VulkanObserver(std::shared_ptr<Grid> grid) : Observer(std::move(grid)) {
 }
 
@@ -36,6 +35,18 @@ void VulkanObserver::init(VulkanObserverConfig& config) {
   config_ = config;
 }
 
+std::shared_ptr<vk::VulkanInstance> VulkanObserver::getInstance() {
+  static std::mutex instanceMutex;
+  static std::shared_ptr<vk::VulkanInstance> instance;
+
+  std::lock_guard<std::mutex> lock(instanceMutex);
+  if (instance == nullptr) {
+    auto configuration = vk::VulkanConfiguration();
+    instance = std::make_shared<vk::VulkanInstance>(configuration);
+  }
+  return instance;
+}
+
 /**
  * Only load vulkan if update() called, allows many environments with vulkan-based global observers to be used. 
  * But only loads them if global observations are requested, for example for creating videos
@@ -54,12 +65,7 @@ void VulkanObserver::lazyInit() {
   auto imagePath = config_.resourceConfig.imagePath;
   auto shaderPath = config_.resourceConfig.shaderPath;
 
-  auto configuration = vk::VulkanConfiguration();
-  if (instance_ == nullptr) {
-    instance_ = std::make_shared<vk::VulkanInstance>(configuration);
-  }
-
-  device_ = std::make_shared<vk::VulkanDevice>(vk::VulkanDevice(instance_, config_.tileSize, shaderPath));
+  device_ = std::make_shared<vk::VulkanDevice>(vk::VulkanDevice(getInstance(), config_.tileSize, shaderPath));
   device_->initDevice(false);
 
   // This is probably far too big for most circumstances, but not sure how to work this one out in a smarter way,
@@ -131,9 +137,17 @@ uint8_t& VulkanObserver::update() {
     shouldUpdateCommandBuffer_ = false;
   }
 
-  grid_->purgeUpdatedLocations(config_.playerId);
+  auto* frame = device_->renderFrame();
+  if (outputBuffer_ != nullptr) {
+    copyObservation(frame, observationStrides_, outputBuffer_, outputStrides_);
+    return *outputBuffer_;
+  }
+
+  return *frame;
+}
 
-  return *device_->renderFrame();
+void VulkanObserver::setOutputBuffer(uint8_t* outputBuffer, std::vector<uint32_t> strides) {
+  bindOutputBuffer(outputBuffer, std::move(strides));
 }
 
 void VulkanObserver::resetRenderSurface() {
@@ -40,6 +40,9 @@ class VulkanObserver : public Observer, public TensorObservationInterface, publi
   void reset() override;
   void release() override;
 
+  // Rendered frames are read back from the device, so they are copied into the output buffer rather than into a buffer of the observer
+  void setOutputBuffer(uint8_t* outputBuffer, std::vector<uint32_t> strides) override;
+
   virtual const glm::ivec2 getTileSize() const;
 
  protected:
@@ -67,7 +70,8 @@ class VulkanObserver : public Observer, public TensorObservationInterface, publi
   vk::FrameSSBOData frameSSBOData_;
 
  private:
-  static std::shared_ptr<vk::VulkanInstance> instance_;
+  // The vulkan instance is shared by every observer, it is created by the first one that renders and can be requested from many threads
+  static std::shared_ptr<vk::VulkanInstance> getInstance();
   VulkanObserverConfig config_;
 
 };
@@ -35,7 +35,7 @@ void VulkanGridObserver::resetShape() {
   pixelWidth_ = gridWidth_ * tileSize.x;
   pixelHeight_ = gridHeight_ * tileSize.y;
 
-  observationShape_ = {3, pixelWidth_, pixelHeight_};
+  setObservationShape({3, pixelWidth_, pixelHeight_});
 }
 
 glm::mat4 VulkanGridObserver::getViewMatrix() {
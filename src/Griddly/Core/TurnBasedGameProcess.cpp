@@ -4,7 +4,7 @@
 
 #include <utility>
 
-#include "DelayedActionQueueItem.hpp"
+#include "DelayedActionQueue.hpp"
 #include "Util/util.hpp"
 
 namespace griddly {
@@ -76,6 +76,14 @@ std::string TurnBasedGameProcess::getProcessName() const {
 }
 
 std::shared_ptr<TurnBasedGameProcess> TurnBasedGameProcess::clone() {
+  return cloneGameProcess(false);
+}
+
+std::shared_ptr<TurnBasedGameProcess> TurnBasedGameProcess::fork() {
+  return cloneGameProcess(true);
+}
+
+std::shared_ptr<TurnBasedGameProcess> TurnBasedGameProcess::cloneGameProcess(bool shareImmutableObjects) {
   // Firstly create a new grid
   std::shared_ptr<Grid> clonedGrid = std::make_shared<Grid>(Grid());
 
@@ -86,6 +94,7 @@ std::shared_ptr<TurnBasedGameProcess> TurnBasedGameProcess::clone() {
   clonedGrid->resetMap(gridWidth, gridHeight);
 
   auto objectGenerator = gdyFactory_->getObjectGenerator();
+  clonedGrid->setActionSymbols(objectGenerator->getActionSymbols());
 
   // Clone Global Variables
   spdlog::debug("Cloning global variables...");
@@ -131,11 +140,24 @@ std::shared_ptr<TurnBasedGameProcess> TurnBasedGameProcess::clone() {
     clonedObjectMapping[defaultObjectToCopy] = defaultObject;
   }
 
+  // Share the objects that cannot change, the others are cloned
+  if (shareImmutableObjects) {
+    spdlog::debug("Sharing immutable objects...");
+    clonedGrid->shareImmutableObjects(*grid_);
+  }
+
   // Clone Objects
   spdlog::debug("Cloning objects...");
   const auto & objectsToCopy = grid_->getObjects();
   for (const auto& toCopy : objectsToCopy) {
+    if (shareImmutableObjects && toCopy->isShared()) {
+      clonedObjectMapping[toCopy] = toCopy;
+      continue;
+    }
+
+    // The clone is the same entity, so it keeps the id of the object it copies
     auto clonedObject = objectGenerator->cloneInstance(toCopy, clonedGrid);
+    clonedObject->setEntityId(toCopy->getEntityId());
     clonedGrid->addObject(toCopy->getLocation(), clonedObject, false, nullptr, toCopy->getObjectOrientation());
 
     // We need to know which objects are equivalent in the grid so we can
@@ -143,19 +165,21 @@ std::shared_ptr<TurnBasedGameProcess> TurnBasedGameProcess::clone() {
     clonedObjectMapping[toCopy] = clonedObject;
   }
 
+  clonedGrid->setNextEntityId(grid_->getNextEntityId());
+
   // Copy Game Timer
   spdlog::debug("Cloning game timer state...");
   auto tickCountToCopy = *grid_->getTickCount();
   clonedGrid->setTickCount(tickCountToCopy);
 
   // Clone Delayed actions
-  auto delayedActions = grid_->getDelayedActions();
+  auto delayedActions = grid_->getDelayedActions().getPendingActions();
 
   spdlog::debug("Cloning delayed actions...");
   for (const auto& delayedActionToCopy : delayedActions) {
-    auto remainingTicks = delayedActionToCopy->priority - tickCountToCopy;
-    auto actionToCopy = delayedActionToCopy->action;
-    auto playerId = delayedActionToCopy->playerId;
+    auto remainingTicks = delayedActionToCopy.priority - tickCountToCopy;
+    auto actionToCopy = delayedActionToCopy.action;
+    auto playerId = delayedActionToCopy.playerId;
 
     auto actionName = actionToCopy->getActionName();
     auto vectorToDest = actionToCopy->getVectorToDest();
@@ -168,7 +192,7 @@ std::shared_ptr<TurnBasedGameProcess> TurnBasedGameProcess::clone() {
 
     if (clonedActionSourceObjectIt != clonedObjectMapping.end()) {
       // Clone the action
-      auto clonedAction = std::make_shared<Action>(Action(clonedGrid, actionName, originatingPlayerId, remainingTicks));
+      auto clonedAction = clonedGrid->createAction(actionName, originatingPlayerId, remainingTicks);
 
       // The orientation and vector to dest are already modified from the first action in respect
       // to if this is a relative action, so relative is set to false here
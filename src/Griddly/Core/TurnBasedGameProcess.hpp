@@ -23,9 +23,15 @@ class TurnBasedGameProcess : public GameProcess {
   // Clone the Game Process
   std::shared_ptr<TurnBasedGameProcess> clone();
 
+  // Clone the Game Process, sharing the objects that can never change and the tiles they are on with this one.
+  // Tiles are copied when either game first changes them, so many forks of a large map are cheap to create and hold.
+  std::shared_ptr<TurnBasedGameProcess> fork();
+
   void seedRandomGenerator(uint32_t seed) override;
 
  private:
+  std::shared_ptr<TurnBasedGameProcess> cloneGameProcess(bool shareImmutableObjects);
+
   static const std::string name_;
 };
 }  // namespace griddly
\ No newline at end of file
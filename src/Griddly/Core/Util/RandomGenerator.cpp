@@ -1,20 +1,70 @@
 #include "RandomGenerator.hpp"
 
+#include <stdexcept>
+#include <utility>
+
 namespace griddly {
 
 
 void RandomGenerator::seed(int32_t seed) {
+  saveCheckpoint();
   randomGenerator_.seed(seed);
 }
 
 const int32_t RandomGenerator::sampleInt(int32_t min, int32_t max) {
+  saveCheckpoint();
   std::uniform_int_distribution<int32_t> dist(min, max);
   return dist(randomGenerator_);
 }
 
 const float RandomGenerator::sampleFloat(float min, float max) {
+  saveCheckpoint();
   std::uniform_real_distribution<float> dist(min, max);
   return dist(randomGenerator_);
 }
 
-}  // namespace griddly
\ No newline at end of file
+const std::mt19937& RandomGenerator::getEngine() const {
+  return randomGenerator_;
+}
+
+void RandomGenerator::setEngine(const std::mt19937& engine) {
+  saveCheckpoint();
+  randomGenerator_ = engine;
+}
+
+void RandomGenerator::pushCheckpoint() {
+  if (checkpointCount_ == checkpoints_.size()) {
+    checkpoints_.emplace_back();
+  }
+  checkpoints_[checkpointCount_++].saved = false;
+}
+
+void RandomGenerator::rollback() {
+  if (checkpointCount_ == 0) {
+    throw std::runtime_error("There is no random generator checkpoint to roll back to.");
+  }
+
+  auto& checkpoint = checkpoints_[--checkpointCount_];
+  if (checkpoint.saved) {
+    randomGenerator_ = checkpoint.engine;
+  }
+}
+
+void RandomGenerator::discardCheckpoint() {
+  if (checkpointCount_ == 0) {
+    throw std::runtime_error("There is no random generator checkpoint to discard.");
+  }
+
+  // If the engine did not change between the previous checkpoint and this one, the saved engine is also the state of the previous checkpoint
+  auto& checkpoint = checkpoints_[--checkpointCount_];
+  if (checkpoint.saved && checkpointCount_ > 0 && !checkpoints_[checkpointCount_ - 1].saved) {
+    std::swap(checkpoints_[checkpointCount_ - 1].engine, checkpoint.engine);
+    checkpoints_[checkpointCount_ - 1].saved = true;
+  }
+}
+
+void RandomGenerator::clearCheckpoints() {
+  checkpointCount_ = 0;
+}
+
+}  // namespace griddly
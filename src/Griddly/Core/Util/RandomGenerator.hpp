@@ -1,4 +1,5 @@
 #include <random>
+#include <vector>
 
 namespace griddly {
 
@@ -10,7 +11,33 @@ class RandomGenerator {
 
   virtual const float sampleFloat(float min, float max);
 
+  // The full engine state, so the generator can be saved and restored with the rest of the game
+  virtual const std::mt19937& getEngine() const;
+  virtual void setEngine(const std::mt19937& engine);
+
+  // Checkpoints of the engine state, used to roll a game back. The engine is only copied the first time it changes after a checkpoint.
+  virtual void pushCheckpoint();
+  virtual void rollback();
+  virtual void discardCheckpoint();
+  virtual void clearCheckpoints();
+
  private:
+  struct Checkpoint {
+    bool saved = false;
+    std::mt19937 engine;
+  };
+
+  inline void saveCheckpoint() {
+    if (checkpointCount_ > 0 && !checkpoints_[checkpointCount_ - 1].saved) {
+      checkpoints_[checkpointCount_ - 1].engine = randomGenerator_;
+      checkpoints_[checkpointCount_ - 1].saved = true;
+    }
+  }
+
+  // Entries past checkpointCount_ are kept so their engines do not have to be constructed again
+  std::vector<Checkpoint> checkpoints_;
+  size_t checkpointCount_ = 0;
+
   // Random number generator for the grid and associated objects
   std::mt19937 randomGenerator_ = std::mt19937();
 };
@@ -0,0 +1,86 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace griddly {
+
+// Appends plain values to a byte buffer in native byte order, used to snapshot the state of a game
+class StateWriter {
+ public:
+  explicit StateWriter(std::vector<uint8_t>& buffer) : buffer_(buffer) {
+  }
+
+  template <class T>
+  void write(const T& value) {
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be written to a state buffer");
+    writeBytes(&value, sizeof(T));
+  }
+
+  void writeString(const std::string& value) {
+    write(static_cast<uint32_t>(value.size()));
+    writeBytes(value.data(), value.size());
+  }
+
+  void writeBytes(const void* data, size_t size) {
+    auto offset = buffer_.size();
+    buffer_.resize(offset + size);
+    if (size > 0) {
+      std::memcpy(buffer_.data() + offset, data, size);
+    }
+  }
+
+ private:
+  std::vector<uint8_t>& buffer_;
+};
+
+// Reads values written by StateWriter, throws std::invalid_argument if the buffer is too short
+class StateReader {
+ public:
+  StateReader(const uint8_t* data, size_t size) : data_(data), size_(size) {
+  }
+
+  template <class T>
+  T read() {
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be read from a state buffer");
+    T value;
+    readBytes(&value, sizeof(T));
+    return value;
+  }
+
+  std::string readString() {
+    auto size = read<uint32_t>();
+    require(size);
+    std::string value(reinterpret_cast<const char*>(data_ + offset_), size);
+    offset_ += size;
+    return value;
+  }
+
+  void readBytes(void* data, size_t size) {
+    require(size);
+    if (size > 0) {
+      std::memcpy(data, data_ + offset_, size);
+    }
+    offset_ += size;
+  }
+
+  bool atEnd() const {
+    return offset_ == size_;
+  }
+
+ private:
+  void require(size_t size) const {
+    if (size > size_ - offset_) {
+      throw std::invalid_argument("State buffer is truncated or corrupt.");
+    }
+  }
+
+  const uint8_t* const data_;
+  const size_t size_;
+  size_t offset_ = 0;
+};
+
+}  // namespace griddly
@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+namespace griddly {
+
+// 64 bit hashing for game states. Unlike std::hash the values do not depend on the process, compiler or platform,
+// so hashes of the same state can be compared between runs.
+
+// splitmix64 finalizer
+inline uint64_t mixStateHash(uint64_t value) {
+  value += 0x9e3779b97f4a7c15ull;
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+  return value ^ (value >> 31);
+}
+
+// FNV-1a
+inline uint64_t hashStateString(const std::string& value) {
+  uint64_t hash = 0xcbf29ce484222325ull;
+  for (auto c : value) {
+    hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3ull;
+  }
+  return hash;
+}
+
+inline void combineStateHash(uint64_t& seed, uint64_t value) {
+  seed = mixStateHash(seed ^ value);
+}
+
+}  // namespace griddly
@@ -0,0 +1,177 @@
+#include "ThreadPool.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace griddly {
+
+ThreadPool::ThreadPool(uint32_t threadCount, bool pinThreads)
+    : threadCount_(threadCount > 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency())) {
+  for (uint32_t t = 0; t < threadCount_; t++) {
+    queues_.push_back(std::make_unique<TaskQueue>());
+  }
+
+  auto coreCount = std::max(1u, std::thread::hardware_concurrency());
+  for (uint32_t t = 1; t < threadCount_; t++) {
+    workers_.emplace_back(&ThreadPool::workerLoop, this, t);
+
+    // The calling thread belongs to the caller so it is never pinned
+    if (pinThreads) {
+      pinThread(workers_.back().native_handle(), t % coreCount);
+    }
+  }
+
+  spdlog::debug("Created thread pool with {0} threads", threadCount_);
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  batchStarted_.notify_all();
+
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+void ThreadPool::pinThread(std::thread::native_handle_type thread, uint32_t core) {
+#ifdef __linux__
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  CPU_SET(core, &cpuSet);
+  if (pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpuSet) != 0) {
+    spdlog::warn("Could not pin thread to core {0}", core);
+  }
+#else
+  spdlog::warn("Pinning threads to cores is not supported on this platform");
+#endif
+}
+
+void ThreadPool::parallelFor(uint32_t taskCount, const std::function<void(uint32_t)>& task) {
+  if (taskCount == 0) {
+    return;
+  }
+
+  if (threadCount_ == 1) {
+    for (uint32_t t = 0; t < taskCount; t++) {
+      task(t);
+    }
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  // Threads that woke up too late to help with the last batch must be done looking at the queues before they are refilled
+  batchFinished_.wait(lock, [this] { return activeThreads_ == 0; });
+
+  // Each thread starts with a contiguous range of the tasks
+  for (uint32_t q = 0; q < threadCount_; q++) {
+    auto begin = static_cast<uint64_t>(taskCount) * q / threadCount_;
+    auto end = static_cast<uint64_t>(taskCount) * (q + 1) / threadCount_;
+    std::lock_guard<std::mutex> queueLock(queues_[q]->mutex);
+    for (auto t = begin; t < end; t++) {
+      queues_[q]->tasks.push_back(static_cast<uint32_t>(t));
+    }
+  }
+
+  task_ = &task;
+  error_ = nullptr;
+  batch_++;
+  activeThreads_++;
+  lock.unlock();
+  batchStarted_.notify_all();
+
+  runTasks(0, task);
+
+  // The calling thread only runs out of tasks once all of them have been taken, so the batch is finished when no thread is running one
+  lock.lock();
+  activeThreads_--;
+  batchFinished_.wait(lock, [this] { return activeThreads_ == 0; });
+  task_ = nullptr;
+
+  if (error_ != nullptr) {
+    auto error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+void ThreadPool::workerLoop(uint32_t queueIdx) {
+  uint64_t lastBatch = 0;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    batchStarted_.wait(lock, [this, lastBatch] { return stopping_ || batch_ != lastBatch; });
+    if (stopping_) {
+      return;
+    }
+
+    lastBatch = batch_;
+    if (task_ == nullptr) {
+      continue;
+    }
+
+    const auto& task = *task_;
+    activeThreads_++;
+    lock.unlock();
+
+    runTasks(queueIdx, task);
+
+    lock.lock();
+    if (--activeThreads_ == 0) {
+      batchFinished_.notify_all();
+    }
+  }
+}
+
+void ThreadPool::runTasks(uint32_t queueIdx, const std::function<void(uint32_t)>& task) {
+  uint32_t taskIdx;
+  while (takeTask(queueIdx, taskIdx)) {
+    try {
+      task(taskIdx);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (error_ == nullptr) {
+        error_ = std::current_exception();
+      }
+    }
+  }
+}
+
+bool ThreadPool::takeTask(uint32_t queueIdx, uint32_t& taskIdx) {
+  {
+    auto& queue = *queues_[queueIdx];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      taskIdx = queue.tasks.front();
+      queue.tasks.pop_front();
+      return true;
+    }
+  }
+
+  // Steal from the back of the other queues, the owners work from the front
+  for (uint32_t offset = 1; offset < threadCount_; offset++) {
+    auto& queue = *queues_[(queueIdx + offset) % threadCount_];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (!queue.tasks.empty()) {
+      taskIdx = queue.tasks.back();
+      queue.tasks.pop_back();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+uint32_t ThreadPool::getThreadCount() const {
+  return threadCount_;
+}
+
+}  // namespace griddly
@@ -0,0 +1,61 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace griddly {
+
+// Runs batches of independent tasks over a fixed set of threads.
+// The tasks of a batch are split evenly between the threads up front, threads that run out of tasks steal them from the others,
+// so a batch where a few tasks are much slower than the rest still keeps every thread busy.
+class ThreadPool {
+ public:
+  // The calling thread also runs tasks, so threadCount - 1 threads are started. If threadCount is 0 the hardware concurrency is used.
+  // Pinned threads each run on their own core, only supported on linux.
+  explicit ThreadPool(uint32_t threadCount, bool pinThreads = false);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Runs task(0) ... task(taskCount - 1) and returns once they have all finished.
+  // If any of the tasks throw, the first exception is rethrown after the batch has finished.
+  // Only one batch can run at a time, so it must not be called from more than one thread at once.
+  void parallelFor(uint32_t taskCount, const std::function<void(uint32_t)>& task);
+
+  uint32_t getThreadCount() const;
+
+ private:
+  struct TaskQueue {
+    std::mutex mutex;
+    std::deque<uint32_t> tasks;
+  };
+
+  void workerLoop(uint32_t queueIdx);
+  void runTasks(uint32_t queueIdx, const std::function<void(uint32_t)>& task);
+  bool takeTask(uint32_t queueIdx, uint32_t& taskIdx);
+  static void pinThread(std::thread::native_handle_type thread, uint32_t core);
+
+  const uint32_t threadCount_;
+
+  // One queue per thread, the calling thread uses the first one
+  std::vector<std::unique_ptr<TaskQueue>> queues_;
+  std::vector<std::thread> workers_;
+
+  std::mutex mutex_;
+  std::condition_variable batchStarted_;
+  std::condition_variable batchFinished_;
+  const std::function<void(uint32_t)>* task_ = nullptr;
+  uint64_t batch_ = 0;
+  uint32_t activeThreads_ = 0;
+  bool stopping_ = false;
+  std::exception_ptr error_;
+};
+
+}  // namespace griddly
@@ -0,0 +1,101 @@
+#include "ValidActionCache.hpp"
+
+#include <algorithm>
+
+#include "Grid.hpp"
+
+namespace griddly {
+
+ValidActionCache::ValidActionCache(std::shared_ptr<Grid> grid) : grid_(std::move(grid)) {
+}
+
+void ValidActionCache::update() {
+  auto width = grid_->getWidth();
+  auto height = grid_->getHeight();
+  if (width != width_ || height != height_) {
+    width_ = width;
+    height_ = height;
+    tileActionIds_.clear();
+    tileActionIds_.resize(width_ * height_);
+  }
+
+  // Too many updates to know which locations changed
+  if (!grid_->getUpdatedLocations(updatedLocationsCursor_, updatedLocations_)) {
+    clear();
+    return;
+  }
+
+  for (const auto& location : updatedLocations_) {
+    for (const auto& offset : targetOffsets_) {
+      auto sourceLocation = location - offset;
+      if (sourceLocation.x >= 0 && sourceLocation.y >= 0 && static_cast<uint32_t>(sourceLocation.x) < width_ && static_cast<uint32_t>(sourceLocation.y) < height_) {
+        tileActionIds_[sourceLocation.y * width_ + sourceLocation.x].clear();
+      }
+    }
+  }
+}
+
+void ValidActionCache::clear() {
+  for (auto& actionIds : tileActionIds_) {
+    actionIds.clear();
+  }
+}
+
+const std::vector<uint32_t>& ValidActionCache::getValidActionIds(const std::shared_ptr<Object>& object, const std::string& actionName, const ActionInputsDefinition& actionInputsDefinition) {
+  const auto& location = object->getLocation();
+  if (location.x < 0 || location.y < 0 || static_cast<uint32_t>(location.x) >= width_ || static_cast<uint32_t>(location.y) >= height_) {
+    findValidActionIds(object, actionName, actionInputsDefinition, uncachedActionIds_);
+    return uncachedActionIds_;
+  }
+
+  auto& tileActionIds = tileActionIds_[location.y * width_ + location.x];
+  for (auto& cachedActionIds : tileActionIds) {
+    if (cachedActionIds.object == object.get() && cachedActionIds.actionName == actionName) {
+      if (cachedActionIds.readsGlobalVariables) {
+        findValidActionIds(object, actionName, actionInputsDefinition, cachedActionIds.actionIds);
+      }
+      return cachedActionIds.actionIds;
+    }
+  }
+
+  // The cells this action can target have to be known before its result is cached, so that changes to them drop the result
+  if (targetOffsetActionNames_.insert(actionName).second) {
+    addTargetOffsets(actionInputsDefinition);
+  }
+
+  auto& cachedActionIds = tileActionIds.emplace_back(CachedActionIds{object.get(), actionName, object->preconditionsReadGlobalVariables(actionName), {}});
+  findValidActionIds(object, actionName, actionInputsDefinition, cachedActionIds.actionIds);
+  return cachedActionIds.actionIds;
+}
+
+void ValidActionCache::addTargetOffsets(const ActionInputsDefinition& actionInputsDefinition) {
+  for (const auto& inputMapping : actionInputsDefinition.inputMappings) {
+    auto offset = inputMapping.second.vectorToDest;
+
+    // Relative actions are rotated by the orientation of the object, so they can target the vector in any of the four directions
+    auto rotations = actionInputsDefinition.relative ? 4 : 1;
+    for (int32_t r = 0; r < rotations; r++) {
+      if (std::find(targetOffsets_.begin(), targetOffsets_.end(), offset) == targetOffsets_.end()) {
+        targetOffsets_.push_back(offset);
+      }
+      offset = {-offset.y, offset.x};
+    }
+  }
+}
+
+void ValidActionCache::findValidActionIds(const std::shared_ptr<Object>& object, const std::string& actionName, const ActionInputsDefinition& actionInputsDefinition, std::vector<uint32_t>& actionIds) const {
+  actionIds.clear();
+  for (const auto& inputMapping : actionInputsDefinition.inputMappings) {
+    const auto& mapping = inputMapping.second;
+
+    // Create an fake action to test for availability (and not duplicate a bunch of code)
+    auto potentialAction = grid_->createAction(actionName, 0, 0, mapping.metaData);
+    potentialAction->init(object, mapping.vectorToDest, mapping.orientationVector, actionInputsDefinition.relative);
+
+    if (object->isValidAction(potentialAction)) {
+      actionIds.push_back(inputMapping.first);
+    }
+  }
+}
+
+}  // namespace griddly
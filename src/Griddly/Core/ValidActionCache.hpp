@@ -0,0 +1,64 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "GDY/Actions/Action.hpp"
+
+namespace griddly {
+
+class Grid;
+class Object;
+
+// Remembers which input mappings of an action are valid for each object, so preconditions are only checked again for objects they may have changed for.
+// The preconditions of an object read its own variables and orientation and the objects in the cells it can target, and every change to those
+// invalidates a location of the grid. A result is dropped when the location of its object, or any location the object's actions can target, is invalidated.
+// Preconditions that read global variables are checked on every query.
+class ValidActionCache {
+ public:
+  explicit ValidActionCache(std::shared_ptr<Grid> grid);
+
+  // Drops the results that the locations invalidated since the last update may have changed. Must be called before querying a grid that has changed.
+  void update();
+
+  // Drops every result
+  void clear();
+
+  // The ids of the input mappings of the action that are valid for the object, in the order of the definition's input mappings.
+  // The reference is valid until the next call.
+  const std::vector<uint32_t>& getValidActionIds(const std::shared_ptr<Object>& object, const std::string& actionName, const ActionInputsDefinition& actionInputsDefinition);
+
+ private:
+  struct CachedActionIds {
+    const Object* object;
+    std::string actionName;
+    bool readsGlobalVariables;
+    std::vector<uint32_t> actionIds;
+  };
+
+  void addTargetOffsets(const ActionInputsDefinition& actionInputsDefinition);
+  void findValidActionIds(const std::shared_ptr<Object>& object, const std::string& actionName, const ActionInputsDefinition& actionInputsDefinition, std::vector<uint32_t>& actionIds) const;
+
+  const std::shared_ptr<Grid> grid_;
+
+  uint32_t width_ = 0;
+  uint32_t height_ = 0;
+  uint64_t updatedLocationsCursor_ = 0;
+  std::vector<glm::ivec2> updatedLocations_;
+
+  // The results for the objects in each tile of the grid, indexed like the grid's tiles
+  std::vector<std::vector<CachedActionIds>> tileActionIds_;
+
+  // Every vector from an object to a cell that one of the cached actions can target, in any orientation.
+  // An invalidated location drops the results of the tiles these vectors reach it from.
+  std::vector<glm::ivec2> targetOffsets_{{0, 0}};
+  std::unordered_set<std::string> targetOffsetActionNames_;
+
+  // Results for objects outside of the grid are not cached
+  std::vector<uint32_t> uncachedActionIds_;
+};
+
+}  // namespace griddly
@@ -0,0 +1,360 @@
+#include "VectorGameProcess.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <cstring>
+#include <utility>
+
+#include "Observers/TensorObservationInterface.hpp"
+#include "Players/Player.hpp"
+
+namespace griddly {
+
+VectorGameProcess::VectorGameProcess(uint32_t gameCount, std::string playerObserverName, std::shared_ptr<GDYFactory> gdyFactory)
+    : gameCount_(gameCount), playerObserverName_(std::move(playerObserverName)), gdyFactory_(std::move(gdyFactory)) {
+  if (gameCount_ == 0) {
+    throw std::invalid_argument("A vector game process needs at least one game.");
+  }
+
+  playerCount_ = gdyFactory_->getPlayerCount();
+
+  externalActionNames_ = gdyFactory_->getExternalActionNames();
+  for (const auto& actionName : externalActionNames_) {
+    actionInputsDefinitions_.push_back(gdyFactory_->findActionInputsDefinition(actionName));
+  }
+
+  for (uint32_t g = 0; g < gameCount_; g++) {
+    auto grid = std::make_shared<Grid>(Grid());
+
+    // The games are only observed through the players, so the global observer does not need to render anything
+    auto gameProcess = std::make_shared<TurnBasedGameProcess>(TurnBasedGameProcess("NONE", gdyFactory_, grid));
+
+    std::vector<std::shared_ptr<Player>> players;
+    std::vector<std::shared_ptr<TensorObservationInterface>> playerObservers;
+    for (uint32_t playerId = 1; playerId <= playerCount_; playerId++) {
+      auto observer = gdyFactory_->createObserver(grid, playerObserverName_, playerCount_, playerId);
+      auto tensorObserver = std::dynamic_pointer_cast<TensorObservationInterface>(observer);
+      if (tensorObserver == nullptr) {
+        auto error = fmt::format("Observer {0} cannot be used in a vector game process, only observers that produce tensors are supported.", playerObserverName_);
+        spdlog::error(error);
+        throw std::invalid_argument(error);
+      }
+
+      auto player = std::make_shared<Player>(Player(playerId, fmt::format("Player {0}", playerId), observer, gameProcess));
+      gameProcess->addPlayer(player);
+      players.push_back(player);
+      playerObservers.push_back(tensorObserver);
+    }
+
+    gameProcesses_.push_back(gameProcess);
+    players_.push_back(players);
+    playerObservers_.push_back(playerObservers);
+  }
+
+  spdlog::debug("Created vector game process with {0} games", gameCount_);
+}
+
+VectorGameProcess::~VectorGameProcess() {
+  // The background step uses the games, so it has to finish before they are destroyed
+  if (pendingStep_.valid()) {
+    pendingStep_.wait();
+  }
+
+  spdlog::debug("VectorGameProcess Destroyed");
+}
+
+void VectorGameProcess::setLevel(uint32_t levelId) {
+  assertNotStepping();
+
+  for (auto& gameProcess : gameProcesses_) {
+    gameProcess->setLevel(levelId);
+  }
+}
+
+void VectorGameProcess::setLevel(std::string levelString) {
+  assertNotStepping();
+
+  for (auto& gameProcess : gameProcesses_) {
+    gameProcess->setLevel(levelString);
+  }
+}
+
+void VectorGameProcess::init() {
+  assertNotStepping();
+
+  for (auto& gameProcess : gameProcesses_) {
+    gameProcess->init();
+  }
+}
+
+void VectorGameProcess::reset() {
+  assertNotStepping();
+
+  threadPool_->parallelFor(gameCount_, [this](uint32_t gameIdx) {
+    gameProcesses_[gameIdx]->reset();
+  });
+
+  resetObservationBuffer();
+
+  threadPool_->parallelFor(gameCount_, [this](uint32_t gameIdx) {
+    writeObservations(gameIdx);
+  });
+}
+
+void VectorGameProcess::resetObservationBuffer() {
+  // Rendering observers only know their memory layout once they have rendered a frame
+  if (playerObservers_[0][0]->getStrides().empty()) {
+    threadPool_->parallelFor(gameCount_, [this](uint32_t gameIdx) {
+      for (const auto& observer : playerObservers_[gameIdx]) {
+        observer->update();
+      }
+    });
+  }
+
+  const auto& firstObserver = playerObservers_[0][0];
+  auto observationShape = firstObserver->getShape();
+  auto observationStrides = firstObserver->getStrides();
+
+  for (const auto& playerObservers : playerObservers_) {
+    for (const auto& observer : playerObservers) {
+      if (observer->getShape() != observationShape || observer->getStrides() != observationStrides) {
+        throw std::invalid_argument("All player observations of a vector game process must have the same shape.");
+      }
+    }
+  }
+
+  // Observers can pad their dimensions, so the size is the span of the last element rather than the product of the shape
+  size_t observationSize = 1;
+  for (size_t d = 0; d < observationShape.size(); d++) {
+    observationSize += static_cast<size_t>(observationShape[d] - 1) * observationStrides[d];
+  }
+
+  observationShape_ = observationShape;
+  observationStrides_ = observationStrides;
+  observationSize_ = observationSize;
+
+  // Resizing can move the buffer, so the observers go back to their own buffers until it has been allocated
+  for (const auto& playerObservers : playerObservers_) {
+    for (const auto& observer : playerObservers) {
+      observer->setOutputBuffer(nullptr, {});
+    }
+  }
+
+  observations_.resize(gameCount_ * playerCount_ * observationSize_);
+  rewards_.assign(gameCount_ * playerCount_, 0);
+  dones_.assign(gameCount_, 0);
+
+  // Each observer renders straight into its slice of the buffer
+  for (uint32_t g = 0; g < gameCount_; g++) {
+    for (uint32_t p = 0; p < playerCount_; p++) {
+      playerObservers_[g][p]->setOutputBuffer(getObservationSlice(g, p), observationStrides_);
+    }
+  }
+}
+
+uint8_t* VectorGameProcess::getObservationSlice(uint32_t gameIdx, uint32_t playerIdx) {
+  return observations_.data() + (gameIdx * playerCount_ + playerIdx) * observationSize_;
+}
+
+void VectorGameProcess::writeObservations(uint32_t gameIdx) {
+  for (uint32_t p = 0; p < playerCount_; p++) {
+    auto* slice = getObservationSlice(gameIdx, p);
+    auto& observation = playerObservers_[gameIdx][p]->update();
+
+    // Only needed if a reset changed the shape of the observation, which stops the observer using the slice
+    if (&observation != slice) {
+      std::memcpy(slice, &observation, observationSize_);
+    }
+  }
+}
+
+void VectorGameProcess::step(const int32_t* actions, uint32_t actionSize) {
+  assertNotStepping();
+  validateStep(actionSize);
+  stepGames(actions, actionSize);
+}
+
+void VectorGameProcess::stepAsync(const int32_t* actions, uint32_t actionSize) {
+  assertNotStepping();
+  validateStep(actionSize);
+
+  asyncActions_.assign(actions, actions + gameCount_ * playerCount_ * actionSize);
+  pendingStep_ = std::async(std::launch::async, [this, actionSize] {
+    stepGames(asyncActions_.data(), actionSize);
+  });
+}
+
+void VectorGameProcess::waitForStep() {
+  if (!pendingStep_.valid()) {
+    throw std::runtime_error("There is no step to wait for, stepAsync has to be called first.");
+  }
+
+  // get() leaves the future empty even if the step threw, so the games can be used again afterwards
+  pendingStep_.get();
+}
+
+bool VectorGameProcess::isStepping() const {
+  return pendingStep_.valid();
+}
+
+void VectorGameProcess::assertNotStepping() const {
+  if (pendingStep_.valid()) {
+    throw std::runtime_error("The vector game process is still stepping, waitForStep has to be called first.");
+  }
+}
+
+void VectorGameProcess::validateStep(uint32_t actionSize) const {
+  if (observations_.empty()) {
+    throw std::runtime_error("Cannot step a vector game process before it has been reset.");
+  }
+
+  if (actionSize < 1 || actionSize > 4) {
+    auto error = fmt::format("Invalid action size, {0}", actionSize);
+    spdlog::error(error);
+    throw std::invalid_argument(error);
+  }
+}
+
+void VectorGameProcess::stepGames(const int32_t* actions, uint32_t actionSize) {
+  threadPool_->parallelFor(gameCount_, [this, actions, actionSize](uint32_t gameIdx) {
+    stepGame(gameIdx, actions, actionSize);
+  });
+}
+
+void VectorGameProcess::stepGame(uint32_t gameIdx, const int32_t* actions, uint32_t actionSize) {
+  const auto& gameProcess = gameProcesses_[gameIdx];
+  const auto* gameActions = actions + gameIdx * playerCount_ * actionSize;
+
+  ActionResult actionResult{};
+  for (uint32_t p = 0; p < playerCount_; p++) {
+    bool lastPlayer = p == playerCount_ - 1;
+
+    std::vector<std::shared_ptr<Action>> playerActions;
+    auto action = buildAction(gameIdx, p, gameActions + p * actionSize, actionSize);
+    if (action != nullptr) {
+      playerActions.push_back(action);
+    }
+
+    actionResult = gameProcess->performActions(p + 1, playerActions, lastPlayer);
+  }
+
+  for (uint32_t p = 0; p < playerCount_; p++) {
+    rewards_[gameIdx * playerCount_ + p] = gameProcess->getAccumulatedRewards(p + 1);
+  }
+
+  dones_[gameIdx] = actionResult.terminated;
+  if (actionResult.terminated) {
+    gameProcess->reset();
+  }
+
+  writeObservations(gameIdx);
+}
+
+std::shared_ptr<Action> VectorGameProcess::buildAction(uint32_t gameIdx, uint32_t playerIdx, const int32_t* actionArray, uint32_t actionSize) const {
+  int32_t actionTypeId = 0;
+  int32_t actionId = 0;
+  glm::ivec2 sourceLocation{};
+
+  switch (actionSize) {
+    case 1:
+      actionId = actionArray[0];
+      break;
+    case 2:
+      actionTypeId = actionArray[0];
+      actionId = actionArray[1];
+      break;
+    case 3:
+      sourceLocation = {actionArray[0], actionArray[1]};
+      actionId = actionArray[2];
+      break;
+    case 4:
+      sourceLocation = {actionArray[0], actionArray[1]};
+      actionTypeId = actionArray[2];
+      actionId = actionArray[3];
+      break;
+  }
+
+  if (actionTypeId < 0 || actionTypeId >= static_cast<int32_t>(externalActionNames_.size())) {
+    auto error = fmt::format("Invalid action type {0}", actionTypeId);
+    spdlog::error(error);
+    throw std::invalid_argument(error);
+  }
+
+  const auto& actionName = externalActionNames_[actionTypeId];
+  const auto& actionInputsDefinition = actionInputsDefinitions_[actionTypeId];
+  const auto& inputMappings = actionInputsDefinition.inputMappings;
+
+  auto inputMappingIt = inputMappings.find(actionId);
+  if (actionId < 0 || inputMappingIt == inputMappings.end()) {
+    return nullptr;
+  }
+
+  const auto& mapping = inputMappingIt->second;
+  const auto& player = players_[gameIdx][playerIdx];
+  auto playerAvatar = player->getAvatar();
+
+  auto action = gameProcesses_[gameIdx]->getGrid()->createAction(actionName, player->getId(), 0, mapping.metaData);
+  if (playerAvatar != nullptr) {
+    action->init(playerAvatar, mapping.vectorToDest, mapping.orientationVector, actionInputsDefinition.relative);
+  } else {
+    action->init(sourceLocation, sourceLocation + mapping.vectorToDest);
+  }
+
+  return action;
+}
+
+void VectorGameProcess::setThreadCount(uint32_t threadCount, bool pinThreads) {
+  assertNotStepping();
+
+  threadPool_ = std::make_unique<ThreadPool>(threadCount, pinThreads);
+}
+
+uint32_t VectorGameProcess::getThreadCount() const {
+  return threadPool_->getThreadCount();
+}
+
+void VectorGameProcess::seedRandomGenerator(uint32_t seed) {
+  assertNotStepping();
+
+  for (uint32_t g = 0; g < gameCount_; g++) {
+    gameProcesses_[g]->seedRandomGenerator(seed + g);
+  }
+}
+
+uint32_t VectorGameProcess::getGameCount() const {
+  return gameCount_;
+}
+
+uint32_t VectorGameProcess::getPlayerCount() const {
+  return playerCount_;
+}
+
+std::shared_ptr<TurnBasedGameProcess> VectorGameProcess::getGameProcess(uint32_t gameIdx) const {
+  return gameProcesses_.at(gameIdx);
+}
+
+const std::vector<int32_t>& VectorGameProcess::getRewards() const {
+  return rewards_;
+}
+
+const std::vector<uint8_t>& VectorGameProcess::getDones() const {
+  return dones_;
+}
+
+const std::vector<uint8_t>& VectorGameProcess::getObservations() const {
+  return observations_;
+}
+
+const std::vector<uint32_t>& VectorGameProcess::getObservationShape() const {
+  return observationShape_;
+}
+
+const std::vector<uint32_t>& VectorGameProcess::getObservationStrides() const {
+  return observationStrides_;
+}
+
+size_t VectorGameProcess::getObservationSize() const {
+  return observationSize_;
+}
+
+}  // namespace griddly
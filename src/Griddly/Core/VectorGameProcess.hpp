@@ -0,0 +1,116 @@
+#pragma once
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "GDY/Actions/Action.hpp"
+#include "TurnBasedGameProcess.hpp"
+#include "Util/ThreadPool.hpp"
+
+namespace griddly {
+
+class Player;
+class TensorObservationInterface;
+
+// Steps a batch of games created from the same GDY with a single call.
+// Rewards, dones and player observations of every game are written into buffers owned by this class, laid out as [games, ...],
+// so a trainer stepping hundreds of environments does not pay for one call and one set of results per environment.
+// Games that finish are reset straight away, the observations written for them are the first ones of the next episode.
+class VectorGameProcess {
+ public:
+  VectorGameProcess(uint32_t gameCount, std::string playerObserverName, std::shared_ptr<GDYFactory> gdyFactory);
+  ~VectorGameProcess();
+
+  // Set the level of every game by its id in the GDY description
+  void setLevel(uint32_t levelId);
+
+  // Use a custom level string for every game
+  void setLevel(std::string levelString);
+
+  void init();
+
+  // Resets every game and writes the first player observations. The buffers are reallocated if the observation shape has changed.
+  void reset();
+
+  // actions are int32 with shape [games, players, actionSize] in row-major order, actionSize is 1 to 4 and decoded the same way as a parallel step:
+  // [actionId], [actionType, actionId], [x, y, actionId] or [x, y, actionType, actionId]
+  void step(const int32_t* actions, uint32_t actionSize);
+
+  // Starts stepping the games on a background thread and returns straight away, so the caller can compute the next actions while the games are stepped.
+  // The actions are copied, so the caller's buffer can be reused. The buffers must not be read and nothing else can be called until waitForStep returns.
+  void stepAsync(const int32_t* actions, uint32_t actionSize);
+
+  // Blocks until the step started by stepAsync has finished, any error it raised is rethrown here
+  void waitForStep();
+
+  bool isStepping() const;
+
+  // Games are stepped and reset on threadCount threads, the calling thread being one of them. By default only the calling thread is used.
+  // If threadCount is 0 the hardware concurrency is used. Pinned threads each run on their own core.
+  void setThreadCount(uint32_t threadCount, bool pinThreads = false);
+  uint32_t getThreadCount() const;
+
+  // Each game is seeded with seed + its index so the games do not play out the same
+  void seedRandomGenerator(uint32_t seed);
+
+  uint32_t getGameCount() const;
+  uint32_t getPlayerCount() const;
+
+  std::shared_ptr<TurnBasedGameProcess> getGameProcess(uint32_t gameIdx) const;
+
+  // [games, players] accumulated rewards of the last step
+  const std::vector<int32_t>& getRewards() const;
+
+  // [games] 1 if the game finished in the last step and was reset
+  const std::vector<uint8_t>& getDones() const;
+
+  // [games, players, ...observation shape] player observations, each one in the memory layout of its observer
+  const std::vector<uint8_t>& getObservations() const;
+
+  // Shape and byte strides of a single player observation
+  const std::vector<uint32_t>& getObservationShape() const;
+  const std::vector<uint32_t>& getObservationStrides() const;
+
+  // Bytes between the observations of two players of the same game
+  size_t getObservationSize() const;
+
+ private:
+  void validateStep(uint32_t actionSize) const;
+  void assertNotStepping() const;
+  void stepGames(const int32_t* actions, uint32_t actionSize);
+  void stepGame(uint32_t gameIdx, const int32_t* actions, uint32_t actionSize);
+  std::shared_ptr<Action> buildAction(uint32_t gameIdx, uint32_t playerIdx, const int32_t* actionArray, uint32_t actionSize) const;
+  void resetObservationBuffer();
+  uint8_t* getObservationSlice(uint32_t gameIdx, uint32_t playerIdx);
+  void writeObservations(uint32_t gameIdx);
+
+  const uint32_t gameCount_;
+  const std::string playerObserverName_;
+  const std::shared_ptr<GDYFactory> gdyFactory_;
+  uint32_t playerCount_ = 0;
+
+  // Looked up once rather than on every step, indexed by the action type id
+  std::vector<std::string> externalActionNames_;
+  std::vector<ActionInputsDefinition> actionInputsDefinitions_;
+
+  std::vector<std::shared_ptr<TurnBasedGameProcess>> gameProcesses_;
+  std::unique_ptr<ThreadPool> threadPool_ = std::make_unique<ThreadPool>(1);
+
+  // [games][players]
+  std::vector<std::vector<std::shared_ptr<Player>>> players_;
+  std::vector<std::vector<std::shared_ptr<TensorObservationInterface>>> playerObservers_;
+
+  std::vector<int32_t> rewards_;
+  std::vector<uint8_t> dones_;
+  std::vector<uint8_t> observations_;
+  std::vector<uint32_t> observationShape_;
+  std::vector<uint32_t> observationStrides_;
+  size_t observationSize_ = 0;
+
+  // The step running in the background and the copy of its actions
+  std::future<void> pendingStep_;
+  std::vector<int32_t> asyncActions_;
+};
+
+}  // namespace griddly
@@ -0,0 +1,226 @@
+#include <algorithm>
+#include <memory>
+
+#include "Griddly/Core/DelayedActionQueue.hpp"
+#include "Mocks/Griddly/Core/GDY/Actions/MockAction.hpp"
+#include "Mocks/Griddly/Core/GDY/Objects/MockObject.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using ::testing::ElementsAre;
+using ::testing::Return;
+using ::testing::UnorderedElementsAre;
+
+namespace griddly {
+
+std::shared_ptr<Action> delayedQueueAction(std::shared_ptr<Object> sourceObject = nullptr) {
+  auto mockActionPtr = std::make_shared<MockAction>();
+  EXPECT_CALL(*mockActionPtr, getSourceObject()).WillRepeatedly(Return(sourceObject));
+  return mockActionPtr;
+}
+
+// Moves the queue to tick and takes every action that is ready
+std::vector<std::shared_ptr<Action>> advanceAndPopReady(DelayedActionQueue& queue, uint32_t tick) {
+  queue.advance(tick);
+
+  std::vector<std::shared_ptr<Action>> readyActions;
+  DelayedActionQueueItem item;
+  while (queue.popReady(item)) {
+    EXPECT_LE(item.priority, tick);
+    readyActions.push_back(item.action);
+  }
+  return readyActions;
+}
+
+TEST(DelayedActionQueueTest, executesActionsOnTheirTick) {
+  DelayedActionQueue queue;
+
+  auto action1 = delayedQueueAction();
+  auto action5 = delayedQueueAction();
+  queue.push(1, 5, action5);
+  queue.push(1, 1, action1);
+  ASSERT_EQ(queue.size(), 2);
+
+  ASSERT_THAT(advanceAndPopReady(queue, 1), ElementsAre(action1));
+  ASSERT_THAT(advanceAndPopReady(queue, 4), ElementsAre());
+  ASSERT_THAT(advanceAndPopReady(queue, 5), ElementsAre(action5));
+  ASSERT_TRUE(queue.empty());
+  ASSERT_EQ(queue.getCurrentTick(), 5);
+}
+
+TEST(DelayedActionQueueTest, cascadesFromLevelOne) {
+  DelayedActionQueue queue;
+
+  auto action256 = delayedQueueAction();
+  auto action300 = delayedQueueAction();
+  queue.push(1, 300, action300);
+  queue.push(1, 256, action256);
+
+  ASSERT_THAT(advanceAndPopReady(queue, 255), ElementsAre());
+  ASSERT_THAT(advanceAndPopReady(queue, 256), ElementsAre(action256));
+  ASSERT_THAT(advanceAndPopReady(queue, 299), ElementsAre());
+  ASSERT_THAT(advanceAndPopReady(queue, 300), ElementsAre(action300));
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(DelayedActionQueueTest, cascadesFromLevelTwo) {
+  DelayedActionQueue queue;
+
+  auto action65536 = delayedQueueAction();
+  auto action65539 = delayedQueueAction();
+  auto action70000 = delayedQueueAction();
+  queue.push(1, 70000, action70000);
+  queue.push(1, 65539, action65539);
+  queue.push(1, 65536, action65536);
+
+  ASSERT_THAT(advanceAndPopReady(queue, 65535), ElementsAre());
+  ASSERT_THAT(advanceAndPopReady(queue, 65536), ElementsAre(action65536));
+  ASSERT_THAT(advanceAndPopReady(queue, 65538), ElementsAre());
+  ASSERT_THAT(advanceAndPopReady(queue, 65539), ElementsAre(action65539));
+  ASSERT_THAT(advanceAndPopReady(queue, 69999), ElementsAre());
+  ASSERT_THAT(advanceAndPopReady(queue, 70000), ElementsAre(action70000));
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(DelayedActionQueueTest, cascadesFromLevelThree) {
+  DelayedActionQueue queue;
+
+  // Just before the top level digit of the tick changes, so the action goes through every level
+  uint32_t startTick = (1u << 24) - 10;
+  queue.setCurrentTick(startTick);
+
+  auto action = delayedQueueAction();
+  queue.push(1, startTick + 15, action);
+
+  ASSERT_THAT(advanceAndPopReady(queue, startTick + 14), ElementsAre());
+  ASSERT_THAT(advanceAndPopReady(queue, startTick + 15), ElementsAre(action));
+}
+
+TEST(DelayedActionQueueTest, sameTickActionsInSequenceOrder) {
+  DelayedActionQueue queue;
+
+  // The first action is cascaded from level one, the others are pushed straight to level zero once the wheel has reached 256
+  auto action1 = delayedQueueAction();
+  auto action2 = delayedQueueAction();
+  auto action3 = delayedQueueAction();
+  auto sequence1 = queue.push(1, 300, action1);
+  ASSERT_THAT(advanceAndPopReady(queue, 260), ElementsAre());
+  auto sequence2 = queue.push(2, 300, action2);
+  auto sequence3 = queue.push(1, 300, action3);
+
+  ASSERT_LT(sequence1, sequence2);
+  ASSERT_LT(sequence2, sequence3);
+  ASSERT_THAT(advanceAndPopReady(queue, 300), ElementsAre(action1, action2, action3));
+
+  // Actions that are not delayed past the current tick are ready in the order they were pushed
+  auto action4 = delayedQueueAction();
+  auto action5 = delayedQueueAction();
+  queue.push(1, 300, action4);
+  queue.push(1, 100, action5);
+  ASSERT_THAT(advanceAndPopReady(queue, 300), ElementsAre(action4, action5));
+}
+
+TEST(DelayedActionQueueTest, setCurrentTick) {
+  DelayedActionQueue queue;
+
+  auto action10 = delayedQueueAction();
+  auto action300 = delayedQueueAction();
+  queue.push(1, 10, action10);
+  queue.push(1, 300, action300);
+
+  // Actions that are no longer in the future are ready straight away
+  queue.setCurrentTick(200);
+  ASSERT_EQ(queue.getCurrentTick(), 200);
+  ASSERT_EQ(queue.size(), 2);
+  ASSERT_THAT(advanceAndPopReady(queue, 200), ElementsAre(action10));
+  ASSERT_THAT(advanceAndPopReady(queue, 299), ElementsAre());
+  ASSERT_THAT(advanceAndPopReady(queue, 300), ElementsAre(action300));
+}
+
+TEST(DelayedActionQueueTest, restore) {
+  DelayedActionQueue queue;
+
+  auto action1 = delayedQueueAction();
+  auto action2 = delayedQueueAction();
+  auto action3 = delayedQueueAction();
+  queue.push(1, 20, action1);
+  queue.push(1, 20, action2);
+  queue.push(1, 300, action3);
+
+  auto pendingActions = queue.getPendingActions();
+  ASSERT_EQ(pendingActions.size(), 3);
+  std::reverse(pendingActions.begin(), pendingActions.end());
+
+  // The restored actions keep their sequence numbers, whatever order they are restored in
+  DelayedActionQueue restoredQueue;
+  restoredQueue.restore(pendingActions, 10);
+  ASSERT_EQ(restoredQueue.getCurrentTick(), 10);
+  ASSERT_EQ(restoredQueue.size(), 3);
+
+  auto action4 = delayedQueueAction();
+  auto sequence4 = restoredQueue.push(1, 20, action4);
+  for (const auto& pendingAction : pendingActions) {
+    ASSERT_GT(sequence4, pendingAction.sequence);
+  }
+
+  ASSERT_THAT(advanceAndPopReady(restoredQueue, 20), ElementsAre(action1, action2, action4));
+  ASSERT_THAT(advanceAndPopReady(restoredQueue, 300), ElementsAre(action3));
+}
+
+TEST(DelayedActionQueueTest, cancel) {
+  DelayedActionQueue queue;
+
+  auto sourceObject = std::make_shared<MockObject>();
+  auto otherSourceObject = std::make_shared<MockObject>();
+
+  auto action1 = delayedQueueAction(sourceObject);
+  auto action2 = delayedQueueAction(otherSourceObject);
+  auto action3 = delayedQueueAction(sourceObject);
+  queue.push(1, 5, action1);
+  queue.push(1, 5, action2);
+  queue.push(1, 300, action3);
+
+  std::vector<DelayedActionQueueItem> cancelledActions;
+  queue.cancel(sourceObject, &cancelledActions);
+  ASSERT_EQ(cancelledActions.size(), 2);
+  ASSERT_THAT((std::vector<std::shared_ptr<Action>>{cancelledActions[0].action, cancelledActions[1].action}), UnorderedElementsAre(action1, action3));
+  ASSERT_EQ(queue.size(), 1);
+
+  ASSERT_THAT(advanceAndPopReady(queue, 300), ElementsAre(action2));
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(DelayedActionQueueTest, cancelReadyActions) {
+  DelayedActionQueue queue;
+
+  auto sourceObject = std::make_shared<MockObject>();
+  auto otherSourceObject = std::make_shared<MockObject>();
+
+  auto action1 = delayedQueueAction(sourceObject);
+  auto action2 = delayedQueueAction(otherSourceObject);
+  auto action3 = delayedQueueAction(sourceObject);
+  queue.push(1, 1, action1);
+  queue.push(1, 1, action2);
+  queue.push(1, 1, action3);
+
+  // The actions are in the ready list once the wheel reaches their tick, but have not been taken yet
+  queue.advance(1);
+
+  std::vector<DelayedActionQueueItem> cancelledActions;
+  queue.cancel(sourceObject, &cancelledActions);
+  ASSERT_EQ(cancelledActions.size(), 2);
+  ASSERT_EQ(queue.size(), 1);
+
+  DelayedActionQueueItem item;
+  ASSERT_TRUE(queue.popReady(item));
+  ASSERT_EQ(item.action, action2);
+  ASSERT_FALSE(queue.popReady(item));
+  ASSERT_TRUE(queue.empty());
+
+  // Cancelling again does nothing
+  cancelledActions.clear();
+  queue.cancel(sourceObject, &cancelledActions);
+  ASSERT_EQ(cancelledActions.size(), 0);
+}
+
+}  // namespace griddly
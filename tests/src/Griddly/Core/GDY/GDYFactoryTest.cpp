@@ -187,6 +187,90 @@ Environment:
   EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockObjectGeneratorPtr.get()));
 }
 
+TEST(GDYFactoryTest, loadEnvironment_VectorObserverConfig_format) {
+  auto mockObjectGeneratorPtr = std::make_shared<MockObjectGenerator>();
+  auto mockTerminationGeneratorPtr = std::make_shared<MockTerminationGenerator>();
+  auto gdyFactory = std::shared_ptr<GDYFactory>(new GDYFactory(mockObjectGeneratorPtr, mockTerminationGeneratorPtr, {}));
+  auto yamlString = R"(
+Environment:
+  Name: Test
+  Description: Test Description
+  Observers:
+    Vector:
+      Format: BIT_PACKED
+)";
+
+  auto environmentNode = loadFromStringAndGetNode(yamlString, "Environment");
+
+  gdyFactory->loadEnvironment(environmentNode);
+
+  auto config = gdyFactory->generateConfigForObserver<VectorObserverConfig>("VECTOR");
+
+  ASSERT_EQ(config.format, VectorObservationFormat::BIT_PACKED);
+  ASSERT_TRUE(config.objectLayers.empty());
+
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockTerminationGeneratorPtr.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockObjectGeneratorPtr.get()));
+}
+
+TEST(GDYFactoryTest, loadEnvironment_VectorObserverConfig_format_typeIds) {
+  auto mockObjectGeneratorPtr = std::make_shared<MockObjectGenerator>();
+  auto mockTerminationGeneratorPtr = std::make_shared<MockTerminationGenerator>();
+  auto gdyFactory = std::shared_ptr<GDYFactory>(new GDYFactory(mockObjectGeneratorPtr, mockTerminationGeneratorPtr, {}));
+  auto yamlString = R"(
+Environment:
+  Name: Test
+  Description: Test Description
+  Observers:
+    Vector:
+      Format: TYPE_IDS
+)";
+
+  std::map<std::string, std::shared_ptr<ObjectDefinition>> objectDefinitions;
+  uint32_t objectIdx = 0;
+  for (auto objectZIdx : {3, 0, 3, 1}) {
+    auto objectDefinition = std::make_shared<ObjectDefinition>();
+    objectDefinition->objectName = "object" + std::to_string(objectIdx++);
+    objectDefinition->zIdx = objectZIdx;
+    objectDefinitions[objectDefinition->objectName] = objectDefinition;
+  }
+
+  EXPECT_CALL(*mockObjectGeneratorPtr, getObjectDefinitions())
+      .WillRepeatedly(ReturnRef(objectDefinitions));
+
+  auto environmentNode = loadFromStringAndGetNode(yamlString, "Environment");
+
+  gdyFactory->loadEnvironment(environmentNode);
+
+  auto config = gdyFactory->generateConfigForObserver<VectorObserverConfig>("VECTOR");
+
+  ASSERT_EQ(config.format, VectorObservationFormat::TYPE_IDS);
+  ASSERT_THAT(config.objectLayers, ElementsAre(0, 1, 3));
+
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockTerminationGeneratorPtr.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockObjectGeneratorPtr.get()));
+}
+
+TEST(GDYFactoryTest, loadEnvironment_VectorObserverConfig_format_invalid) {
+  auto mockObjectGeneratorPtr = std::make_shared<MockObjectGenerator>();
+  auto mockTerminationGeneratorPtr = std::make_shared<MockTerminationGenerator>();
+  auto gdyFactory = std::shared_ptr<GDYFactory>(new GDYFactory(mockObjectGeneratorPtr, mockTerminationGeneratorPtr, {}));
+  auto yamlString = R"(
+Environment:
+  Name: Test
+  Description: Test Description
+  Observers:
+    Vector:
+      Format: JPEG
+)";
+
+  auto environmentNode = loadFromStringAndGetNode(yamlString, "Environment");
+
+  gdyFactory->loadEnvironment(environmentNode);
+
+  ASSERT_THROW(gdyFactory->generateConfigForObserver<VectorObserverConfig>("VECTOR"), std::invalid_argument);
+}
+
 TEST(GDYFactoryTest, loadEnvironment_Observer) {
   auto mockObjectGeneratorPtr = std::make_shared<MockObjectGenerator>();
   auto mockTerminationGeneratorPtr = std::make_shared<MockTerminationGenerator>();
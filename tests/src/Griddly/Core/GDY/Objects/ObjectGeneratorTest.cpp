@@ -73,4 +73,135 @@ TEST(ObjectGeneratorTest, cloneInstance) {
   ASSERT_THAT(clonedObject->getAvailableActionNames(), UnorderedElementsAre("actionA"));
 
 }
-}  // namespace griddly
\ No newline at end of file
+
+TEST(ObjectGeneratorTest, newInstanceSharesBehaviourTable) {
+  std::string objectAName = "objectA";
+  std::string objectBName = "objectB";
+  char mapCharacter = 'A';
+  uint32_t zIdx = 1;
+
+  ActionBehaviourDefinition mockBehaviourDefinition;
+
+  mockBehaviourDefinition.behaviourType = ActionBehaviourType::SOURCE;
+  mockBehaviourDefinition.sourceObjectName = objectAName;
+  mockBehaviourDefinition.destinationObjectName = objectBName;
+  mockBehaviourDefinition.actionName = "actionA";
+  mockBehaviourDefinition.commandName = "incr";
+  mockBehaviourDefinition.commandArguments = {{"0", _Y("variable1")}};
+
+  auto mockGridPtr = std::make_shared<MockGrid>();
+
+  std::map<std::string, std::unordered_map<uint32_t, std::shared_ptr<int32_t>>> globalVariables = {
+      {"globalVariable1", {{0, _V(1)}}},
+      {"globalVariable2", {{0, _V(1)}, {1, _V(2)}, {2, _V(3)}}},
+  };
+
+  EXPECT_CALL(*mockGridPtr, getGlobalVariables()).WillRepeatedly(ReturnRef(globalVariables));
+
+  auto objectGenerator = std::make_shared<ObjectGenerator>();
+
+  objectGenerator->defineNewObject(objectAName, mapCharacter, zIdx, {{"variable1", 10}});
+  objectGenerator->defineActionBehaviour(objectAName, mockBehaviourDefinition);
+
+  auto object1 = objectGenerator->newInstance(objectAName, 1, mockGridPtr);
+  auto object2 = objectGenerator->newInstance(objectAName, 2, mockGridPtr);
+
+  ASSERT_EQ(object1->getBehaviourTable(), object2->getBehaviourTable());
+  ASSERT_THAT(object2->getAvailableActionNames(), UnorderedElementsAre("actionA"));
+
+  // Local variables belong to each instance, global variables are shared
+  ASSERT_NE(object1->getVariableValue("variable1"), object2->getVariableValue("variable1"));
+  ASSERT_EQ(*object2->getVariableValue("variable1"), 10);
+  ASSERT_EQ(object1->getVariableValue("globalVariable1"), object2->getVariableValue("globalVariable1"));
+  ASSERT_EQ(*object1->getVariableValue("globalVariable2"), 2);
+  ASSERT_EQ(*object2->getVariableValue("globalVariable2"), 3);
+  ASSERT_EQ(*object2->getVariableValue("_playerId"), 2);
+
+  // Defining new behaviours means the table has to be recompiled
+  objectGenerator->defineActionBehaviour(objectAName, mockBehaviourDefinition);
+  auto object3 = objectGenerator->newInstance(objectAName, 1, mockGridPtr);
+
+  ASSERT_NE(object1->getBehaviourTable(), object3->getBehaviourTable());
+}
+
+TEST(ObjectGeneratorTest, newInstanceUsesVariableStore) {
+  std::string objectAName = "objectA";
+
+  auto mockGridPtr = std::make_shared<MockGrid>();
+
+  std::map<std::string, std::unordered_map<uint32_t, std::shared_ptr<int32_t>>> globalVariables = {};
+
+  EXPECT_CALL(*mockGridPtr, getGlobalVariables()).WillRepeatedly(ReturnRef(globalVariables));
+
+  auto objectGenerator = std::make_shared<ObjectGenerator>();
+
+  objectGenerator->defineNewObject(objectAName, 'A', 0, {{"variable1", 10}});
+
+  auto object1 = objectGenerator->newInstance(objectAName, 1, mockGridPtr);
+  auto object2 = objectGenerator->newInstance(objectAName, 2, mockGridPtr);
+
+  // Objects of the same type are rows of the same variable store
+  auto variableStore = object1->getVariableRow()->getVariableStore();
+  ASSERT_EQ(variableStore, object2->getVariableRow()->getVariableStore());
+  ASSERT_EQ(variableStore, mockGridPtr->getObjectVariableStores().at(objectAName));
+  ASSERT_EQ(variableStore->getRowCount(), 2);
+
+  auto variable1Column = object1->getBehaviourTable()->variableSlots.at("variable1");
+  *object2->getVariableValue("variable1") = 15;
+  ASSERT_EQ(variableStore->getColumnChunk(variable1Column, 0)[object1->getVariableRow()->getRow()], 10);
+  ASSERT_EQ(variableStore->getColumnChunk(variable1Column, 0)[object2->getVariableRow()->getRow()], 15);
+
+  // Rows are reused once an object is destroyed
+  auto object1Row = object1->getVariableRow()->getRow();
+  object1.reset();
+  ASSERT_FALSE(variableStore->isRowAllocated(object1Row));
+
+  auto object3 = objectGenerator->newInstance(objectAName, 1, mockGridPtr);
+  ASSERT_EQ(object3->getVariableRow()->getRow(), object1Row);
+  ASSERT_EQ(*object3->getVariableValue("variable1"), 10);
+  ASSERT_EQ(variableStore->getRowCount(), 2);
+}
+
+TEST(ObjectGeneratorTest, behaviourTablesUseGeneratorSymbols) {
+  std::string objectAName = "objectA";
+  std::string objectBName = "objectB";
+
+  ActionBehaviourDefinition mockBehaviourDefinition;
+
+  mockBehaviourDefinition.behaviourType = ActionBehaviourType::SOURCE;
+  mockBehaviourDefinition.sourceObjectName = objectAName;
+  mockBehaviourDefinition.destinationObjectName = objectBName;
+  mockBehaviourDefinition.actionName = "actionA";
+  mockBehaviourDefinition.commandName = "incr";
+  mockBehaviourDefinition.commandArguments = {{"0", _Y("variable1")}};
+
+  auto mockGridPtr = std::make_shared<MockGrid>();
+
+  std::map<std::string, std::unordered_map<uint32_t, std::shared_ptr<int32_t>>> globalVariables = {};
+
+  EXPECT_CALL(*mockGridPtr, getGlobalVariables()).WillRepeatedly(ReturnRef(globalVariables));
+
+  auto objectGenerator = std::make_shared<ObjectGenerator>();
+
+  objectGenerator->defineNewObject(objectAName, 'A', 0, {{"variable1", 10}});
+  objectGenerator->defineNewObject(objectBName, 'B', 0, {});
+  objectGenerator->defineActionBehaviour(objectAName, mockBehaviourDefinition);
+
+  // Names are interned when they are defined
+  const auto& actionSymbols = objectGenerator->getActionSymbols();
+  const auto& objectSymbols = objectGenerator->getObjectSymbols();
+  auto actionAId = actionSymbols->getId("actionA");
+  auto objectBId = objectSymbols->getId(objectBName);
+  ASSERT_NE(actionAId, SymbolTable::UNKNOWN_SYMBOL);
+  ASSERT_NE(objectBId, SymbolTable::UNKNOWN_SYMBOL);
+  ASSERT_EQ(objectSymbols->getName(objectBId), objectBName);
+
+  auto object = objectGenerator->newInstance(objectAName, 1, mockGridPtr);
+
+  const auto& behaviourTable = object->getBehaviourTable();
+  ASSERT_EQ(behaviourTable->actionSymbols, actionSymbols);
+  ASSERT_EQ(behaviourTable->objectSymbols, objectSymbols);
+  ASSERT_EQ(behaviourTable->srcBehaviours.at(actionAId).at(objectBId).instructions.size(), 1);
+}
+
+}  // namespace griddly
@@ -28,7 +28,7 @@ std::shared_ptr<MockAction> setupAction(std::string actionName, uint32_t origina
   auto mockActionPtr = std::make_shared<MockAction>();
 
   EXPECT_CALL(*mockActionPtr, getActionName())
-      .WillRepeatedly(Return(actionName));
+      .WillRepeatedly(ReturnRefOfCopy(actionName));
 
   EXPECT_CALL(*mockActionPtr, getSourceObject())
       .WillRepeatedly(Return(sourceObject));
@@ -55,7 +55,7 @@ std::shared_ptr<MockAction> setupAction(std::string actionName, std::shared_ptr<
   auto mockActionPtr = std::make_shared<MockAction>();
 
   EXPECT_CALL(*mockActionPtr, getActionName())
-      .WillRepeatedly(Return(actionName));
+      .WillRepeatedly(ReturnRefOfCopy(actionName));
 
   EXPECT_CALL(*mockActionPtr, getSourceObject())
       .WillRepeatedly(Return(sourceObject));
@@ -82,7 +82,7 @@ std::shared_ptr<MockAction> setupAction(std::string actionName, std::shared_ptr<
   auto mockActionPtr = std::make_shared<MockAction>();
 
   EXPECT_CALL(*mockActionPtr, getActionName())
-      .WillRepeatedly(Return(actionName));
+      .WillRepeatedly(ReturnRefOfCopy(actionName));
 
   EXPECT_CALL(*mockActionPtr, getSourceObject())
       .WillRepeatedly(Return(sourceObject));
@@ -106,7 +106,7 @@ std::shared_ptr<MockAction> setupAction(std::string actionName, std::shared_ptr<
   auto mockActionPtr = std::make_shared<MockAction>();
 
   EXPECT_CALL(*mockActionPtr, getActionName())
-      .WillRepeatedly(Return(actionName));
+      .WillRepeatedly(ReturnRefOfCopy(actionName));
 
   EXPECT_CALL(*mockActionPtr, getSourceObject())
       .WillRepeatedly(Return(sourceObject));
@@ -421,6 +421,31 @@ MATCHER_P4(SingletonActionVectorOriginatingPlayerMatcher, actionName, sourceObje
          action->getOriginatingPlayerId() == originatingPlayerId;
 }
 
+TEST(ObjectTest, isImmutable) {
+  auto wallObject = std::make_shared<Object>(Object("wall", 'W', 0, 0, {}, nullptr, std::weak_ptr<Grid>()));
+  wallObject->addActionDstBehaviour("move", "avatar", "nop", {}, {});
+  wallObject->addActionDstBehaviour("move", "box", "reward", {{"0", _Y("-1")}}, {});
+
+  ASSERT_TRUE(wallObject->isImmutable());
+
+  // A reward from a variable can change
+  auto variableRewardObject = std::make_shared<Object>(Object("variableReward", 'V', 0, 0, {{"penalty", _V(-1)}}, nullptr, std::weak_ptr<Grid>()));
+  variableRewardObject->addActionDstBehaviour("move", "avatar", "reward", {{"0", _Y("penalty")}}, {});
+
+  ASSERT_FALSE(variableRewardObject->isImmutable());
+
+  // Objects that can perform actions can change
+  auto srcObject = std::make_shared<Object>(Object("srcObject", 'S', 0, 0, {}, nullptr, std::weak_ptr<Grid>()));
+  srcObject->addActionSrcBehaviour("move", "wall", "nop", {}, {});
+
+  ASSERT_FALSE(srcObject->isImmutable());
+
+  auto avatarObject = std::make_shared<Object>(Object("avatar", 'A', 1, 0, {}, nullptr, std::weak_ptr<Grid>()));
+  avatarObject->markAsPlayerAvatar();
+
+  ASSERT_FALSE(avatarObject->isImmutable());
+}
+
 TEST(ObjectTest, command_reward) {
   auto srcObjectPtr = setupObject(1, "srcObject", {});
   auto dstObjectPtr = setupObject(3, "dstObject", {});
@@ -1309,6 +1334,43 @@ TEST(ObjectTest, command_eq_src_dst_qualifiers) {
   verifyMocks(mockActionPtr, mockGridPtr);
 }
 
+TEST(ObjectTest, command_eq_jumps_to_following_commands) {
+  //* - Src:
+  //*     Object: srcObject
+  //*     Commands:
+  //*       - eq:
+  //*           Arguments: [resource, 1]
+  //*           Commands:
+  //*             - decr: resource
+  //*       - incr: resource
+
+  auto mockGridPtr = mockGrid();
+  auto srcObjectPtr = setupObject("srcObject", {{"resource", _V(0)}}, mockGridPtr);
+  auto dstObjectPtr = setupObject("dstObject", {}, mockGridPtr);
+
+  auto mockActionPtr = setupAction("action", srcObjectPtr, dstObjectPtr);
+
+  srcObjectPtr->addActionSrcBehaviour("action", "dstObject", "eq", {{"0", _Y("resource")}, {"1", _Y("1")}}, {{"decr", {{"0", _Y("resource")}}}});
+  srcObjectPtr->addActionSrcBehaviour("action", "dstObject", "incr", {{"0", _Y("resource")}}, {});
+
+  // Both commands are compiled into one program, the condition jumps over its sub commands
+  const auto& behaviourTable = srcObjectPtr->getBehaviourTable();
+  auto actionId = behaviourTable->actionSymbols->getId("action");
+  auto dstObjectId = behaviourTable->objectSymbols->getId("dstObject");
+  const auto& program = behaviourTable->srcBehaviours.at(actionId).at(dstObjectId);
+  ASSERT_EQ(program.instructions.size(), 3);
+  ASSERT_EQ(program.instructions[0].opCode, BehaviourOpCode::EQ);
+  ASSERT_EQ(program.instructions[0].jumpTarget, 2);
+
+  auto srcResult = srcObjectPtr->onActionSrc("dstObject", mockActionPtr);
+
+  verifyCommandResult(srcResult, false, {});
+
+  ASSERT_EQ(*srcObjectPtr->getVariableValue("resource"), 1);
+
+  verifyMocks(mockActionPtr, mockGridPtr);
+}
+
 TEST(ObjectTest, command_eq_meta_qualifiers) {
   //* - Src:
   //*     Object: srcObject
@@ -1552,6 +1614,26 @@ TEST(ObjectTest, isValidActionDestinationLocationOutsideGrid) {
   verifyMocks(mockActionPtrValid);
 }
 
+TEST(ObjectTest, preconditionsReadGlobalVariables) {
+  auto dstObjectName = "dstObject";
+
+  // Variables that are not given a variable store are referenced like global variables
+  auto srcObject = std::make_shared<Object>(Object("srcObject", 'S', 0, 0, {{"counter", _V(5)}}, nullptr, std::weak_ptr<Grid>()));
+
+  srcObject->addPrecondition("local", dstObjectName, "eq", {{"0", _Y("_x")}, {"1", _Y("5")}});
+  srcObject->addPrecondition("meta", dstObjectName, "eq", {{"0", _Y("meta.range")}, {"1", _Y("src._y")}});
+  srcObject->addPrecondition("dst_local", dstObjectName, "gt", {{"0", _Y("dst.health")}, {"1", _Y("0")}});
+  srcObject->addPrecondition("global", dstObjectName, "eq", {{"0", _Y("counter")}, {"1", _Y("5")}});
+  srcObject->addPrecondition("dst_global", dstObjectName, "eq", {{"0", _Y("_x")}, {"1", _Y("dst.counter")}});
+
+  ASSERT_FALSE(srcObject->preconditionsReadGlobalVariables("local"));
+  ASSERT_FALSE(srcObject->preconditionsReadGlobalVariables("meta"));
+  ASSERT_FALSE(srcObject->preconditionsReadGlobalVariables("dst_local"));
+  ASSERT_TRUE(srcObject->preconditionsReadGlobalVariables("global"));
+  ASSERT_TRUE(srcObject->preconditionsReadGlobalVariables("dst_global"));
+  ASSERT_FALSE(srcObject->preconditionsReadGlobalVariables("no_preconditions"));
+}
+
 TEST(ObjectTest, getInitialActions) {
   auto mockGridPtr = std::make_shared<MockGrid>();
   auto mockObjectGenerator = std::make_shared<MockObjectGenerator>();
@@ -1610,7 +1692,7 @@ TEST(ObjectTest, getInitialActionsWithOriginatingAction) {
   auto mockActionPtr = std::make_shared<MockAction>();
 
   EXPECT_CALL(*mockActionPtr, getActionName())
-      .WillRepeatedly(Return(originatingActionName));
+      .WillRepeatedly(ReturnRefOfCopy(originatingActionName));
 
   EXPECT_CALL(*mockActionPtr, getSourceLocation())
       .WillRepeatedly(Return(glm::ivec2{3, 3}));
@@ -1,7 +1,10 @@
 #include <algorithm>
 #include <memory>
+#include <sstream>
 
 #include "Griddly/Core/TurnBasedGameProcess.cpp"
+#include "Griddly/Core/GDY/GDYFactory.hpp"
+#include "Griddly/Core/Players/Player.hpp"
 #include "Mocks/Griddly/Core/GDY/MockGDYFactory.hpp"
 #include "Mocks/Griddly/Core/GDY/MockTerminationHandler.hpp"
 #include "Mocks/Griddly/Core/GDY/Objects/MockObjectGenerator.hpp"
@@ -23,6 +26,7 @@ using ::testing::Eq;
 using ::testing::Mock;
 using ::testing::Return;
 using ::testing::ReturnRef;
+using ::testing::ReturnRefOfCopy;
 using ::testing::UnorderedElementsAreArray;
 
 namespace griddly {
@@ -656,6 +660,91 @@ TEST(GameProcessTest, performActionsDelayedReward) {
   EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockTerminationHandlerPtr.get()));
 }
 
+TEST(GameProcessTest, rollbackToCheckpoint) {
+  auto mockGridPtr = std::make_shared<MockGrid>();
+
+  std::map<std::string, std::unordered_map<uint32_t, std::shared_ptr<int32_t>>> globalVariables{};
+
+  EXPECT_CALL(*mockGridPtr, getTickCount())
+      .WillRepeatedly(Return(std::make_shared<int32_t>(0)));
+  EXPECT_CALL(*mockGridPtr, getGlobalVariables())
+      .WillRepeatedly(ReturnRef(globalVariables));
+  EXPECT_CALL(*mockGridPtr, getPlayerAvatarObjects())
+      .WillRepeatedly(Return(std::unordered_map<uint32_t, std::shared_ptr<Object>>{}));
+  EXPECT_CALL(*mockGridPtr, resetGlobalVariables(_))
+      .Times(2);
+
+  auto mockLevelGeneratorPtr = std::shared_ptr<MockLevelGenerator>(new MockLevelGenerator());
+  auto mockTerminationHandlerPtr = std::shared_ptr<MockTerminationHandler>(new MockTerminationHandler(mockGridPtr));
+  auto mockGDYFactoryPtr = std::shared_ptr<MockGDYFactory>(new MockGDYFactory());
+  auto mockObserverPtr = std::shared_ptr<MockObserver<>>(new MockObserver<>(mockGridPtr));
+
+  EXPECT_CALL(*mockLevelGeneratorPtr, reset(Eq(mockGridPtr)))
+      .Times(2);
+
+  EXPECT_CALL(*mockGDYFactoryPtr, getLevelGenerator)
+      .WillRepeatedly(Return(mockLevelGeneratorPtr));
+  EXPECT_CALL(*mockGDYFactoryPtr, getPlayerCount)
+      .WillRepeatedly(Return(1));
+  EXPECT_CALL(*mockGDYFactoryPtr, createTerminationHandler(Eq(mockGridPtr), _))
+      .WillRepeatedly(Return(mockTerminationHandlerPtr));
+  EXPECT_CALL(*mockGDYFactoryPtr, getGlobalVariableDefinitions())
+      .WillRepeatedly(Return(std::unordered_map<std::string, GlobalVariableDefinition>{}));
+  EXPECT_CALL(*mockGDYFactoryPtr, createObserver(Eq(mockGridPtr), Eq("NONE"), Eq(1), Eq(0)))
+      .WillOnce(Return(mockObserverPtr));
+
+  auto gameProcessPtr = std::make_shared<TurnBasedGameProcess>("NONE", mockGDYFactoryPtr, mockGridPtr);
+
+  auto mockPlayerPtr = mockPlayer("Bob", 1, gameProcessPtr, nullptr, mockObserverPtr);
+
+  gameProcessPtr->addPlayer(mockPlayerPtr);
+
+  gameProcessPtr->init();
+  gameProcessPtr->reset();
+
+  auto mockActionPtr = std::make_shared<MockAction>();
+
+  std::vector<std::shared_ptr<Action>> actionList{mockActionPtr};
+
+  EXPECT_CALL(*mockGridPtr, pushCheckpoint())
+      .Times(1);
+  EXPECT_CALL(*mockGridPtr, rollback())
+      .Times(1);
+
+  EXPECT_CALL(*mockGridPtr, performActions(Eq(1), Eq(actionList)))
+      .WillRepeatedly(Return(std::unordered_map<uint32_t, int32_t>{{1, 14}}));
+
+  EXPECT_CALL(*mockTerminationHandlerPtr, isTerminated)
+      .WillOnce(Return(TerminationResult{true, {}}))
+      .WillOnce(Return(TerminationResult{false, {}}));
+
+  EXPECT_CALL(*mockGridPtr, update())
+      .WillRepeatedly(Return(std::unordered_map<uint32_t, int32_t>{}));
+
+  gameProcessPtr->pushCheckpoint();
+  ASSERT_EQ(gameProcessPtr->getCheckpointCount(), 1);
+
+  auto result = gameProcessPtr->performActions(1, actionList);
+  ASSERT_TRUE(result.terminated);
+
+  gameProcessPtr->rollback();
+  ASSERT_EQ(gameProcessPtr->getCheckpointCount(), 0);
+
+  // The game is no longer terminated and the rewards since the checkpoint are gone
+  result = gameProcessPtr->performActions(1, actionList);
+  ASSERT_FALSE(result.terminated);
+  ASSERT_EQ(gameProcessPtr->getAccumulatedRewards(1), 14);
+
+  ASSERT_THROW(gameProcessPtr->rollback(), std::runtime_error);
+
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockGridPtr.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockPlayerPtr.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockObserverPtr.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockGDYFactoryPtr.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockLevelGeneratorPtr.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockTerminationHandlerPtr.get()));
+}
+
 TEST(GameProcessTest, getAvailableActionNames) {
   auto mockGridPtr = std::make_shared<MockGrid>();
   auto mockObject1 = mockObject("object", 'o', 0, 0, {0, 1}, DiscreteOrientation(), {"move", "internal"});
@@ -712,7 +801,7 @@ std::shared_ptr<MockAction> mockTestAction(std::string actionName, glm::ivec2 ve
   auto mockActionPtr = std::make_shared<MockAction>();
 
   EXPECT_CALL(*mockActionPtr, getActionName())
-      .WillRepeatedly(Return(actionName));
+      .WillRepeatedly(ReturnRefOfCopy(actionName));
 
   EXPECT_CALL(*mockActionPtr, getVectorToDest())
       .WillRepeatedly(Return(vectorToDest));
@@ -786,6 +875,77 @@ TEST(GameProcessTest, getAvailableIdsForActionType) {
   EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockGDYFactoryPtr.get()));
 }
 
+TEST(GameProcessTest, writeValidActionMask) {
+  auto mockGridPtr = std::make_shared<MockGrid>();
+
+  auto mockObject1 = mockObject("object", 'o', 1, 0, {0, 1}, DiscreteOrientation(), {"move", "attack", "internal"});
+  auto mockObject2 = mockObject("object", 'o', 2, 0, {1, 1}, DiscreteOrientation(), {"move"});
+  auto mockObject3 = mockObject("object", 'o', 1, 0, {2, 0}, DiscreteOrientation(), {"attack"});
+
+  auto objects = std::unordered_set<std::shared_ptr<Object>>{mockObject1, mockObject2, mockObject3};
+
+  EXPECT_CALL(*mockGridPtr, getObjects()).WillRepeatedly(ReturnRef(objects));
+  EXPECT_CALL(*mockGridPtr, getWidth()).WillRepeatedly(Return(3));
+  EXPECT_CALL(*mockGridPtr, getHeight()).WillRepeatedly(Return(2));
+
+  auto mockGDYFactoryPtr = std::make_shared<MockGDYFactory>();
+
+  std::unordered_map<std::string, ActionInputsDefinition> mockActionInputsDefinitions = {
+      {"move",
+       {{{1, {{0, 1}, {0, 0}, "First Action"}},
+         {2, {{0, 2}, {0, 0}, "Second Action"}}},
+        false,
+        false}},
+      {"attack",
+       {{{1, {{1, 0}, {0, 0}, "First Action"}},
+         {2, {{2, 0}, {0, 0}, "Second Action"}},
+         {3, {{3, 0}, {0, 0}, "Third Action"}}},
+        false,
+        false}},
+      {"internal", {{{1, {{0, 1}, {0, 0}, "Internal Action"}}}, false, true}}};
+
+  EXPECT_CALL(*mockGDYFactoryPtr, getActionInputsDefinitions).WillRepeatedly(Return(mockActionInputsDefinitions));
+  EXPECT_CALL(*mockGDYFactoryPtr, getExternalActionNames).WillRepeatedly(Return(std::vector<std::string>{"attack", "move"}));
+
+  EXPECT_CALL(*mockObject1, isValidAction(ActionAndVectorEqMatcher("move", glm::ivec2{0, 1}))).WillOnce(Return(false));
+  EXPECT_CALL(*mockObject1, isValidAction(ActionAndVectorEqMatcher("move", glm::ivec2{0, 2}))).WillOnce(Return(true));
+  EXPECT_CALL(*mockObject1, isValidAction(ActionAndVectorEqMatcher("attack", glm::ivec2{1, 0}))).WillOnce(Return(false));
+  EXPECT_CALL(*mockObject1, isValidAction(ActionAndVectorEqMatcher("attack", glm::ivec2{2, 0}))).WillOnce(Return(false));
+  EXPECT_CALL(*mockObject1, isValidAction(ActionAndVectorEqMatcher("attack", glm::ivec2{3, 0}))).WillOnce(Return(false));
+
+  EXPECT_CALL(*mockObject3, isValidAction(ActionAndVectorEqMatcher("attack", glm::ivec2{1, 0}))).WillOnce(Return(true));
+  EXPECT_CALL(*mockObject3, isValidAction(ActionAndVectorEqMatcher("attack", glm::ivec2{2, 0}))).WillOnce(Return(false));
+  EXPECT_CALL(*mockObject3, isValidAction(ActionAndVectorEqMatcher("attack", glm::ivec2{3, 0}))).WillOnce(Return(true));
+
+  auto gameProcessPtr = std::make_shared<TurnBasedGameProcess>("NONE", mockGDYFactoryPtr, mockGridPtr);
+
+  ASSERT_THAT(gameProcessPtr->getValidActionMaskShape(), ElementsAre(3, 2, 2, 4));
+
+  // Stale values are cleared
+  std::vector<uint8_t> mask(3 * 2 * 2 * 4, 1);
+  gameProcessPtr->writeValidActionMask(1, mask.data());
+
+  auto maskAt = [&mask](uint32_t x, uint32_t y, uint32_t actionTypeId) {
+    auto offset = ((x * 2 + y) * 2 + actionTypeId) * 4;
+    return std::vector<uint8_t>(mask.begin() + offset, mask.begin() + offset + 4);
+  };
+
+  // Attack is action type 0 and move is action type 1
+  ASSERT_THAT(maskAt(0, 1, 0), ElementsAre(0, 0, 0, 0));
+  ASSERT_THAT(maskAt(0, 1, 1), ElementsAre(1, 0, 1, 0));
+  ASSERT_THAT(maskAt(2, 0, 0), ElementsAre(1, 1, 0, 1));
+  ASSERT_THAT(maskAt(2, 0, 1), ElementsAre(0, 0, 0, 0));
+
+  // The other player's object is not in the mask
+  ASSERT_THAT(maskAt(1, 1, 1), ElementsAre(0, 0, 0, 0));
+  ASSERT_EQ(std::count(mask.begin(), mask.end(), 1), 5);
+
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockObject1.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockObject3.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockGridPtr.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockGDYFactoryPtr.get()));
+}
+
 TEST(GameProcessTest, getState) {
   auto mockGridPtr = std::make_shared<MockGrid>();
 
@@ -902,4 +1062,473 @@ TEST(GameProcessTest, clone) {
   }
 }
 
+// Two players with one unit each. Moving increments a global, a per-player and a local variable, and delays a charge of the unit
+const std::string saveStateGDY = R"(
+Version: "0.1"
+Environment:
+  Name: Save State Game
+  Player:
+    Count: 2
+  Variables:
+    - Name: moves
+      InitialValue: 0
+    - Name: player_moves
+      InitialValue: 0
+      PerPlayer: true
+  Levels:
+    - |
+      u1 .  .  .
+      .  .  .  .
+      .  .  .  u2
+    - |
+      u1 .  .  .  .
+      .  .  .  .  u2
+
+Actions:
+  - Name: charge
+    InputMapping:
+      Internal: true
+      Inputs:
+        1:
+          VectorToDest: [0, 0]
+    Behaviours:
+      - Src:
+          Object: unit
+          Commands:
+            - incr: charges
+        Dst:
+          Object: unit
+  - Name: move
+    Behaviours:
+      - Src:
+          Object: unit
+          Commands:
+            - mov: _dest
+            - incr: moves
+            - incr: player_moves
+            - incr: steps_taken
+            - exec:
+                Action: charge
+                ActionId: 1
+                Delay: 5
+        Dst:
+          Object: _empty
+
+Objects:
+  - Name: unit
+    MapCharacter: u
+    Variables:
+      - Name: steps_taken
+        InitialValue: 0
+      - Name: charges
+        InitialValue: 0
+)";
+
+struct SaveStateGame {
+  std::shared_ptr<GDYFactory> gdyFactory;
+  std::shared_ptr<Grid> grid;
+  std::shared_ptr<TurnBasedGameProcess> gameProcess;
+};
+
+SaveStateGame createSaveStateGame(uint32_t levelId = 0, const std::string& gdy = saveStateGDY) {
+  SaveStateGame game;
+  game.gdyFactory = std::make_shared<GDYFactory>(GDYFactory(std::make_shared<ObjectGenerator>(ObjectGenerator()), std::make_shared<TerminationGenerator>(TerminationGenerator()), {}));
+  std::istringstream stream(gdy);
+  game.gdyFactory->parseFromStream(stream);
+
+  game.grid = std::make_shared<Grid>();
+  game.gameProcess = std::make_shared<TurnBasedGameProcess>("NONE", game.gdyFactory, game.grid);
+  for (uint32_t playerId = 1; playerId <= 2; playerId++) {
+    game.gameProcess->addPlayer(std::make_shared<Player>(playerId, "player", nullptr, game.gameProcess));
+  }
+
+  game.gameProcess->setLevel(levelId);
+  game.gameProcess->init();
+  game.gameProcess->reset();
+  return game;
+}
+
+// Performs an action (a move by default) of the unit at location, or only moves the game forward a tick if there is no action
+void stepSaveStateGame(SaveStateGame& game, uint32_t playerId, glm::ivec2 location = {-1, -1}, uint32_t actionId = 0, const std::string& actionName = "move") {
+  std::vector<std::shared_ptr<Action>> actions;
+  if (actionId != 0) {
+    const auto& mapping = game.gdyFactory->findActionInputsDefinition(actionName).inputMappings.at(actionId);
+    auto action = game.grid->createAction(actionName, playerId, 0, mapping.metaData);
+    action->init(location, location + mapping.vectorToDest);
+    actions.push_back(action);
+  }
+  game.gameProcess->performActions(playerId, actions, true);
+}
+
+std::map<std::pair<std::string, uint32_t>, int32_t> getSaveStateGlobalValues(const SaveStateGame& game) {
+  std::map<std::pair<std::string, uint32_t>, int32_t> globalValues;
+  for (const auto& globalVariableIt : game.grid->getGlobalVariables()) {
+    for (const auto& playerValueIt : globalVariableIt.second) {
+      globalValues[{globalVariableIt.first, playerValueIt.first}] = *playerValueIt.second;
+    }
+  }
+  return globalValues;
+}
+
+// The execution tick, player, action and source location of every pending delayed action
+std::vector<std::tuple<uint32_t, uint32_t, std::string, glm::ivec2>> getSaveStatePendingActions(const SaveStateGame& game) {
+  std::vector<std::tuple<uint32_t, uint32_t, std::string, glm::ivec2>> pendingActions;
+  for (const auto& pendingAction : game.grid->getDelayedActions().getPendingActions()) {
+    pendingActions.emplace_back(pendingAction.priority, pendingAction.playerId, pendingAction.action->getActionName(), pendingAction.action->getSourceObject()->getLocation());
+  }
+  std::sort(pendingActions.begin(), pendingActions.end(), [](const auto& a, const auto& b) {
+    return std::get<0>(a) != std::get<0>(b) ? std::get<0>(a) < std::get<0>(b) : std::get<1>(a) < std::get<1>(b);
+  });
+  return pendingActions;
+}
+
+std::vector<int32_t> getUnitVariableValues(const SaveStateGame& game, const std::string& variableName) {
+  std::vector<int32_t> values;
+  for (uint32_t playerId = 1; playerId <= 2; playerId++) {
+    for (const auto& object : game.grid->getObjects()) {
+      if (object->getPlayerId() == playerId) {
+        values.push_back(*object->getVariableValue(variableName));
+      }
+    }
+  }
+  return values;
+}
+
+TEST(GameProcessTest, saveAndLoadState) {
+  auto game = createSaveStateGame();
+  game.gameProcess->seedRandomGenerator(1234);
+
+  stepSaveStateGame(game, 1, {0, 0}, 3);
+  stepSaveStateGame(game, 2, {3, 2}, 1);
+  stepSaveStateGame(game, 1, {1, 0}, 4);
+
+  auto savedHash = game.gameProcess->getState().hash;
+  auto savedGlobalValues = getSaveStateGlobalValues(game);
+  auto savedPendingActions = getSaveStatePendingActions(game);
+  ASSERT_EQ(*game.grid->getTickCount(), 3);
+  ASSERT_EQ(savedGlobalValues.at({"moves", 0}), 3);
+  ASSERT_EQ(savedGlobalValues.at({"player_moves", 1}), 2);
+  ASSERT_EQ(savedGlobalValues.at({"player_moves", 2}), 1);
+  ASSERT_EQ(savedPendingActions.size(), 3);
+
+  auto state = game.gameProcess->saveState();
+
+  // The random numbers that follow the saved state
+  auto randomGenerator = game.grid->getRandomGenerator();
+  std::vector<int32_t> expectedSamples{randomGenerator->sampleInt(0, 1000000), randomGenerator->sampleInt(0, 1000000), randomGenerator->sampleInt(0, 1000000)};
+
+  // The first two delayed charges are executed and a unit moves again
+  stepSaveStateGame(game, 2, {2, 2}, 2);
+  for (uint32_t tick = 0; tick < 2; tick++) {
+    stepSaveStateGame(game, 1);
+  }
+  ASSERT_EQ(getSaveStatePendingActions(game).size(), 2);
+  ASSERT_THAT(getUnitVariableValues(game, "charges"), ElementsAre(1, 1));
+  ASSERT_NE(game.gameProcess->getState().hash, savedHash);
+
+  game.gameProcess->loadState(state);
+
+  ASSERT_EQ(game.gameProcess->getState().hash, savedHash);
+  ASSERT_EQ(*game.grid->getTickCount(), 3);
+  ASSERT_EQ(getSaveStateGlobalValues(game), savedGlobalValues);
+  ASSERT_EQ(getSaveStatePendingActions(game), savedPendingActions);
+  ASSERT_THAT(getUnitVariableValues(game, "steps_taken"), ElementsAre(2, 1));
+  ASSERT_THAT(getUnitVariableValues(game, "charges"), ElementsAre(0, 0));
+  ASSERT_EQ(game.grid->getObject({1, 1})->getPlayerId(), 1);
+  ASSERT_EQ(game.grid->getObject({2, 2})->getPlayerId(), 2);
+
+  randomGenerator = game.grid->getRandomGenerator();
+  std::vector<int32_t> samples{randomGenerator->sampleInt(0, 1000000), randomGenerator->sampleInt(0, 1000000), randomGenerator->sampleInt(0, 1000000)};
+  ASSERT_EQ(samples, expectedSamples);
+
+  // The restored delayed actions are executed on the ticks they were saved with
+  for (uint32_t tick = 0; tick < 3; tick++) {
+    stepSaveStateGame(game, 1);
+  }
+  ASSERT_THAT(getUnitVariableValues(game, "charges"), ElementsAre(1, 1));
+  stepSaveStateGame(game, 1);
+  ASSERT_THAT(getUnitVariableValues(game, "charges"), ElementsAre(2, 1));
+  ASSERT_EQ(getSaveStatePendingActions(game).size(), 0);
+}
+
+TEST(GameProcessTest, loadStateRejectsInvalidBuffers) {
+  auto game = createSaveStateGame();
+  stepSaveStateGame(game, 1, {0, 0}, 3);
+  auto state = game.gameProcess->saveState();
+
+  stepSaveStateGame(game, 2, {3, 2}, 1);
+  auto hash = game.gameProcess->getState().hash;
+  auto globalValues = getSaveStateGlobalValues(game);
+  auto pendingActions = getSaveStatePendingActions(game);
+
+  auto truncatedState = state;
+  truncatedState.resize(state.size() - 1);
+  ASSERT_THROW(game.gameProcess->loadState(truncatedState), std::invalid_argument);
+
+  truncatedState.resize(6);
+  ASSERT_THROW(game.gameProcess->loadState(truncatedState), std::invalid_argument);
+
+  auto extendedState = state;
+  extendedState.push_back(0);
+  ASSERT_THROW(game.gameProcess->loadState(extendedState), std::invalid_argument);
+
+  // The magic number and the version are the first two words of the buffer
+  auto wrongMagicState = state;
+  wrongMagicState[0] ^= 0xFF;
+  ASSERT_THROW(game.gameProcess->loadState(wrongMagicState), std::invalid_argument);
+
+  auto wrongVersionState = state;
+  wrongVersionState[4] += 1;
+  ASSERT_THROW(game.gameProcess->loadState(wrongVersionState), std::invalid_argument);
+
+  auto otherSizeGame = createSaveStateGame(1);
+  ASSERT_THROW(game.gameProcess->loadState(otherSizeGame.gameProcess->saveState()), std::invalid_argument);
+
+  // None of the failed loads changed the game
+  ASSERT_EQ(game.gameProcess->getState().hash, hash);
+  ASSERT_EQ(*game.grid->getTickCount(), 2);
+  ASSERT_EQ(getSaveStateGlobalValues(game), globalValues);
+  ASSERT_EQ(getSaveStatePendingActions(game), pendingActions);
+
+  game.gameProcess->loadState(state);
+  ASSERT_EQ(*game.grid->getTickCount(), 1);
+  ASSERT_EQ(getSaveStatePendingActions(game).size(), 1);
+}
+
+std::map<std::pair<int32_t, int32_t>, uint32_t> getSaveStateEntityIds(const SaveStateGame& game) {
+  std::map<std::pair<int32_t, int32_t>, uint32_t> entityIds;
+  for (const auto& object : game.grid->getObjects()) {
+    entityIds[{object->getLocation().x, object->getLocation().y}] = object->getEntityId();
+  }
+  return entityIds;
+}
+
+TEST(GameProcessTest, loadStateRestoresEntityIds) {
+  auto game = createSaveStateGame();
+  stepSaveStateGame(game, 1, {0, 0}, 3);
+
+  auto savedEntityIds = getSaveStateEntityIds(game);
+  auto savedNextEntityId = game.grid->getNextEntityId();
+  ASSERT_EQ(savedEntityIds.size(), 2);
+  ASSERT_EQ(savedNextEntityId, 3);
+
+  auto state = game.gameProcess->saveState();
+
+  // The unit of player 1 is replaced by two new units, which can be reused for it when the state is loaded
+  auto objectGenerator = game.gdyFactory->getObjectGenerator();
+  ASSERT_TRUE(game.grid->removeObject(game.grid->getObject({1, 0})));
+  game.grid->addObject({0, 2}, objectGenerator->newInstance("unit", 1, game.grid));
+  game.grid->addObject({3, 0}, objectGenerator->newInstance("unit", 1, game.grid));
+  stepSaveStateGame(game, 2, {3, 2}, 1);
+  ASSERT_EQ(game.grid->getNextEntityId(), 5);
+
+  game.gameProcess->loadState(state);
+  ASSERT_EQ(getSaveStateEntityIds(game), savedEntityIds);
+  ASSERT_EQ(game.grid->getNextEntityId(), savedNextEntityId);
+
+  // Loading the state again after more objects are added gives the same ids
+  game.grid->addObject({0, 2}, objectGenerator->newInstance("unit", 2, game.grid));
+  game.gameProcess->loadState(state);
+  ASSERT_EQ(getSaveStateEntityIds(game), savedEntityIds);
+  ASSERT_EQ(game.grid->getNextEntityId(), savedNextEntityId);
+
+  auto newUnit = objectGenerator->newInstance("unit", 2, game.grid);
+  game.grid->addObject({0, 2}, newUnit);
+  ASSERT_EQ(newUnit->getEntityId(), savedNextEntityId);
+}
+
+// Both units delay an action, but the unit of player 1 removes itself first
+const std::string removedSourceGDY = R"(
+Version: "0.1"
+Environment:
+  Name: Removed Source Game
+  Player:
+    Count: 2
+  Variables:
+    - Name: delayed_actions
+      InitialValue: 0
+  Levels:
+    - |
+      u1 .  u2
+
+Actions:
+  - Name: count_delayed
+    InputMapping:
+      Internal: true
+      Inputs:
+        1:
+          VectorToDest: [0, 0]
+    Behaviours:
+      - Src:
+          Object: unit
+          Commands:
+            - incr: delayed_actions
+        Dst:
+          Object: [unit, _empty]
+  - Name: expire
+    InputMapping:
+      Inputs:
+        1:
+          VectorToDest: [0, 0]
+    Behaviours:
+      - Src:
+          Object: unit
+          Commands:
+            - remove: true
+            - exec:
+                Action: count_delayed
+                ActionId: 1
+                Delay: 2
+        Dst:
+          Object: unit
+  - Name: wait
+    InputMapping:
+      Inputs:
+        1:
+          VectorToDest: [0, 0]
+    Behaviours:
+      - Src:
+          Object: unit
+          Commands:
+            - exec:
+                Action: count_delayed
+                ActionId: 1
+                Delay: 2
+        Dst:
+          Object: unit
+
+Objects:
+  - Name: unit
+    MapCharacter: u
+)";
+
+TEST(GameProcessTest, delayedActionOfRemovedSourceIsNotExecuted) {
+  auto game = createSaveStateGame(0, removedSourceGDY);
+
+  stepSaveStateGame(game, 1, {0, 0}, 1, "expire");
+  stepSaveStateGame(game, 2, {2, 0}, 1, "wait");
+  ASSERT_EQ(game.grid->getObject({0, 0}), nullptr);
+  ASSERT_EQ(getSaveStatePendingActions(game).size(), 1);
+
+  for (uint32_t tick = 0; tick < 3; tick++) {
+    stepSaveStateGame(game, 1);
+  }
+
+  // Only the action delayed by the unit that is still in the grid is executed
+  ASSERT_EQ(getSaveStatePendingActions(game).size(), 0);
+  ASSERT_EQ(getSaveStateGlobalValues(game).at({"delayed_actions", 0}), 1);
+}
+
+// Delayed actions that set a global to 1 or 2, so its value shows which of them was executed last
+const std::string delayedOrderGDY = R"(
+Version: "0.1"
+Environment:
+  Name: Delayed Order Game
+  Player:
+    Count: 2
+  Variables:
+    - Name: last_set
+      InitialValue: 0
+  Levels:
+    - |
+      u1 .  u2
+
+Actions:
+  - Name: set_one
+    InputMapping:
+      Internal: true
+      Inputs:
+        1:
+          VectorToDest: [0, 0]
+    Behaviours:
+      - Src:
+          Object: unit
+          Commands:
+            - set: [last_set, 1]
+        Dst:
+          Object: unit
+  - Name: set_two
+    InputMapping:
+      Internal: true
+      Inputs:
+        1:
+          VectorToDest: [0, 0]
+    Behaviours:
+      - Src:
+          Object: unit
+          Commands:
+            - set: [last_set, 2]
+        Dst:
+          Object: unit
+  - Name: set_one_later
+    InputMapping:
+      Inputs:
+        1:
+          VectorToDest: [0, 0]
+    Behaviours:
+      - Src:
+          Object: unit
+          Commands:
+            - exec:
+                Action: set_one
+                ActionId: 1
+                Delay: 5
+        Dst:
+          Object: unit
+  - Name: set_two_later
+    InputMapping:
+      Inputs:
+        1:
+          VectorToDest: [0, 0]
+    Behaviours:
+      - Src:
+          Object: unit
+          Commands:
+            - exec:
+                Action: set_two
+                ActionId: 1
+                Delay: 2
+        Dst:
+          Object: unit
+
+Objects:
+  - Name: unit
+    MapCharacter: u
+)";
+
+TEST(GameProcessTest, loadStateKeepsOrderOfSameTickDelayedActions) {
+  auto game = createSaveStateGame(0, delayedOrderGDY);
+
+  // The first action is executed before the last one is queued, which then reuses its entry in the queue
+  stepSaveStateGame(game, 1, {0, 0}, 1, "set_two_later");
+  stepSaveStateGame(game, 1, {0, 0}, 1, "set_one_later");
+  stepSaveStateGame(game, 1);
+  stepSaveStateGame(game, 1);
+  ASSERT_EQ(getSaveStatePendingActions(game).size(), 1);
+  stepSaveStateGame(game, 1, {0, 0}, 1, "set_two_later");
+
+  auto pendingActions = getSaveStatePendingActions(game);
+  ASSERT_EQ(pendingActions.size(), 2);
+  ASSERT_EQ(std::get<0>(pendingActions[0]), std::get<0>(pendingActions[1]));
+
+  // The queue lists its actions by entry, so the last action queued comes first
+  ASSERT_EQ(game.grid->getDelayedActions().getPendingActions()[0].action->getActionName(), "set_two");
+
+  auto state = game.gameProcess->saveState();
+
+  for (uint32_t tick = 0; tick < 2; tick++) {
+    stepSaveStateGame(game, 1);
+  }
+  ASSERT_EQ(getSaveStatePendingActions(game).size(), 0);
+  ASSERT_EQ(getSaveStateGlobalValues(game).at({"last_set", 0}), 2);
+
+  // The restored actions are executed in the order they were queued in the original game
+  game.gameProcess->loadState(state);
+  for (uint32_t tick = 0; tick < 2; tick++) {
+    stepSaveStateGame(game, 1);
+  }
+  ASSERT_EQ(getSaveStatePendingActions(game).size(), 0);
+  ASSERT_EQ(getSaveStateGlobalValues(game).at({"last_set", 0}), 2);
+}
+
 }  // namespace griddly
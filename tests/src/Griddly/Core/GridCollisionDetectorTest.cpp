@@ -0,0 +1,209 @@
+#include <chrono>
+#include <cmath>
+#include <random>
+
+#include "Griddly/Core/GridCollisionDetector.cpp"
+#include "Griddly/Core/SpatialHashCollisionDetector.hpp"
+#include "Griddly/Core/TestUtils/common.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "spdlog/spdlog.h"
+
+using ::testing::ElementsAre;
+using ::testing::Eq;
+using ::testing::Mock;
+using ::testing::Return;
+using ::testing::ReturnRefOfCopy;
+using ::testing::UnorderedElementsAre;
+
+namespace griddly {
+
+std::shared_ptr<MockObject> static mockObjectAt(std::string objectName, glm::ivec2 location) {
+  return mockObject(objectName, '?', 1, 0, location);
+}
+
+TEST(GridCollisionDetectorTest, test_upsert_object) {
+  auto collisionDetector = std::shared_ptr<CollisionDetector>(new GridCollisionDetector(10, 10, 1, TriggerType::RANGE_BOX_AREA));
+
+  auto mockObjectPtr = mockObjectAt("object", {0, 0});
+
+  ASSERT_TRUE(collisionDetector->upsert(mockObjectPtr));
+  ASSERT_THAT(collisionDetector->search({0, 0}).objectSet, UnorderedElementsAre(mockObjectPtr));
+
+  EXPECT_CALL(*mockObjectPtr, getLocation()).WillRepeatedly(ReturnRefOfCopy(glm::ivec2(5, 5)));
+
+  ASSERT_FALSE(collisionDetector->upsert(mockObjectPtr));
+
+  // The object is only found at the location it moved to
+  ASSERT_EQ(collisionDetector->search({0, 0}).objectSet.size(), 0);
+  ASSERT_THAT(collisionDetector->search({5, 5}).objectSet, UnorderedElementsAre(mockObjectPtr));
+}
+
+TEST(GridCollisionDetectorTest, test_remove_object) {
+  auto collisionDetector = std::shared_ptr<CollisionDetector>(new GridCollisionDetector(10, 10, 3, TriggerType::RANGE_BOX_AREA));
+
+  auto mockObjectPtr = mockObjectAt("object", {0, 0});
+
+  ASSERT_FALSE(collisionDetector->remove(mockObjectPtr));
+
+  ASSERT_TRUE(collisionDetector->upsert(mockObjectPtr));
+
+  ASSERT_TRUE(collisionDetector->remove(mockObjectPtr));
+
+  ASSERT_EQ(collisionDetector->search({0, 0}).objectSet.size(), 0);
+}
+
+TEST(GridCollisionDetectorTest, test_search_area) {
+  auto collisionDetector = std::shared_ptr<CollisionDetector>(new GridCollisionDetector(10, 10, 2, TriggerType::RANGE_BOX_AREA));
+
+  auto mockObjectPtr1 = mockObjectAt("object1", {1, 1});
+  auto mockObjectPtr2 = mockObjectAt("object2", {3, 1});
+  auto mockObjectPtr3 = mockObjectAt("object3", {1, 3});
+  auto mockObjectPtr4 = mockObjectAt("object4", {3, 3});
+  auto mockObjectPtr5 = mockObjectAt("object5", {0, 0});
+  auto mockObjectPtr6 = mockObjectAt("object6", {4, 0});
+  auto mockObjectPtr7 = mockObjectAt("object7", {0, 4});
+  auto mockObjectPtr8 = mockObjectAt("object8", {4, 4});
+
+  ASSERT_TRUE(collisionDetector->upsert(mockObjectPtr1));
+  ASSERT_TRUE(collisionDetector->upsert(mockObjectPtr2));
+  ASSERT_TRUE(collisionDetector->upsert(mockObjectPtr3));
+  ASSERT_TRUE(collisionDetector->upsert(mockObjectPtr4));
+  ASSERT_TRUE(collisionDetector->upsert(mockObjectPtr5));
+  ASSERT_TRUE(collisionDetector->upsert(mockObjectPtr6));
+  ASSERT_TRUE(collisionDetector->upsert(mockObjectPtr7));
+  ASSERT_TRUE(collisionDetector->upsert(mockObjectPtr8));
+
+  auto searchResults1 = collisionDetector->search({3, 3});
+  auto searchResults2 = collisionDetector->search({2, 2});
+  auto searchResults3 = collisionDetector->search({1, 1});
+
+  ASSERT_THAT(searchResults1.objectSet, UnorderedElementsAre(mockObjectPtr1, mockObjectPtr2, mockObjectPtr3, mockObjectPtr4, mockObjectPtr8));
+  ASSERT_THAT(searchResults2.objectSet, UnorderedElementsAre(mockObjectPtr1, mockObjectPtr2, mockObjectPtr3, mockObjectPtr4, mockObjectPtr5, mockObjectPtr6, mockObjectPtr7, mockObjectPtr8));
+  ASSERT_THAT(searchResults3.objectSet, UnorderedElementsAre(mockObjectPtr1, mockObjectPtr2, mockObjectPtr3, mockObjectPtr4, mockObjectPtr5));
+
+  // The closest object comes first
+  ASSERT_EQ(searchResults1.closestObjects[0], mockObjectPtr4);
+  ASSERT_EQ(searchResults3.closestObjects[0], mockObjectPtr1);
+
+  std::vector<std::shared_ptr<Object>> collidedObjects;
+  collisionDetector->searchInto({3, 3}, collidedObjects);
+  ASSERT_THAT(collidedObjects, UnorderedElementsAre(mockObjectPtr1, mockObjectPtr2, mockObjectPtr3, mockObjectPtr4, mockObjectPtr8));
+}
+
+TEST(GridCollisionDetectorTest, test_search_area_closest_objects_order) {
+  auto collisionDetector = std::shared_ptr<CollisionDetector>(new GridCollisionDetector(10, 10, 2, TriggerType::RANGE_BOX_AREA));
+
+  auto mockObjectPtr1 = mockObjectAt("object1", {1, 1});
+  auto mockObjectPtr2 = mockObjectAt("object2", {3, 1});
+  auto mockObjectPtr3 = mockObjectAt("object3", {1, 3});
+  auto mockObjectPtr4 = mockObjectAt("object4", {3, 3});
+  auto mockObjectPtr5 = mockObjectAt("object5", {4, 4});
+  auto mockObjectPtr6 = mockObjectAt("object6", {2, 4});
+
+  // Added in a different order to the one they are found in
+  for (const auto& mockObjectPtr : {mockObjectPtr6, mockObjectPtr5, mockObjectPtr4, mockObjectPtr3, mockObjectPtr2, mockObjectPtr1}) {
+    ASSERT_TRUE(collisionDetector->upsert(mockObjectPtr));
+  }
+
+  // Nearest first by Chebyshev distance, objects at the same distance are in row order from the lowest row, then left to right
+  ASSERT_THAT(collisionDetector->search({3, 3}).closestObjects, ElementsAre(mockObjectPtr4, mockObjectPtr6, mockObjectPtr5, mockObjectPtr1, mockObjectPtr2, mockObjectPtr3));
+}
+
+TEST(GridCollisionDetectorTest, test_search_boundary) {
+  auto collisionDetector = std::shared_ptr<CollisionDetector>(new GridCollisionDetector(10, 10, 2, TriggerType::RANGE_BOX_BOUNDARY));
+
+  auto mockObjectPtr1 = mockObjectAt("object1", {1, 1});
+  auto mockObjectPtr2 = mockObjectAt("object2", {3, 1});
+  auto mockObjectPtr3 = mockObjectAt("object3", {1, 3});
+  auto mockObjectPtr4 = mockObjectAt("object4", {3, 3});
+  auto mockObjectPtr5 = mockObjectAt("object5", {0, 0});
+  auto mockObjectPtr6 = mockObjectAt("object6", {4, 0});
+  auto mockObjectPtr7 = mockObjectAt("object7", {0, 4});
+  auto mockObjectPtr8 = mockObjectAt("object8", {4, 4});
+
+  ASSERT_TRUE(collisionDetector->upsert(mockObjectPtr1));
+  ASSERT_TRUE(collisionDetector->upsert(mockObjectPtr2));
+  ASSERT_TRUE(collisionDetector->upsert(mockObjectPtr3));
+  ASSERT_TRUE(collisionDetector->upsert(mockObjectPtr4));
+  ASSERT_TRUE(collisionDetector->upsert(mockObjectPtr5));
+  ASSERT_TRUE(collisionDetector->upsert(mockObjectPtr6));
+  ASSERT_TRUE(collisionDetector->upsert(mockObjectPtr7));
+  ASSERT_TRUE(collisionDetector->upsert(mockObjectPtr8));
+
+  auto searchResults1 = collisionDetector->search({3, 3});
+  auto searchResults2 = collisionDetector->search({2, 2});
+  auto searchResults3 = collisionDetector->search({1, 1});
+
+  ASSERT_THAT(searchResults1.objectSet, UnorderedElementsAre(mockObjectPtr1, mockObjectPtr2, mockObjectPtr3));
+  ASSERT_THAT(searchResults2.objectSet, UnorderedElementsAre(mockObjectPtr5, mockObjectPtr6, mockObjectPtr7, mockObjectPtr8));
+  ASSERT_THAT(searchResults3.objectSet, UnorderedElementsAre(mockObjectPtr2, mockObjectPtr3, mockObjectPtr4));
+
+  std::vector<std::shared_ptr<Object>> collidedObjects;
+  collisionDetector->searchInto({2, 2}, collidedObjects);
+  ASSERT_THAT(collidedObjects, UnorderedElementsAre(mockObjectPtr5, mockObjectPtr6, mockObjectPtr7, mockObjectPtr8));
+}
+
+// Compares the query time of the grid collision detector with the spatial hash on a map with 10k units.
+// Run with --gtest_also_run_disabled_tests
+TEST(GridCollisionDetectorTest, DISABLED_benchmark_against_spatial_hash) {
+  uint32_t gridWidth = 200;
+  uint32_t gridHeight = 200;
+  uint32_t unitCount = 10000;
+  uint32_t range = 2;
+  uint32_t ticks = 20;
+
+  std::mt19937 random(1234);
+  std::uniform_int_distribution<int32_t> xDistribution(0, gridWidth - 1);
+  std::uniform_int_distribution<int32_t> yDistribution(0, gridHeight - 1);
+
+  std::vector<std::shared_ptr<Object>> units;
+  for (uint32_t u = 0; u < unitCount; u++) {
+    auto unit = std::make_shared<Object>(Object("unit", 'u', 1, 0, {}, nullptr, std::weak_ptr<Grid>()));
+    unit->init({xDistribution(random), yDistribution(random)});
+    units.push_back(unit);
+  }
+
+  auto cellSize = static_cast<uint32_t>(std::floor(std::sqrt(static_cast<double>(gridWidth))));
+
+  for (auto triggerType : {TriggerType::RANGE_BOX_AREA, TriggerType::RANGE_BOX_BOUNDARY}) {
+    auto spatialHash = std::make_shared<SpatialHashCollisionDetector>(gridWidth, gridHeight, cellSize, range, triggerType);
+    auto gridCollisionDetector = std::make_shared<GridCollisionDetector>(gridWidth, gridHeight, range, triggerType);
+
+    for (const auto& unit : units) {
+      spatialHash->upsert(unit);
+      gridCollisionDetector->upsert(unit);
+    }
+
+    std::vector<std::shared_ptr<Object>> collidedObjects;
+    size_t spatialHashCollisions = 0;
+    size_t gridCollisions = 0;
+
+    auto spatialHashStart = std::chrono::steady_clock::now();
+    for (uint32_t t = 0; t < ticks; t++) {
+      for (const auto& unit : units) {
+        spatialHash->searchInto(unit->getLocation(), collidedObjects);
+        spatialHashCollisions += collidedObjects.size();
+      }
+    }
+    auto spatialHashEnd = std::chrono::steady_clock::now();
+
+    for (uint32_t t = 0; t < ticks; t++) {
+      for (const auto& unit : units) {
+        gridCollisionDetector->searchInto(unit->getLocation(), collidedObjects);
+        gridCollisions += collidedObjects.size();
+      }
+    }
+    auto gridEnd = std::chrono::steady_clock::now();
+
+    ASSERT_EQ(gridCollisions, spatialHashCollisions);
+
+    auto spatialHashMs = std::chrono::duration_cast<std::chrono::milliseconds>(spatialHashEnd - spatialHashStart).count();
+    auto gridMs = std::chrono::duration_cast<std::chrono::milliseconds>(gridEnd - spatialHashEnd).count();
+
+    spdlog::info("{0} units, {1} ticks, trigger type {2}: spatial hash {3}ms, grid collision detector {4}ms",
+                 unitCount, ticks, static_cast<uint32_t>(triggerType), spatialHashMs, gridMs);
+  }
+}
+
+}  // namespace griddly
@@ -160,6 +160,70 @@ TEST(GridTest, initializeObjectTwice) {
   ASSERT_EQ(grid->getObjects().size(), 1);
 }
 
+TEST(GridTest, initializeObjectOutsideGrid) {
+  auto grid = std::make_shared<Grid>();
+  grid->resetMap(5, 4);
+  grid->initObject("object", {});
+
+  for (auto location : {glm::ivec2{-1, 0}, glm::ivec2{5, 0}, glm::ivec2{0, -1}, glm::ivec2{0, 4}, glm::ivec2{5, 4}}) {
+    auto mockObjectPtr = mockObject("object", 'o', 1, 0, location);
+    grid->addObject(location, mockObjectPtr);
+
+    ASSERT_EQ(grid->getObject(location), nullptr);
+    ASSERT_EQ(grid->getObjectsAt(location).size(), 0);
+    EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockObjectPtr.get()));
+  }
+
+  uint64_t updatedLocationsCursor = 0;
+  std::vector<glm::ivec2> updatedLocations;
+  ASSERT_TRUE(grid->getUpdatedLocations(updatedLocationsCursor, updatedLocations));
+  ASSERT_EQ(updatedLocations.size(), 0);
+  ASSERT_EQ(grid->getObjects().size(), 0);
+}
+
+TEST(GridTest, objectsAtGridEdges) {
+  auto grid = std::make_shared<Grid>();
+  grid->resetMap(5, 4);
+  grid->initObject("object", {});
+
+  std::vector<glm::ivec2> corners{{0, 0}, {4, 0}, {0, 3}, {4, 3}};
+  std::vector<std::shared_ptr<MockObject>> objects;
+  for (auto location : corners) {
+    auto mockObjectPtr = mockObject("object", 'o', 1, 0, location);
+    grid->addObject(location, mockObjectPtr);
+    objects.push_back(mockObjectPtr);
+  }
+
+  ASSERT_EQ(grid->getObjects().size(), 4);
+  for (uint32_t i = 0; i < corners.size(); i++) {
+    ASSERT_EQ(grid->getObject(corners[i]), objects[i]);
+    ASSERT_EQ(grid->getObjectsAt(corners[i]).size(), 1);
+  }
+
+  // The cells either side of the end of a row are not occupied by the corners next to them
+  ASSERT_EQ(grid->getObject({0, 1}), nullptr);
+  ASSERT_EQ(grid->getObject({4, 1}), nullptr);
+  ASSERT_EQ(grid->getObject({0, 2}), nullptr);
+  ASSERT_EQ(grid->getObject({4, 2}), nullptr);
+
+  for (uint32_t i = 0; i < corners.size(); i++) {
+    ASSERT_TRUE(grid->removeObject(objects[i]));
+    ASSERT_EQ(grid->getObject(corners[i]), nullptr);
+    ASSERT_EQ(grid->getObjectsAt(corners[i]).size(), 0);
+
+    // The other corners are still occupied
+    for (uint32_t j = i + 1; j < corners.size(); j++) {
+      ASSERT_EQ(grid->getObject(corners[j]), objects[j]);
+    }
+  }
+
+  ASSERT_EQ(grid->getObjects().size(), 0);
+
+  for (const auto& mockObjectPtr : objects) {
+    EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockObjectPtr.get()));
+  }
+}
+
 TEST(GridTest, removeObject) {
   auto grid = std::make_shared<Grid>();
   grid->resetMap(123, 456);
@@ -174,7 +238,11 @@ TEST(GridTest, removeObject) {
 
   ASSERT_EQ(grid->removeObject(mockObjectPtr), true);
   ASSERT_EQ(grid->getObject(objectLocation), nullptr);
-  ASSERT_TRUE(grid->getUpdatedLocations(1).size() > 0);
+
+  uint64_t updatedLocationsCursor = 0;
+  std::vector<glm::ivec2> updatedLocations;
+  ASSERT_TRUE(grid->getUpdatedLocations(updatedLocationsCursor, updatedLocations));
+  ASSERT_TRUE(updatedLocations.size() > 0);
   ASSERT_EQ(grid->getObjects().size(), 0);
 
   EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockObjectPtr.get()));
@@ -190,12 +258,82 @@ TEST(GridTest, removeObjectNotInitialized) {
   grid->initObject("object", {});
 
   ASSERT_EQ(grid->getObjects().size(), 0);
-  ASSERT_EQ(grid->getUpdatedLocations(1).size(), 0);
+
+  uint64_t updatedLocationsCursor = 0;
+  std::vector<glm::ivec2> updatedLocations;
+  ASSERT_TRUE(grid->getUpdatedLocations(updatedLocationsCursor, updatedLocations));
+  ASSERT_EQ(updatedLocations.size(), 0);
   ASSERT_EQ(grid->removeObject(mockObjectPtr), false);
 
   EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockObjectPtr.get()));
 }
 
+TEST(GridTest, invalidateLocationIndependentObserverCursors) {
+  auto grid = std::make_shared<Grid>();
+  grid->resetMap(10, 10);
+  grid->setPlayerCount(8);
+
+  uint64_t cursor1 = 0;
+  uint64_t cursor2 = 0;
+  std::vector<glm::ivec2> updatedLocations;
+
+  grid->invalidateLocation({1, 1});
+  grid->invalidateLocation({2, 2});
+  grid->invalidateLocation({1, 1});
+
+  ASSERT_TRUE(grid->getUpdatedLocations(cursor1, updatedLocations));
+  ASSERT_EQ(updatedLocations, std::vector<glm::ivec2>({{1, 1}, {2, 2}}));
+
+  // A location that has been read by one observer is recorded again so the other observer does not miss it
+  grid->invalidateLocation({1, 1});
+  grid->invalidateLocation({3, 3});
+
+  ASSERT_TRUE(grid->getUpdatedLocations(cursor1, updatedLocations));
+  ASSERT_EQ(updatedLocations, std::vector<glm::ivec2>({{1, 1}, {3, 3}}));
+
+  ASSERT_TRUE(grid->getUpdatedLocations(cursor2, updatedLocations));
+  ASSERT_EQ(updatedLocations, std::vector<glm::ivec2>({{1, 1}, {2, 2}, {1, 1}, {3, 3}}));
+
+  ASSERT_TRUE(grid->getUpdatedLocations(cursor1, updatedLocations));
+  ASSERT_EQ(updatedLocations.size(), 0);
+
+  // Locations outside the grid are ignored
+  ASSERT_FALSE(grid->invalidateLocation({-1, 1}));
+  ASSERT_FALSE(grid->invalidateLocation({1, 10}));
+  ASSERT_TRUE(grid->getUpdatedLocations(cursor1, updatedLocations));
+  ASSERT_EQ(updatedLocations.size(), 0);
+}
+
+TEST(GridTest, getUpdatedLocationsStaleCursor) {
+  auto grid = std::make_shared<Grid>();
+  grid->resetMap(2, 2);
+
+  uint64_t cursor = 0;
+  std::vector<glm::ivec2> updatedLocations;
+
+  grid->invalidateLocation({0, 0});
+  ASSERT_TRUE(grid->getUpdatedLocations(cursor, updatedLocations));
+
+  // Updates from before a reset are dropped, so observers holding an old cursor have to redraw
+  uint64_t staleCursor = 0;
+  grid->resetMap(2, 2);
+  grid->invalidateLocation({1, 1});
+  ASSERT_FALSE(grid->getUpdatedLocations(staleCursor, updatedLocations));
+  ASSERT_TRUE(grid->getUpdatedLocations(staleCursor, updatedLocations));
+  ASSERT_EQ(updatedLocations.size(), 0);
+
+  // Updates that no longer fit in the buffer are dropped
+  for (int i = 0; i < 3; i++) {
+    grid->invalidateLocation({0, 0});
+    grid->invalidateLocation({0, 1});
+    grid->invalidateLocation({1, 0});
+    ASSERT_TRUE(grid->getUpdatedLocations(staleCursor, updatedLocations));
+  }
+
+  ASSERT_FALSE(grid->getUpdatedLocations(cursor, updatedLocations));
+  ASSERT_EQ(updatedLocations.size(), 0);
+}
+
 TEST(GridTest, performActionDefaultObject) {
   auto grid = std::make_shared<Grid>();
   grid->resetMap(123, 456);
@@ -631,6 +769,55 @@ TEST(GridTest, performActionDelayed) {
   EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockActionPtr.get()));
 }
 
+TEST(GridTest, removeObjectCancelsDelayedActions) {
+  auto grid = std::make_shared<Grid>();
+  grid->resetMap(123, 456);
+
+  uint32_t playerId = 2;
+
+  auto mockSourceObjectLocation = glm::ivec2(0, 0);
+  auto mockSourceObjectPtr = mockObject("srcObject", 'S', playerId, 0, mockSourceObjectLocation);
+  grid->initObject("srcObject", {});
+
+  auto mockDestinationObjectLocation = glm::ivec2(0, 1);
+  auto mockDestinationObjectPtr = mockObject("dstObject", 'D', playerId, 0, mockDestinationObjectLocation);
+  grid->initObject("dstObject", {});
+
+  grid->addObject(mockSourceObjectLocation, mockSourceObjectPtr);
+  grid->addObject(mockDestinationObjectLocation, mockDestinationObjectPtr);
+
+  auto mockActionPtr = mockAction("action", mockSourceObjectPtr, mockDestinationObjectPtr);
+
+  EXPECT_CALL(*mockActionPtr, getDelay())
+      .WillRepeatedly(Return(10));
+
+  EXPECT_CALL(*mockSourceObjectPtr, isValidAction)
+      .Times(0);
+
+  EXPECT_CALL(*mockSourceObjectPtr, onActionSrc)
+      .Times(0);
+
+  EXPECT_CALL(*mockDestinationObjectPtr, onActionDst)
+      .Times(0);
+
+  auto actions = std::vector<std::shared_ptr<Action>>{mockActionPtr};
+  grid->performActions(playerId, actions);
+
+  ASSERT_EQ(grid->getDelayedActions().size(), 1);
+
+  ASSERT_TRUE(grid->removeObject(mockSourceObjectPtr));
+
+  ASSERT_EQ(grid->getDelayedActions().size(), 0);
+
+  for (int i = 0; i < 10; i++) {
+    auto delayedRewards = grid->update();
+    ASSERT_EQ(delayedRewards.size(), 0);
+  }
+
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockSourceObjectPtr.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockDestinationObjectPtr.get()));
+}
+
 TEST(GridTest, objectCounters) {
   auto grid = std::make_shared<Grid>();
   grid->resetMap(123, 456);
@@ -932,6 +1119,88 @@ TEST(GridTest, performActionTriggeredByCollision) {
   ASSERT_EQ(rewards[3], 12);
 }
 
+TEST(GridTest, collisionContactsOnlyRefreshedWhenNeighbourhoodChanges) {
+  auto mockCollisionDetectorFactoryPtr = std::make_shared<MockCollisionDetectorFactory>();
+  auto mockCollisionDetectorPtr1 = std::make_shared<MockCollisionDetector>();
+
+  EXPECT_CALL(*mockCollisionDetectorFactoryPtr, newCollisionDetector)
+      .WillOnce(Return(mockCollisionDetectorPtr1));
+
+  auto grid = std::make_shared<Grid>(Grid(mockCollisionDetectorFactoryPtr));
+  grid->resetMap(123, 456);
+
+  std::string actionName1 = "collision_trigger_action";
+
+  grid->addActionTrigger(actionName1, {{"object_1"}, {"object_2"}, TriggerType::RANGE_BOX_AREA, 2});
+
+  auto mockObjectPtr1 = mockObject("object_1", '?', 1, 0, {1, 1});
+  auto mockObjectPtr2 = mockObject("object_2", '?', 1, 0, {2, 2});
+
+  EXPECT_CALL(*mockObjectPtr1, isValidAction).Times(3).WillRepeatedly(Return(true));
+  EXPECT_CALL(*mockObjectPtr1, onActionSrc(Eq("object_2"), _)).Times(3).WillRepeatedly(Return(BehaviourResult{false, {{1, 1}}}));
+  EXPECT_CALL(*mockObjectPtr2, onActionDst).Times(3).WillRepeatedly(Return(BehaviourResult{false, {{1, 2}}}));
+
+  EXPECT_CALL(*mockCollisionDetectorPtr1, upsert).WillRepeatedly(Return(true));
+
+  grid->initObject("object_1", {});
+  grid->initObject("object_2", {});
+
+  grid->addObject({1, 1}, mockObjectPtr1);
+  grid->addObject({2, 2}, mockObjectPtr2);
+
+  // The source is queried once while nothing moves, the trigger still fires on every tick
+  EXPECT_CALL(*mockCollisionDetectorPtr1, search(Eq(glm::ivec2{1, 1})))
+      .Times(2)
+      .WillRepeatedly(Return(SearchResult{{mockObjectPtr2}, {}}));
+
+  std::unordered_map<uint32_t, int32_t> expectedRewards{{1, 3}};
+  ASSERT_EQ(grid->update(), expectedRewards);
+  ASSERT_EQ(grid->update(), expectedRewards);
+
+  // Moving a destination object near the source refreshes its contacts
+  grid->updateLocation(mockObjectPtr2, {2, 2}, {3, 3});
+  ASSERT_EQ(grid->update(), expectedRewards);
+
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockCollisionDetectorPtr1.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockObjectPtr1.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockObjectPtr2.get()));
+}
+
+TEST(GridTest, collisionActionsAfterReset) {
+  auto grid = std::make_shared<Grid>();
+  grid->resetMap(10, 10);
+
+  std::string actionName1 = "trigger_action_1";
+  std::string actionName2 = "trigger_action_2";
+
+  grid->addActionTrigger(actionName1, {{"object_1"}, {"object_2"}, TriggerType::RANGE_BOX_AREA, 1});
+  grid->addActionTrigger(actionName2, {{"object_2"}, {"object_1"}, TriggerType::RANGE_BOX_AREA, 1});
+  ASSERT_TRUE(grid->hasCollisionDetector(actionName1));
+  ASSERT_TRUE(grid->hasCollisionDetector(actionName2));
+
+  grid->resetMap(10, 10);
+  ASSERT_EQ(grid->getCollisionDetectors().size(), 0);
+  ASSERT_EQ(grid->getObjectCollisionActionNames().size(), 0);
+  ASSERT_EQ(grid->getSourceObjectCollisionActionNames().size(), 0);
+
+  // The names keep the ids they had before the reset, only the trigger that is added again is used
+  grid->addActionTrigger(actionName2, {{"object_1"}, {"object_2"}, TriggerType::RANGE_BOX_AREA, 1});
+  ASSERT_FALSE(grid->hasCollisionDetector(actionName1));
+  ASSERT_TRUE(grid->hasCollisionDetector(actionName2));
+
+  auto collisionDetectors = grid->getCollisionDetectors();
+  ASSERT_EQ(collisionDetectors.size(), 1);
+  ASSERT_TRUE(collisionDetectors.find(actionName2) != collisionDetectors.end());
+
+  auto sourceObjectCollisionActionNames = grid->getSourceObjectCollisionActionNames();
+  ASSERT_EQ(sourceObjectCollisionActionNames.size(), 1);
+  ASSERT_THAT(sourceObjectCollisionActionNames["object_1"], UnorderedElementsAre(actionName2));
+
+  auto objectCollisionActionNames = grid->getObjectCollisionActionNames();
+  ASSERT_EQ(objectCollisionActionNames.size(), 1);
+  ASSERT_THAT(objectCollisionActionNames["object_2"], UnorderedElementsAre(actionName2));
+}
+
 TEST(GridTest, resetTickCounter) {
   auto grid = std::make_shared<Grid>();
   grid->resetMap(123, 456);
@@ -982,4 +1251,277 @@ TEST(GridTest, randomNumberGenerator) {
   ASSERT_EQ(randomResult122, randomResult121);
 }
 
+TEST(GridTest, rollbackToCheckpoint) {
+  auto grid = std::make_shared<Grid>();
+  grid->resetMap(10, 10);
+  grid->initObject("object", {});
+
+  uint32_t playerId = 1;
+
+  auto mockObjectPtr1 = mockObject("object", 'o', playerId, 0, {1, 1});
+  auto mockObjectPtr2 = mockObject("object", 'o', playerId, 0, {2, 2});
+  auto mockObjectPtr3 = mockObject("object", 'o', playerId, 0, {3, 3});
+
+  grid->addObject({1, 1}, mockObjectPtr1);
+  grid->addObject({2, 2}, mockObjectPtr2);
+
+  auto mockActionPtr1 = mockAction("action", mockObjectPtr1, mockObjectPtr2);
+  EXPECT_CALL(*mockActionPtr1, getDelay()).WillRepeatedly(Return(5));
+  grid->performActions(playerId, {mockActionPtr1});
+
+  auto variable = std::make_shared<int32_t>(10);
+
+  grid->pushCheckpoint();
+  ASSERT_EQ(grid->getCheckpointCount(), 1);
+
+  grid->update();
+  grid->update();
+
+  grid->recordVariableChange(variable, {2, 2});
+  *variable = 20;
+
+  // Removing the source of the delayed action cancels it
+  ASSERT_TRUE(grid->removeObject(mockObjectPtr1));
+  grid->addObject({3, 3}, mockObjectPtr3);
+
+  auto mockActionPtr2 = mockAction("action", mockObjectPtr3, mockObjectPtr2);
+  EXPECT_CALL(*mockActionPtr2, getDelay()).WillRepeatedly(Return(3));
+  grid->performActions(playerId, {mockActionPtr2});
+
+  ASSERT_EQ(*grid->getTickCount(), 2);
+  ASSERT_EQ(grid->getDelayedActions().size(), 1);
+
+  grid->rollback();
+
+  ASSERT_EQ(grid->getCheckpointCount(), 0);
+  ASSERT_EQ(*grid->getTickCount(), 0);
+  ASSERT_EQ(*variable, 10);
+  ASSERT_THAT(grid->getObjects(), UnorderedElementsAre(mockObjectPtr1, mockObjectPtr2));
+  ASSERT_EQ(grid->getObject({1, 1}), mockObjectPtr1);
+  ASSERT_EQ(grid->getObject({3, 3}), nullptr);
+  ASSERT_EQ(*grid->getObjectCounter("object").at(playerId), 2);
+
+  auto pendingActions = grid->getDelayedActions().getPendingActions();
+  ASSERT_EQ(pendingActions.size(), 1);
+  ASSERT_EQ(pendingActions[0].action, mockActionPtr1);
+  ASSERT_EQ(pendingActions[0].priority, 5);
+
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockObjectPtr1.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockObjectPtr2.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockObjectPtr3.get()));
+}
+
+TEST(GridTest, rollbackNestedCheckpoints) {
+  auto grid = std::make_shared<Grid>();
+  grid->resetMap(10, 10);
+
+  auto variable = std::make_shared<int32_t>(0);
+  auto randomGenerator = grid->getRandomGenerator();
+
+  grid->pushCheckpoint();
+  auto expectedSample = randomGenerator->sampleInt(0, 1000000);
+  grid->recordVariableChange(variable, {0, 0});
+  *variable = 1;
+  grid->update();
+
+  grid->pushCheckpoint();
+  grid->recordVariableChange(variable, {0, 0});
+  *variable = 2;
+  grid->update();
+
+  grid->rollback();
+  ASSERT_EQ(*variable, 1);
+  ASSERT_EQ(*grid->getTickCount(), 1);
+
+  // The changes of a discarded checkpoint are undone with the checkpoint below it
+  grid->pushCheckpoint();
+  randomGenerator->sampleInt(0, 1000000);
+  grid->recordVariableChange(variable, {0, 0});
+  *variable = 3;
+  grid->discardCheckpoint();
+  ASSERT_EQ(grid->getCheckpointCount(), 1);
+
+  grid->rollback();
+  ASSERT_EQ(*variable, 0);
+  ASSERT_EQ(*grid->getTickCount(), 0);
+  ASSERT_EQ(randomGenerator->sampleInt(0, 1000000), expectedSample);
+
+  ASSERT_THROW(grid->rollback(), std::runtime_error);
+
+  // Changes are only recorded while there is a checkpoint
+  grid->recordVariableChange(variable, {0, 0});
+  *variable = 4;
+  grid->pushCheckpoint();
+  grid->rollback();
+  ASSERT_EQ(*variable, 4);
+}
+
+TEST(GridTest, entityIds) {
+  auto grid = std::make_shared<Grid>();
+  grid->resetMap(10, 10);
+  grid->initObject("object", {});
+
+  auto mockObjectPtr1 = mockObject("object", 'o', 1, 0, {1, 1});
+  auto mockObjectPtr2 = mockObject("object", 'o', 1, 0, {2, 2});
+  auto mockObjectPtr3 = mockObject("object", 'o', 1, 0, {3, 3});
+  auto mockObjectPtr4 = mockObject("object", 'o', 1, 0, {4, 4});
+
+  grid->addObject({1, 1}, mockObjectPtr1);
+  grid->addObject({2, 2}, mockObjectPtr2);
+  ASSERT_EQ(mockObjectPtr1->getEntityId(), 1);
+  ASSERT_EQ(mockObjectPtr2->getEntityId(), 2);
+
+  // Ids are not reused when objects are removed
+  ASSERT_TRUE(grid->removeObject(mockObjectPtr2));
+  grid->pushCheckpoint();
+  grid->addObject({3, 3}, mockObjectPtr3);
+  ASSERT_EQ(mockObjectPtr3->getEntityId(), 3);
+
+  // Objects added after a rollback get the ids of the objects that were undone
+  grid->rollback();
+  grid->addObject({4, 4}, mockObjectPtr4);
+  ASSERT_EQ(mockObjectPtr4->getEntityId(), 3);
+  ASSERT_EQ(grid->getNextEntityId(), 4);
+
+  // Objects that already have an id keep it
+  auto mockObjectPtr5 = mockObject("object", 'o', 1, 0, {5, 5});
+  mockObjectPtr5->setEntityId(10);
+  grid->addObject({5, 5}, mockObjectPtr5);
+  ASSERT_EQ(mockObjectPtr5->getEntityId(), 10);
+  ASSERT_EQ(grid->getNextEntityId(), 11);
+
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockObjectPtr1.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockObjectPtr2.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockObjectPtr3.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockObjectPtr4.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockObjectPtr5.get()));
+}
+
+TEST(GridTest, stateHash) {
+  auto objectsA = std::vector<std::shared_ptr<MockObject>>{mockObject("object1", 'a', 1, 0, {1, 1}), mockObject("object2", 'b', 1, 1, {1, 1}), mockObject("object1", 'a', 1, 0, {2, 3})};
+  auto objectsB = std::vector<std::shared_ptr<MockObject>>{mockObject("object1", 'a', 1, 0, {2, 3}), mockObject("object2", 'b', 1, 1, {1, 1}), mockObject("object1", 'a', 1, 0, {1, 1})};
+
+  auto gridA = std::make_shared<Grid>();
+  auto gridB = std::make_shared<Grid>();
+  for (const auto& grid : {gridA, gridB}) {
+    grid->resetMap(5, 5);
+    grid->resetGlobalVariables({{"score", {0, false}}});
+    grid->initObject("object1", {});
+    grid->initObject("object2", {});
+  }
+
+  // The order objects are added in does not matter
+  for (const auto& object : objectsA) {
+    gridA->addObject(object->getLocation(), object);
+  }
+  for (const auto& object : objectsB) {
+    gridB->addObject(object->getLocation(), object);
+  }
+
+  auto initialHash = gridA->getStateHash();
+  ASSERT_EQ(gridB->getStateHash(), initialHash);
+
+  // Moving an object changes the hash and moving it back restores it
+  ASSERT_TRUE(gridA->updateLocation(objectsA[2], {2, 3}, {4, 4}));
+  auto movedHash = gridA->getStateHash();
+  ASSERT_NE(movedHash, initialHash);
+  ASSERT_TRUE(gridA->updateLocation(objectsA[2], {4, 4}, {2, 3}));
+  ASSERT_EQ(gridA->getStateHash(), initialHash);
+
+  // Global variables are part of the hash, but the step count is not
+  *gridA->getGlobalVariables().at("score").at(0) = 10;
+  ASSERT_NE(gridA->getStateHash(), initialHash);
+  *gridA->getGlobalVariables().at("score").at(0) = 0;
+  gridA->setTickCount(100);
+  ASSERT_EQ(gridA->getStateHash(), initialHash);
+
+  // When more locations are updated than can be tracked every tile is hashed again
+  ASSERT_TRUE(gridB->updateLocation(objectsB[0], {2, 3}, {4, 4}));
+  uint64_t observerCursor = 0;
+  std::vector<glm::ivec2> updatedLocations;
+  for (int i = 0; i < 100; i++) {
+    gridB->invalidateLocation({i % 5, (i / 5) % 5});
+    gridB->getUpdatedLocations(observerCursor, updatedLocations);
+  }
+  ASSERT_EQ(gridB->getStateHash(), movedHash);
+}
+
+TEST(GridTest, shareImmutableObjects) {
+  auto grid = std::make_shared<Grid>();
+  grid->resetMap(10, 10);
+  grid->initObject("wall", {});
+  grid->initObject("box", {});
+
+  uint32_t playerId = 1;
+
+  auto mockWallPtr = mockObject("wall", 'w', playerId, 0, {1, 1});
+  auto mockBoxPtr = mockObject("box", 'b', playerId, 1, {2, 2});
+  EXPECT_CALL(*mockWallPtr, isImmutable()).WillRepeatedly(Return(true));
+  EXPECT_CALL(*mockBoxPtr, isImmutable()).WillRepeatedly(Return(false));
+
+  grid->addObject({1, 1}, mockWallPtr);
+  grid->addObject({2, 2}, mockBoxPtr);
+
+  auto forkedGrid = std::make_shared<Grid>();
+  forkedGrid->resetMap(10, 10);
+  forkedGrid->initObject("wall", {});
+  forkedGrid->initObject("box", {});
+  forkedGrid->shareImmutableObjects(*grid);
+
+  // Only the wall is shared, the box has to be cloned
+  ASSERT_TRUE(mockWallPtr->isShared());
+  ASSERT_FALSE(mockBoxPtr->isShared());
+  ASSERT_THAT(forkedGrid->getObjects(), UnorderedElementsAre(mockWallPtr));
+  ASSERT_EQ(forkedGrid->getObject({1, 1}), mockWallPtr);
+  ASSERT_EQ(forkedGrid->getObject({2, 2}), nullptr);
+  ASSERT_EQ(*forkedGrid->getObjectCounter("wall").at(playerId), 1);
+
+  auto mockClonedBoxPtr = mockObject("box", 'b', playerId, 1, {2, 2});
+  forkedGrid->addObject({2, 2}, mockClonedBoxPtr);
+
+  // Moving the cloned box onto the wall copies the tile, the original grid is unchanged
+  ASSERT_TRUE(forkedGrid->updateLocation(mockClonedBoxPtr, {2, 2}, {1, 1}));
+  ASSERT_EQ(forkedGrid->getObjectsAt({1, 1}).size(), 2);
+  ASSERT_EQ(grid->getObjectsAt({1, 1}).size(), 1);
+  ASSERT_EQ(grid->getObject({2, 2}), mockBoxPtr);
+
+  // Changes to the original grid are not seen by the fork
+  ASSERT_TRUE(grid->updateLocation(mockBoxPtr, {2, 2}, {3, 3}));
+  ASSERT_EQ(forkedGrid->getObject({3, 3}), nullptr);
+  ASSERT_EQ(forkedGrid->getObject({1, 1}), mockClonedBoxPtr);
+
+  auto differentSizeGrid = std::make_shared<Grid>();
+  differentSizeGrid->resetMap(5, 5);
+  ASSERT_THROW(differentSizeGrid->shareImmutableObjects(*grid), std::invalid_argument);
+
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockWallPtr.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockBoxPtr.get()));
+  EXPECT_TRUE(Mock::VerifyAndClearExpectations(mockClonedBoxPtr.get()));
+}
+
+TEST(GridTest, createActionReusesPooledMemory) {
+  auto grid = std::make_shared<Grid>(Grid());
+  grid->resetMap(10, 10);
+
+  auto action1 = grid->createAction("action1", 1, 2, {{"metaVariable", 3}});
+
+  ASSERT_EQ(action1->getActionName(), "action1");
+  ASSERT_EQ(action1->getOriginatingPlayerId(), 1);
+  ASSERT_EQ(action1->getDelay(), 2);
+  ASSERT_EQ(action1->getMetaData("metaVariable"), 3);
+
+  const auto& actionPool = grid->getActionPool();
+  auto blockCount = actionPool->getBlockCount();
+  ASSERT_EQ(actionPool->getFreeBlockCount(), blockCount - 1);
+
+  // The memory of the released action is used for the next one
+  auto* action1Address = action1.get();
+  action1.reset();
+  ASSERT_EQ(actionPool->getFreeBlockCount(), blockCount);
+
+  auto action2 = grid->createAction("action2", 1);
+  ASSERT_EQ(action2.get(), action1Address);
+  ASSERT_EQ(actionPool->getBlockCount(), blockCount);
+}
+
 }  // namespace griddly
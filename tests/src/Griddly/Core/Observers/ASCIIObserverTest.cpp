@@ -99,6 +99,45 @@ TEST(ASCIIObserverTest, defaultObserverConfig) {
   runASCIIObserverTest(config, Direction::NONE, {4, 5, 5}, {1, 4, 20}, expectedData[0][0]);
 }
 
+TEST(ASCIIObserverTest, defaultObserverConfig_outputBuffer) {
+  ASCIIObserverConfig config = {
+      5,
+      5,
+      0,
+      0,
+      false, false};
+
+  uint8_t expectedData[5][5][4] = {
+      {{'W', ' ', ' ', ' '}, {'W', ' ', ' ', ' '}, {'W', ' ', ' ', ' '}, {'W', ' ', ' ', ' '}, {'W', ' ', ' ', ' '}},
+      {{'W', ' ', ' ', ' '}, {'P', ' ', ' ', ' '}, {'.', ' ', ' ', ' '}, {'Q', ' ', ' ', ' '}, {'W', ' ', ' ', ' '}},
+      {{'W', ' ', ' ', ' '}, {'P', ' ', ' ', ' '}, {'A', ' ', ' ', ' '}, {'Q', ' ', ' ', ' '}, {'W', ' ', ' ', ' '}},
+      {{'W', ' ', ' ', ' '}, {'Q', ' ', ' ', ' '}, {'.', ' ', ' ', ' '}, {'P', ' ', ' ', ' '}, {'W', ' ', ' ', ' '}},
+      {{'W', ' ', ' ', ' '}, {'W', ' ', ' ', ' '}, {'W', ' ', ' ', ' '}, {'W', ' ', ' ', ' '}, {'W', ' ', ' ', ' '}}};
+
+  ObserverTestData testEnvironment = ObserverTestData(config, DiscreteOrientation(Direction::NONE));
+
+  std::shared_ptr<ASCIIObserver> asciiObserver = std::make_shared<ASCIIObserver>(testEnvironment.mockGridPtr);
+  asciiObserver->init(config);
+  asciiObserver->reset();
+
+  // Channels first, element [c, x, y] is at c * 25 + y * 5 + x
+  std::vector<uint8_t> outputBuffer(4 * 25);
+  asciiObserver->setOutputBuffer(outputBuffer.data(), {25, 1, 5});
+
+  const auto& updateObservation = asciiObserver->update();
+  ASSERT_EQ(&updateObservation, outputBuffer.data());
+
+  for (uint32_t c = 0; c < 4; c++) {
+    for (uint32_t y = 0; y < 5; y++) {
+      for (uint32_t x = 0; x < 5; x++) {
+        ASSERT_EQ(outputBuffer[c * 25 + y * 5 + x], expectedData[y][x][c]);
+      }
+    }
+  }
+
+  testEnvironment.verifyAndClearExpectations();
+}
+
 TEST(ASCIIObserverTest, partialObserver) {
   ASCIIObserverConfig config = {
       3,
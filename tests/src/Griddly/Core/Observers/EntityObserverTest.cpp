@@ -51,9 +51,48 @@ bool entityExists(const std::vector<std::vector<float>>& entityList, const std::
   return false;
 }
 
+// The entities of each type that should be observed, in any order
+struct ExpectedEntityObservations {
+  std::unordered_map<std::string, std::vector<std::vector<float>>> observations;
+};
+
+void checkEntityObservations(const EntityObservations& updateEntityObservations, const ExpectedEntityObservations& expectedEntityObservervations) {
+  for (const auto& entitiesIt : updateEntityObservations.entities) {
+    const auto& entityName = entitiesIt.first;
+    const auto& entities = entitiesIt.second;
+
+    auto expectedObservationsIt = expectedEntityObservervations.observations.find(entityName);
+    if (expectedObservationsIt == expectedEntityObservervations.observations.end()) {
+      ASSERT_EQ(entities.entityCount, 0);
+      continue;
+    }
+
+    const auto& expectedObservations = expectedObservationsIt->second;
+
+    // there should be the same number of entities in ids, locations and observations
+    ASSERT_EQ(entities.entityCount, expectedObservations.size());
+    ASSERT_GE(entities.features->size(), entities.entityCount * entities.featureCount);
+    ASSERT_GE(entities.ids->size(), entities.entityCount);
+    ASSERT_GE(entities.locations->size(), entities.entityCount * 2);
+
+    for (uint32_t i = 0; i < entities.entityCount; i++) {
+      auto featuresBegin = entities.features->begin() + i * entities.featureCount;
+      std::vector<float> updateObservation(featuresBegin, featuresBegin + entities.featureCount);
+      ASSERT_TRUE(entityExists(expectedObservations, updateObservation));
+
+      ASSERT_EQ((*entities.locations)[i * 2], updateObservation[0]);
+      ASSERT_EQ((*entities.locations)[i * 2 + 1], updateObservation[1]);
+    }
+  }
+
+  for (const auto& expectedObservationsIt : expectedEntityObservervations.observations) {
+    ASSERT_EQ(updateEntityObservations.entities.count(expectedObservationsIt.first), 1);
+  }
+}
+
 void runEntityObserverTest(EntityObserverConfig observerConfig,
                            Direction avatarDirection,
-                           EntityObservations& expectedEntityObservervations) {
+                           const ExpectedEntityObservations& expectedEntityObservervations) {
   ObserverTestData testEnvironment = ObserverTestData(observerConfig, DiscreteOrientation(avatarDirection));
 
   std::shared_ptr<EntityObserver> entityObserver = std::make_shared<EntityObserver>(testEnvironment.mockGridPtr);
@@ -69,37 +108,14 @@ void runEntityObserverTest(EntityObserverConfig observerConfig,
   entityObserver->reset();
 
   const auto& updateEntityObservations = entityObserver->update();
-  const auto& entityVariableMapping = entityObserver->getEntityVariableMapping();
-
-  ASSERT_EQ(updateEntityObservations.observations.size(), expectedEntityObservervations.observations.size());
-
-  for (const auto& expectedObservationsIt : expectedEntityObservervations.observations) {
-    auto entityName = expectedObservationsIt.first;
-    auto expectedObservations = expectedObservationsIt.second;
 
-    auto updateObservations = updateEntityObservations.observations.at(entityName);
-    auto updateIds = updateEntityObservations.observations.at(entityName);
-
-    // there should be the same number of entities in ids and observations
-    ASSERT_EQ(updateObservations.size(), expectedObservations.size());
-    ASSERT_EQ(updateIds.size(), expectedObservations.size());
-
-    for (auto i = 0; i < updateObservations.size(); i++) {
-      ASSERT_TRUE(entityExists(expectedObservations, updateObservations[i]));
-
-      auto expectedEntityLocation = glm::ivec2{updateObservations[i][0], updateObservations[i][1]};
-      auto updateId = updateEntityObservations.ids.at(entityName)[i];
-
-      ASSERT_EQ(updateEntityObservations.locations.at(updateId)[0], expectedEntityLocation[0]);
-      ASSERT_EQ(updateEntityObservations.locations.at(updateId)[1], expectedEntityLocation[1]);
-    }
-  }
+  checkEntityObservations(updateEntityObservations, expectedEntityObservervations);
 
   testEnvironment.verifyAndClearExpectations();
 }
 
 void runEntityObserverRTSTest(EntityObserverConfig observerConfig,
-                              EntityObservations& expectedEntityObservervations) {
+                              const ExpectedEntityObservations& expectedEntityObservervations) {
   auto mockGridPtr = std::make_shared<MockGrid>();
 
   ObserverRTSTestData testEnvironment = ObserverRTSTestData(observerConfig);
@@ -113,31 +129,8 @@ void runEntityObserverRTSTest(EntityObserverConfig observerConfig,
   entityObserver->reset();
 
   const auto& updateEntityObservations = entityObserver->update();
-  const auto& entityVariableMapping = entityObserver->getEntityVariableMapping();
 
-  ASSERT_EQ(updateEntityObservations.observations.size(), expectedEntityObservervations.observations.size());
-
-  for (const auto& expectedObservationsIt : expectedEntityObservervations.observations) {
-    auto entityName = expectedObservationsIt.first;
-    auto expectedObservations = expectedObservationsIt.second;
-
-    auto updateObservations = updateEntityObservations.observations.at(entityName);
-    auto updateIds = updateEntityObservations.observations.at(entityName);
-
-    // there should be the same number of entities in ids and observations
-    ASSERT_EQ(updateObservations.size(), expectedObservations.size());
-    ASSERT_EQ(updateIds.size(), expectedObservations.size());
-
-    for (auto i = 0; i < updateObservations.size(); i++) {
-      ASSERT_TRUE(entityExists(expectedObservations, updateObservations[i]));
-
-      auto expectedEntityLocation = glm::ivec2{updateObservations[i][0], updateObservations[i][1]};
-      auto updateId = updateEntityObservations.ids.at(entityName)[i];
-
-      ASSERT_EQ(updateEntityObservations.locations.at(updateId)[0], expectedEntityLocation[0]);
-      ASSERT_EQ(updateEntityObservations.locations.at(updateId)[1], expectedEntityLocation[1]);
-    }
-  }
+  checkEntityObservations(updateEntityObservations, expectedEntityObservervations);
 
   testEnvironment.verifyAndClearExpectations();
 }
@@ -150,7 +143,7 @@ TEST(EntityObserverTest, defaultObserverConfig) {
       0,
       false, false};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
   // "x", "y", "z"
   expectedEntityObservervations.observations = {
       {"avatar",
@@ -192,7 +185,7 @@ TEST(EntityObserverTest, partialObserver) {
       0,
       false, false};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"avatar",
@@ -226,7 +219,7 @@ TEST(EntityObserverTest, partialObserver_withOffset) {
       false,
       false};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
   // "x", "y", "z", "ox", "oy", "player_id"
   expectedEntityObservervations.observations = {
       {"avatar",
@@ -259,7 +252,7 @@ TEST(EntityObserverTest, defaultObserverConfig_trackAvatar) {
       false,
       true};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"avatar",
@@ -304,7 +297,7 @@ TEST(EntityObserverTest, defaultObserverConfig_trackAvatar_rotateWithAvatar_NONE
 
   config.includeRotation = {"avatar"};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"avatar",
@@ -349,7 +342,7 @@ TEST(EntityObserverTest, defaultObserverConfig_trackAvatar_rotateWithAvatar_UP)
 
   config.includeRotation = {"avatar"};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"avatar",
@@ -394,7 +387,7 @@ TEST(EntityObserverTest, defaultObserverConfig_trackAvatar_rotateWithAvatar_RIGH
 
   config.includeRotation = {"avatar"};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"avatar",
@@ -439,7 +432,7 @@ TEST(EntityObserverTest, defaultObserverConfig_trackAvatar_rotateWithAvatar_DOWN
 
   config.includeRotation = {"avatar"};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"avatar",
@@ -484,7 +477,7 @@ TEST(EntityObserverTest, defaultObserverConfig_trackAvatar_rotateWithAvatar_LEFT
 
   config.includeRotation = {"avatar"};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"avatar",
@@ -529,7 +522,7 @@ TEST(EntityObserverTest, partialObserver_trackAvatar_NONE) {
 
   config.includeRotation = {"avatar"};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"avatar",
@@ -564,7 +557,7 @@ TEST(EntityObserverTest, partialObserver_trackAvatar_UP) {
 
   config.includeRotation = {"avatar"};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"avatar",
@@ -599,7 +592,7 @@ TEST(EntityObserverTest, partialObserver_trackAvatar_RIGHT) {
 
   config.includeRotation = {"avatar"};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"avatar",
@@ -634,7 +627,7 @@ TEST(EntityObserverTest, partialObserver_trackAvatar_DOWN) {
 
   config.includeRotation = {"avatar"};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"avatar",
@@ -669,7 +662,7 @@ TEST(EntityObserverTest, partialObserver_trackAvatar_LEFT) {
 
   config.includeRotation = {"avatar"};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"avatar",
@@ -704,7 +697,7 @@ TEST(EntityObserverTest, partialObserver_withOffset_trackAvatar_NONE) {
 
   config.includeRotation = {"avatar"};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"avatar",
@@ -740,7 +733,7 @@ TEST(EntityObserverTest, partialObserver_withOffset_trackAvatar_UP) {
 
   config.includeRotation = {"avatar"};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"avatar",
@@ -776,7 +769,7 @@ TEST(EntityObserverTest, partialObserver_withOffset_trackAvatar_RIGHT) {
 
   config.includeRotation = {"avatar"};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"avatar",
@@ -812,7 +805,7 @@ TEST(EntityObserverTest, partialObserver_withOffset_trackAvatar_DOWN) {
 
   config.includeRotation = {"avatar"};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"avatar",
@@ -848,7 +841,7 @@ TEST(EntityObserverTest, partialObserver_withOffset_trackAvatar_LEFT) {
 
   config.includeRotation = {"avatar"};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"avatar",
@@ -884,7 +877,7 @@ TEST(EntityObserverTest, partialObserver_withOffset_trackAvatar_rotateWithAvatar
 
   config.includeRotation = {"avatar"};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"avatar",
@@ -920,7 +913,7 @@ TEST(EntityObserverTest, partialObserver_withOffset_trackAvatar_rotateWithAvatar
 
   config.includeRotation = {"avatar"};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"avatar",
@@ -956,7 +949,7 @@ TEST(EntityObserverTest, partialObserver_withOffset_trackAvatar_rotateWithAvatar
 
   config.includeRotation = {"avatar"};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"avatar",
@@ -991,7 +984,7 @@ TEST(EntityObserverTest, partialObserver_withOffset_trackAvatar_rotateWithAvatar
 
   config.includeRotation = {"avatar"};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"avatar",
@@ -1027,7 +1020,7 @@ TEST(EntityObserverTest, partialObserver_withOffset_trackAvatar_rotateWithAvatar
 
   config.includeRotation = {"avatar"};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"avatar",
@@ -1065,7 +1058,7 @@ TEST(EntityObserverTest, entityVariableMapping) {
       {"mo2", {"health", "max_health"}},
       {"mo3", {"health", "max_health"}}};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   // "x", "y", "z", "ox", "oy", "player_id"
   expectedEntityObservervations.observations = {
@@ -1107,7 +1100,7 @@ TEST(EntityObserverTest, multiPlayer_Outline_Player1) {
 
   config.includePlayerId = {"A", "B", "C"};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"W",
@@ -1150,7 +1143,7 @@ TEST(EntityObserverTest, multiPlayer_Outline_Player2) {
 
   config.includePlayerId = {"A", "B", "C"};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"W",
@@ -1193,7 +1186,7 @@ TEST(EntityObserverTest, multiPlayer_Outline_Player3) {
 
   config.includePlayerId = {"A", "B", "C"};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"W",
@@ -1236,7 +1229,7 @@ TEST(EntityObserverTest, multiPlayer_Outline_Global) {
 
   config.includePlayerId = {"A", "B", "C"};
 
-  EntityObservations expectedEntityObservervations;
+  ExpectedEntityObservations expectedEntityObservervations;
 
   expectedEntityObservervations.observations = {
       {"W",
@@ -108,17 +108,14 @@ class ObserverRTSTestData {
 
     EXPECT_CALL(*mockGridPtr, getObjectNames()).WillRepeatedly(Return(std::vector<std::string>{"W", "A", "B", "C"}));
     EXPECT_CALL(*mockGridPtr, getObjects()).WillRepeatedly(ReturnRef(mockRTSObjects));
-    EXPECT_CALL(*mockGridPtr, getUpdatedLocations).WillRepeatedly(ReturnRef(mockRTSUpdatedLocations));
+    EXPECT_CALL(*mockGridPtr, getUpdatedLocations).WillRepeatedly(Invoke([this](uint64_t& cursor, std::vector<glm::ivec2>& updatedLocations) -> bool {
+      updatedLocations.assign(mockRTSUpdatedLocations.begin(), mockRTSUpdatedLocations.end());
+      return true;
+    }));
 
     EXPECT_CALL(*mockGridPtr, getObjectVariableIds()).WillRepeatedly(ReturnRef(mockObjectVariableIds));
     EXPECT_CALL(*mockGridPtr, getObjectIds()).WillRepeatedly(ReturnRef(mockRTSObjectIds));
 
-    bool hasOffsets = observerConfig.gridXOffset != 0 || observerConfig.gridYOffset != 0;
-
-    if (!hasOffsets) {
-      EXPECT_CALL(*mockGridPtr, purgeUpdatedLocations).Times(AtLeast(1));
-    }
-
     EXPECT_CALL(*mockGridPtr, getObjectsAt).WillRepeatedly(Invoke([this](glm::ivec2 location) -> const TileObjects& {
       return mockRTSGridData.at(location);
     }));
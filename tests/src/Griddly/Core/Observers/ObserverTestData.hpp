@@ -100,15 +100,12 @@ class ObserverTestData {
 
     EXPECT_CALL(*mockGridPtr, getObjectNames()).WillRepeatedly(Return(mockSinglePlayerObjectNames));
     EXPECT_CALL(*mockGridPtr, getObjects()).WillRepeatedly(ReturnRef(mockSinglePlayerObjects));
-    EXPECT_CALL(*mockGridPtr, getUpdatedLocations).WillRepeatedly(ReturnRef(mockSinglePlayerUpdatedLocations));
+    EXPECT_CALL(*mockGridPtr, getUpdatedLocations).WillRepeatedly(Invoke([this](uint64_t& cursor, std::vector<glm::ivec2>& updatedLocations) -> bool {
+      updatedLocations.assign(mockSinglePlayerUpdatedLocations.begin(), mockSinglePlayerUpdatedLocations.end());
+      return true;
+    }));
     EXPECT_CALL(*mockGridPtr, getObjectIds()).WillRepeatedly(ReturnRef(mockSinglePlayerObjectIds));
 
-    bool hasOffsets = observerConfig.gridXOffset != 0 || observerConfig.gridYOffset != 0;
-
-    if (!observerConfig.trackAvatar && !hasOffsets) {
-      EXPECT_CALL(*mockGridPtr, purgeUpdatedLocations).Times(AtLeast(1));
-    }
-
     EXPECT_CALL(*mockGridPtr, getObjectsAt).WillRepeatedly(Invoke([this](glm::ivec2 location) -> const TileObjects& {
       return mockSinglePlayerGridData.at(location);
     }));
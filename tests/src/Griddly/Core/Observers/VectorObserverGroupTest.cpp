@@ -0,0 +1,188 @@
+#include <memory>
+
+#include "Griddly/Core/Grid.hpp"
+#include "Griddly/Core/Observers/VectorObserverGroup.hpp"
+#include "Mocks/Griddly/Core/MockGrid.hpp"
+#include "ObserverRTSTestData.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using ::testing::ElementsAreArray;
+using ::testing::Invoke;
+
+namespace griddly {
+
+// The global observer and the observer of each player, one of them cropped to the middle of the grid
+std::vector<VectorObserverConfig> getGroupTestConfigs() {
+  std::vector<VectorObserverConfig> configs;
+  for (uint32_t playerId = 0; playerId <= 3; playerId++) {
+    VectorObserverConfig config;
+    config.playerId = playerId;
+    config.playerCount = 3;
+    config.includePlayerId = true;
+    config.includeVariables = true;
+    configs.push_back(config);
+  }
+
+  configs[2].overrideGridWidth = 3;
+  configs[2].overrideGridHeight = 3;
+  configs[2].gridXOffset = 1;
+  configs[2].gridYOffset = 1;
+  return configs;
+}
+
+std::vector<std::shared_ptr<VectorObserver>> createGroupTestObservers(std::shared_ptr<Grid> grid) {
+  std::vector<std::shared_ptr<VectorObserver>> observers;
+  for (auto config : getGroupTestConfigs()) {
+    auto observer = std::make_shared<VectorObserver>(grid);
+    observer->init(config);
+    observer->reset();
+    observers.push_back(observer);
+  }
+  return observers;
+}
+
+std::vector<uint8_t> readGroupTestObservation(const uint8_t& observation, const std::shared_ptr<VectorObserver>& observer) {
+  auto shape = observer->getShape();
+  auto strides = observer->getStrides();
+  std::vector<uint8_t> values;
+  for (uint32_t y = 0; y < shape[2]; y++) {
+    for (uint32_t x = 0; x < shape[1]; x++) {
+      for (uint32_t c = 0; c < shape[0]; c++) {
+        values.push_back((&observation)[c * strides[0] + x * strides[1] + y * strides[2]]);
+      }
+    }
+  }
+  return values;
+}
+
+// Renders every observer on its own, returning their observations as [y][x][channel]
+std::vector<std::vector<uint8_t>> renderSeparately() {
+  ObserverRTSTestData testEnvironment = ObserverRTSTestData(ObserverConfig{});
+
+  std::vector<std::vector<uint8_t>> observations;
+  for (const auto& observer : createGroupTestObservers(testEnvironment.mockGridPtr)) {
+    observations.push_back(readGroupTestObservation(observer->update(), observer));
+  }
+  return observations;
+}
+
+TEST(VectorObserverGroupTest, rendersLikeSeparateObservers) {
+  auto expectedObservations = renderSeparately();
+
+  ObserverRTSTestData testEnvironment = ObserverRTSTestData(ObserverConfig{});
+
+  uint32_t objectReads = 0;
+  EXPECT_CALL(*testEnvironment.mockGridPtr, getObjectsAt).WillRepeatedly(Invoke([&](glm::ivec2 location) -> const TileObjects& {
+    objectReads++;
+    return testEnvironment.mockRTSGridData.at(location);
+  }));
+
+  auto observers = createGroupTestObservers(testEnvironment.mockGridPtr);
+  auto group = std::make_shared<VectorObserverGroup>(testEnvironment.mockGridPtr);
+  for (const auto& observer : observers) {
+    group->addObserver(observer);
+  }
+
+  // The first update redraws every observer, the ones after it render the updated locations, which are every location of the test grid
+  for (uint32_t update = 0; update < 2; update++) {
+    objectReads = 0;
+    group->update();
+    ASSERT_EQ(objectReads, 25);
+
+    for (uint32_t o = 0; o < observers.size(); o++) {
+      const auto& observer = observers[o];
+      ASSERT_THAT(readGroupTestObservation(observer->update(), observer), ElementsAreArray(expectedObservations[o]));
+    }
+  }
+
+  testEnvironment.verifyAndClearExpectations();
+}
+
+TEST(VectorObserverGroupTest, updatingAnObserverUpdatesTheGroup) {
+  auto expectedObservations = renderSeparately();
+
+  ObserverRTSTestData testEnvironment = ObserverRTSTestData(ObserverConfig{});
+
+  auto observers = createGroupTestObservers(testEnvironment.mockGridPtr);
+  auto group = std::make_shared<VectorObserverGroup>(testEnvironment.mockGridPtr);
+  for (const auto& observer : observers) {
+    group->addObserver(observer);
+  }
+
+  observers[1]->update();
+
+  // The other observers have been rendered by the group, so nothing is read when they are updated
+  EXPECT_CALL(*testEnvironment.mockGridPtr, getUpdatedLocations).WillRepeatedly(Invoke([](uint64_t& cursor, std::vector<glm::ivec2>& updatedLocations) -> bool {
+    updatedLocations.clear();
+    return true;
+  }));
+  EXPECT_CALL(*testEnvironment.mockGridPtr, getObjectsAt).Times(0);
+
+  for (uint32_t o = 0; o < observers.size(); o++) {
+    const auto& observer = observers[o];
+    ASSERT_THAT(readGroupTestObservation(observer->update(), observer), ElementsAreArray(expectedObservations[o]));
+  }
+
+  testEnvironment.verifyAndClearExpectations();
+}
+
+TEST(VectorObserverGroupTest, redrawsObserversThatAreReset) {
+  auto expectedObservations = renderSeparately();
+
+  ObserverRTSTestData testEnvironment = ObserverRTSTestData(ObserverConfig{});
+
+  auto observers = createGroupTestObservers(testEnvironment.mockGridPtr);
+  auto group = std::make_shared<VectorObserverGroup>(testEnvironment.mockGridPtr);
+  for (const auto& observer : observers) {
+    group->addObserver(observer);
+  }
+
+  group->update();
+
+  EXPECT_CALL(*testEnvironment.mockGridPtr, getUpdatedLocations).WillRepeatedly(Invoke([](uint64_t& cursor, std::vector<glm::ivec2>& updatedLocations) -> bool {
+    updatedLocations.clear();
+    return true;
+  }));
+
+  // Only the cropped observer is reset, so only its window is read again
+  uint32_t objectReads = 0;
+  EXPECT_CALL(*testEnvironment.mockGridPtr, getObjectsAt).WillRepeatedly(Invoke([&](glm::ivec2 location) -> const TileObjects& {
+    objectReads++;
+    return testEnvironment.mockRTSGridData.at(location);
+  }));
+
+  observers[2]->reset();
+  group->update();
+  ASSERT_EQ(objectReads, 9);
+
+  for (uint32_t o = 0; o < observers.size(); o++) {
+    const auto& observer = observers[o];
+    ASSERT_THAT(readGroupTestObservation(observer->update(), observer), ElementsAreArray(expectedObservations[o]));
+  }
+
+  testEnvironment.verifyAndClearExpectations();
+}
+
+TEST(VectorObserverGroupTest, addObserver_otherGrid) {
+  ObserverRTSTestData testEnvironment = ObserverRTSTestData(ObserverConfig{});
+  auto otherGridPtr = std::make_shared<MockGrid>();
+
+  auto group = std::make_shared<VectorObserverGroup>(otherGridPtr);
+  auto observer = std::make_shared<VectorObserver>(testEnvironment.mockGridPtr);
+
+  ASSERT_THROW(group->addObserver(observer), std::invalid_argument);
+}
+
+TEST(VectorObserverGroupTest, addObserver_otherGroup) {
+  ObserverRTSTestData testEnvironment = ObserverRTSTestData(ObserverConfig{});
+
+  auto group = std::make_shared<VectorObserverGroup>(testEnvironment.mockGridPtr);
+  auto otherGroup = std::make_shared<VectorObserverGroup>(testEnvironment.mockGridPtr);
+  auto observer = std::make_shared<VectorObserver>(testEnvironment.mockGridPtr);
+  group->addObserver(observer);
+
+  ASSERT_THROW(otherGroup->addObserver(observer), std::invalid_argument);
+}
+
+}  // namespace griddly
@@ -81,6 +81,179 @@ void runVectorObserverRTSTest(VectorObserverConfig observerConfig,
   testEnvironment.verifyAndClearExpectations();
 }
 
+// Renders into a channels first buffer with a padded row, element [c, x, y] is at c * 30 + y * 6 + x
+void runVectorObserverOutputBufferTest(VectorObserverConfig observerConfig, bool setAfterUpdate, uint8_t* expectedData) {
+  ObserverTestData testEnvironment = ObserverTestData(observerConfig, DiscreteOrientation(Direction::NONE));
+
+  std::shared_ptr<VectorObserver> vectorObserver = std::make_shared<VectorObserver>(VectorObserver(testEnvironment.mockGridPtr));
+
+  vectorObserver->init(observerConfig);
+
+  if (observerConfig.trackAvatar) {
+    vectorObserver->setAvatar(testEnvironment.mockAvatarObjectPtr);
+  }
+
+  vectorObserver->reset();
+
+  std::vector<uint8_t> outputBuffer(4 * 30, 255);
+  std::vector<uint32_t> outputStrides{30, 1, 6};
+
+  auto expectOutputBuffer = [&]() {
+    for (uint32_t c = 0; c < 4; c++) {
+      for (uint32_t y = 0; y < 5; y++) {
+        for (uint32_t x = 0; x < 5; x++) {
+          ASSERT_EQ(outputBuffer[c * 30 + y * 6 + x], expectedData[(y * 5 + x) * 4 + c]);
+        }
+
+        // Padding is left alone
+        ASSERT_EQ(outputBuffer[c * 30 + y * 6 + 5], 255);
+      }
+    }
+  };
+
+  if (setAfterUpdate) {
+    vectorObserver->update();
+    vectorObserver->setOutputBuffer(outputBuffer.data(), outputStrides);
+
+    // The observation rendered so far is copied into the buffer
+    expectOutputBuffer();
+  } else {
+    vectorObserver->setOutputBuffer(outputBuffer.data(), outputStrides);
+  }
+
+  auto& updateObservation = vectorObserver->update();
+
+  ASSERT_EQ(&updateObservation, outputBuffer.data());
+  ASSERT_EQ(vectorObserver->getShape(), std::vector<uint32_t>({4, 5, 5}));
+  ASSERT_EQ(vectorObserver->getStrides(), outputStrides);
+  expectOutputBuffer();
+
+  // Going back to the observer's own buffer
+  vectorObserver->setOutputBuffer(nullptr, {});
+  auto& ownObservation = vectorObserver->update();
+  ASSERT_NE(&ownObservation, outputBuffer.data());
+  ASSERT_EQ(vectorObserver->getStrides(), std::vector<uint32_t>({1, 4, 20}));
+  ASSERT_THAT(std::vector<uint8_t>(&ownObservation, &ownObservation + 100), ElementsAreArray(expectedData, 100));
+
+  testEnvironment.verifyAndClearExpectations();
+}
+
+// Reads the observation as [y][x][channel] whatever memory layout the observer renders into
+std::vector<uint8_t> readVectorObservation(const uint8_t& observation, const std::vector<uint32_t>& shape, const std::vector<uint32_t>& strides) {
+  std::vector<uint8_t> values;
+  for (uint32_t y = 0; y < shape[2]; y++) {
+    for (uint32_t x = 0; x < shape[1]; x++) {
+      for (uint32_t c = 0; c < shape[0]; c++) {
+        values.push_back((&observation)[c * strides[0] + x * strides[1] + y * strides[2]]);
+      }
+    }
+  }
+  return values;
+}
+
+// Renders the RTS test grid in the format of the config, and again as a DENSE observation to compare it to. Both are returned as [y][x][channel]
+std::pair<std::vector<uint8_t>, std::vector<uint8_t>> runVectorObserverFormatTest(VectorObserverConfig observerConfig, std::vector<uint32_t> expectedObservationShape) {
+  ObserverRTSTestData testEnvironment = ObserverRTSTestData(observerConfig);
+
+  auto denseConfig = observerConfig;
+  denseConfig.format = VectorObservationFormat::DENSE;
+
+  std::vector<std::vector<uint8_t>> observations;
+  for (auto config : {observerConfig, denseConfig}) {
+    auto vectorObserver = std::make_shared<VectorObserver>(testEnvironment.mockGridPtr);
+    vectorObserver->init(config);
+    vectorObserver->reset();
+    const auto& observation = vectorObserver->update();
+    observations.push_back(readVectorObservation(observation, vectorObserver->getShape(), vectorObserver->getStrides()));
+
+    if (config.format != VectorObservationFormat::DENSE) {
+      EXPECT_EQ(vectorObserver->getShape(), expectedObservationShape);
+    }
+  }
+
+  testEnvironment.verifyAndClearExpectations();
+  return {observations[0], observations[1]};
+}
+
+// Moves and turns the avatar and changes the grid between updates, checking each update against an observer that renders the whole window
+void runVectorObserverTrackingTest(VectorObserverConfig observerConfig, bool useOutputBuffer) {
+  ObserverTestData testEnvironment = ObserverTestData(observerConfig, DiscreteOrientation(Direction::NONE));
+
+  auto avatarLocation = glm::ivec2(2, 2);
+  auto avatarOrientation = DiscreteOrientation(Direction::UP);
+  EXPECT_CALL(*testEnvironment.mockAvatarObjectPtr, getLocation()).WillRepeatedly(ReturnRef(avatarLocation));
+  EXPECT_CALL(*testEnvironment.mockAvatarObjectPtr, getObjectOrientation()).WillRepeatedly(Invoke([&avatarOrientation]() {
+    return avatarOrientation;
+  }));
+
+  std::vector<glm::ivec2> updatedLocations;
+  EXPECT_CALL(*testEnvironment.mockGridPtr, getUpdatedLocations).WillRepeatedly(Invoke([&updatedLocations](uint64_t& cursor, std::vector<glm::ivec2>& locations) -> bool {
+    locations = updatedLocations;
+    updatedLocations.clear();
+    return true;
+  }));
+
+  auto vectorObserver = std::make_shared<VectorObserver>(testEnvironment.mockGridPtr);
+  vectorObserver->init(observerConfig);
+  vectorObserver->setAvatar(testEnvironment.mockAvatarObjectPtr);
+  vectorObserver->reset();
+
+  // Channels first with padded rows, so cells are moved one at a time
+  auto shape = vectorObserver->getShape();
+  std::vector<uint8_t> outputBuffer(shape[0] * (shape[1] + 1) * shape[2]);
+  if (useOutputBuffer) {
+    vectorObserver->setOutputBuffer(outputBuffer.data(), {(shape[1] + 1) * shape[2], 1, shape[1] + 1});
+  }
+
+  std::vector<std::pair<glm::ivec2, Direction>> avatarMoves = {
+      {{2, 2}, Direction::UP},
+      {{3, 2}, Direction::UP},
+      {{3, 3}, Direction::UP},
+      {{1, 1}, Direction::UP},
+      {{1, 1}, Direction::RIGHT},
+      {{0, 1}, Direction::RIGHT},
+      {{0, 0}, Direction::DOWN},
+      {{1, 0}, Direction::DOWN},
+      {{4, 4}, Direction::LEFT},
+      {{3, 4}, Direction::LEFT},
+      {{2, 2}, Direction::LEFT},
+  };
+
+  auto bearObjects = testEnvironment.mockSinglePlayerGridData.at({3, 2});
+
+  for (uint32_t m = 0; m < avatarMoves.size(); m++) {
+    // Only the window follows the avatar, it stays at {2, 2} in the grid data, which changes when the avatar turns
+    if (avatarMoves[m].second != avatarOrientation.getDirection()) {
+      updatedLocations.push_back({2, 2});
+    }
+
+    avatarLocation = avatarMoves[m].first;
+    avatarOrientation = DiscreteOrientation(avatarMoves[m].second);
+
+    // Remove one of the bears and put it back, on both sides of the avatar
+    if (m == 2 || m == 7) {
+      testEnvironment.mockSinglePlayerGridData[{3, 2}] = {};
+      updatedLocations.push_back({3, 2});
+    } else if (m == 4 || m == 9) {
+      testEnvironment.mockSinglePlayerGridData[{3, 2}] = bearObjects;
+      updatedLocations.push_back({3, 2});
+      updatedLocations.push_back({0, 0});
+    }
+
+    const auto& observation = vectorObserver->update();
+
+    auto fullObserver = std::make_shared<VectorObserver>(testEnvironment.mockGridPtr);
+    fullObserver->init(observerConfig);
+    fullObserver->setAvatar(testEnvironment.mockAvatarObjectPtr);
+    fullObserver->reset();
+    const auto& fullObservation = fullObserver->update();
+
+    ASSERT_EQ(readVectorObservation(observation, shape, vectorObserver->getStrides()), readVectorObservation(fullObservation, shape, fullObserver->getStrides())) << "after move " << m;
+  }
+
+  testEnvironment.verifyAndClearExpectations();
+}
+
 TEST(VectorObserverTest, defaultObserverConfig) {
   VectorObserverConfig config = {
       5,
@@ -99,6 +272,60 @@ TEST(VectorObserverTest, defaultObserverConfig) {
   runVectorObserverTest(config, Direction::NONE, {4, 5, 5}, {1, 4, 20}, expectedData[0][0]);
 }
 
+TEST(VectorObserverTest, defaultObserverConfig_outputBuffer) {
+  VectorObserverConfig config = {
+      5,
+      5,
+      0,
+      0,
+      false, false};
+
+  uint8_t expectedData[5][5][4] = {
+      {{1, 0, 0, 0}, {1, 0, 0, 0}, {1, 0, 0, 0}, {1, 0, 0, 0}, {1, 0, 0, 0}},
+      {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 0, 0}, {0, 0, 1, 0}, {1, 0, 0, 0}},
+      {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 0, 1}, {0, 0, 1, 0}, {1, 0, 0, 0}},
+      {{1, 0, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 0}, {0, 1, 0, 0}, {1, 0, 0, 0}},
+      {{1, 0, 0, 0}, {1, 0, 0, 0}, {1, 0, 0, 0}, {1, 0, 0, 0}, {1, 0, 0, 0}}};
+
+  runVectorObserverOutputBufferTest(config, false, expectedData[0][0]);
+  runVectorObserverOutputBufferTest(config, true, expectedData[0][0]);
+}
+
+TEST(VectorObserverTest, defaultObserverConfig_trackAvatar_outputBuffer) {
+  VectorObserverConfig config = {
+      5,
+      5,
+      0,
+      0,
+      false, true};
+
+  uint8_t expectedData[5][5][4] = {
+      {{1, 0, 0, 0}, {1, 0, 0, 0}, {1, 0, 0, 0}, {1, 0, 0, 0}, {1, 0, 0, 0}},
+      {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 0, 0}, {0, 0, 1, 0}, {1, 0, 0, 0}},
+      {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 0, 1}, {0, 0, 1, 0}, {1, 0, 0, 0}},
+      {{1, 0, 0, 0}, {0, 0, 1, 0}, {0, 0, 0, 0}, {0, 1, 0, 0}, {1, 0, 0, 0}},
+      {{1, 0, 0, 0}, {1, 0, 0, 0}, {1, 0, 0, 0}, {1, 0, 0, 0}, {1, 0, 0, 0}}};
+
+  runVectorObserverOutputBufferTest(config, false, expectedData[0][0]);
+  runVectorObserverOutputBufferTest(config, true, expectedData[0][0]);
+}
+
+TEST(VectorObserverTest, outputBufferBeforeReset) {
+  VectorObserverConfig config = {5, 5, 0, 0, false, false};
+  ObserverTestData testEnvironment = ObserverTestData(config, DiscreteOrientation(Direction::NONE));
+
+  std::shared_ptr<VectorObserver> vectorObserver = std::make_shared<VectorObserver>(VectorObserver(testEnvironment.mockGridPtr));
+  vectorObserver->init(config);
+
+  std::vector<uint8_t> outputBuffer(100);
+  ASSERT_THROW(vectorObserver->setOutputBuffer(outputBuffer.data(), {1, 4, 20}), std::runtime_error);
+
+  vectorObserver->reset();
+  ASSERT_THROW(vectorObserver->setOutputBuffer(outputBuffer.data(), {1, 4}), std::invalid_argument);
+
+  testEnvironment.verifyAndClearExpectations();
+}
+
 TEST(VectorObserverTest, partialObserver) {
   VectorObserverConfig config = {
       3,
@@ -582,4 +809,150 @@ TEST(VectorObserverTest, multiPlayer_PlusVariables_Player2) {
   runVectorObserverRTSTest(config, {11, 5, 5}, {1, 11, 11 * 5}, expectedData[0][0]);
 }
 
+TEST(VectorObserverTest, multiPlayer_PlusVariables_changedValues) {
+  VectorObserverConfig config = {5, 5, 0, 0};
+  config.includeVariables = true;
+
+  ObserverRTSTestData testEnvironment = ObserverRTSTestData(config);
+
+  std::shared_ptr<VectorObserver> vectorObserver = std::make_shared<VectorObserver>(VectorObserver(testEnvironment.mockGridPtr));
+  vectorObserver->init(config);
+  vectorObserver->reset();
+
+  // V1 of the A object at {1, 1} and B object at {2, 1}, the channels of A and B objects are only resolved for the first update
+  const auto* observation = &vectorObserver->update();
+  ASSERT_EQ(observation[(1 * 5 + 1) * 7 + 4], 1);
+  ASSERT_EQ(observation[(1 * 5 + 2) * 7 + 4], 4);
+
+  *testEnvironment.mockRTSGridData.at({1, 1}).at(0)->getVariableValue("V1") = 11;
+  *testEnvironment.mockRTSGridData.at({2, 1}).at(0)->getVariableValue("V1") = 14;
+
+  observation = &vectorObserver->update();
+  ASSERT_EQ(observation[(1 * 5 + 1) * 7 + 4], 11);
+  ASSERT_EQ(observation[(1 * 5 + 2) * 7 + 4], 14);
+
+  testEnvironment.verifyAndClearExpectations();
+}
+
+TEST(VectorObserverTest, partialObserver_trackAvatar_incremental) {
+  VectorObserverConfig config = {5, 3, 0, 0, false, true};
+  config.includeRotation = true;
+  config.includePlayerId = true;
+
+  runVectorObserverTrackingTest(config, false);
+  runVectorObserverTrackingTest(config, true);
+}
+
+TEST(VectorObserverTest, partialObserver_withOffset_trackAvatar_rotateWithAvatar_incremental) {
+  VectorObserverConfig config = {5, 3, 0, 1, true, true};
+  config.includeRotation = true;
+  config.includePlayerId = true;
+
+  runVectorObserverTrackingTest(config, false);
+  runVectorObserverTrackingTest(config, true);
+}
+
+TEST(VectorObserverTest, multiPlayer_PlusVariables_bitPacked) {
+  VectorObserverConfig config = {5, 5, 0, 0};
+  config.playerId = 1;
+  config.playerCount = 3;
+  config.includePlayerId = true;
+  config.includeVariables = true;
+  config.format = VectorObservationFormat::BIT_PACKED;
+
+  // 4 object and 4 player channels are packed into one byte, followed by the 3 variables
+  auto observations = runVectorObserverFormatTest(config, {4, 5, 5});
+  const auto& packed = observations.first;
+  const auto& dense = observations.second;
+
+  for (uint32_t cell = 0; cell < 25; cell++) {
+    for (uint32_t c = 0; c < 8; c++) {
+      ASSERT_EQ((packed[cell * 4] >> c) & 1, dense[cell * 11 + c]) << "cell " << cell << " channel " << c;
+    }
+    for (uint32_t v = 0; v < 3; v++) {
+      ASSERT_EQ(packed[cell * 4 + 1 + v], dense[cell * 11 + 8 + v]);
+    }
+  }
+}
+
+TEST(VectorObserverTest, multiPlayer_PlusVariables_typeIds) {
+  VectorObserverConfig config = {5, 5, 0, 0};
+  config.playerId = 1;
+  config.playerCount = 3;
+  config.includePlayerId = true;
+  config.includeVariables = true;
+  config.format = VectorObservationFormat::TYPE_IDS;
+  config.objectLayers = {0};
+
+  // Every object is on layer 0, the 4 object channels are replaced by the object id + 1 of that layer
+  auto observations = runVectorObserverFormatTest(config, {8, 5, 5});
+  const auto& typeIds = observations.first;
+  const auto& dense = observations.second;
+
+  for (uint32_t cell = 0; cell < 25; cell++) {
+    uint8_t expectedTypeId = 0;
+    for (uint8_t objectId = 0; objectId < 4; objectId++) {
+      if (dense[cell * 11 + objectId] == 1) {
+        expectedTypeId = objectId + 1;
+      }
+    }
+
+    ASSERT_EQ(typeIds[cell * 8], expectedTypeId) << "cell " << cell;
+    ASSERT_EQ(std::vector<uint8_t>(typeIds.begin() + cell * 8 + 1, typeIds.begin() + cell * 8 + 8), std::vector<uint8_t>(dense.begin() + cell * 11 + 4, dense.begin() + cell * 11 + 11));
+  }
+}
+
+TEST(VectorObserverTest, multiPlayer_PlusVariables_typeIds_missingLayer) {
+  VectorObserverConfig config = {5, 5, 0, 0};
+  config.format = VectorObservationFormat::TYPE_IDS;
+  config.objectLayers = {1, 2};
+
+  // None of the objects are on these layers
+  auto observations = runVectorObserverFormatTest(config, {2, 5, 5});
+  ASSERT_EQ(observations.first, std::vector<uint8_t>(2 * 5 * 5, 0));
+}
+
+TEST(VectorObserverTest, multiPlayer_PlusVariables_sparse) {
+  VectorObserverConfig config = {5, 5, 0, 0};
+  config.playerId = 1;
+  config.playerCount = 3;
+  config.includePlayerId = true;
+  config.includeVariables = true;
+  config.format = VectorObservationFormat::SPARSE;
+
+  ObserverRTSTestData testEnvironment = ObserverRTSTestData(config);
+
+  auto vectorObserver = std::make_shared<VectorObserver>(testEnvironment.mockGridPtr);
+  vectorObserver->init(config);
+  vectorObserver->reset();
+  const auto& observation = vectorObserver->update();
+
+  // Sparse observations are rendered densely
+  ASSERT_EQ(vectorObserver->getShape(), std::vector<uint32_t>({11, 5, 5}));
+  auto dense = readVectorObservation(observation, vectorObserver->getShape(), vectorObserver->getStrides());
+
+  std::vector<uint32_t> expectedIndices;
+  std::vector<uint8_t> expectedValues;
+  for (uint32_t y = 0; y < 5; y++) {
+    for (uint32_t x = 0; x < 5; x++) {
+      for (uint32_t c = 0; c < 11; c++) {
+        auto value = dense[(y * 5 + x) * 11 + c];
+        if (value != 0) {
+          expectedIndices.insert(expectedIndices.end(), {c, x, y});
+          expectedValues.push_back(value);
+        }
+      }
+    }
+  }
+
+  std::vector<uint32_t> indices;
+  std::vector<uint8_t> values;
+  vectorObserver->getSparseObservation(indices, values);
+
+  ASSERT_EQ(indices, expectedIndices);
+  ASSERT_EQ(values, expectedValues);
+
+  testEnvironment.verifyAndClearExpectations();
+}
+
 }  // namespace griddly
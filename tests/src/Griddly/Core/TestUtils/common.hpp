@@ -19,7 +19,7 @@ using ::testing::ReturnRefOfCopy;
 namespace griddly {
 
 std::shared_ptr<MockObject> static mockObject(std::string objectName = "object", char mapCharacter = '?', uint32_t playerId = 1, uint32_t zidx = 0, const glm::ivec2 location = {0, 0}, DiscreteOrientation orientation = DiscreteOrientation(), std::unordered_set<std::string> availableActionNames = {}, std::unordered_map<std::string, std::shared_ptr<int32_t>> availableVariables = {}) {
-  auto mockObjectPtr = std::make_shared<MockObject>();
+  auto mockObjectPtr = std::make_shared<MockObject>(availableVariables);
 
   EXPECT_CALL(*mockObjectPtr, getPlayerId()).WillRepeatedly(Return(playerId));
   EXPECT_CALL(*mockObjectPtr, getObjectName()).WillRepeatedly(ReturnRefOfCopy(objectName));
@@ -43,7 +43,7 @@ std::shared_ptr<MockObject> static mockObject(std::string objectName = "object",
 std::shared_ptr<MockAction> static mockAction(std::string actionName, std::shared_ptr<Object> sourceObject, std::shared_ptr<Object> destObject) {
   auto mockActionPtr = std::make_shared<MockAction>();
 
-  EXPECT_CALL(*mockActionPtr, getActionName()).WillRepeatedly(Return(actionName));
+  EXPECT_CALL(*mockActionPtr, getActionName()).WillRepeatedly(ReturnRefOfCopy(actionName));
   EXPECT_CALL(*mockActionPtr, getSourceObject()).WillRepeatedly(Return(sourceObject));
   EXPECT_CALL(*mockActionPtr, getDestinationObject()).WillRepeatedly(Return(destObject));
   EXPECT_CALL(*mockActionPtr, getSourceLocation()).WillRepeatedly(Return(sourceObject->getLocation()));
@@ -61,7 +61,7 @@ std::shared_ptr<MockAction> static mockAction(std::string actionName, glm::ivec2
   auto mockDefaultObject = std::make_shared<MockObject>();
   EXPECT_CALL(*mockDefaultObject, getObjectName()).WillRepeatedly(ReturnRefOfCopy(empty));
 
-  EXPECT_CALL(*mockActionPtr, getActionName()).WillRepeatedly(Return(actionName));
+  EXPECT_CALL(*mockActionPtr, getActionName()).WillRepeatedly(ReturnRefOfCopy(actionName));
   EXPECT_CALL(*mockActionPtr, getSourceObject()).WillRepeatedly(Return(mockDefaultObject));
   EXPECT_CALL(*mockActionPtr, getDestinationObject()).WillRepeatedly(Return(mockDefaultObject));
   EXPECT_CALL(*mockActionPtr, getSourceLocation()).WillRepeatedly(Return(sourceLocation));
@@ -79,7 +79,7 @@ std::shared_ptr<MockAction> static mockAction(std::string actionName, std::share
   auto mockDefaultObject = std::make_shared<MockObject>();
   EXPECT_CALL(*mockDefaultObject, getObjectName()).WillRepeatedly(ReturnRefOfCopy(empty));
 
-  EXPECT_CALL(*mockActionPtr, getActionName()).WillRepeatedly(Return(actionName));
+  EXPECT_CALL(*mockActionPtr, getActionName()).WillRepeatedly(ReturnRefOfCopy(actionName));
   EXPECT_CALL(*mockActionPtr, getSourceObject()).WillRepeatedly(Return(sourceObject));
   EXPECT_CALL(*mockActionPtr, getDestinationObject()).WillRepeatedly(Return(mockDefaultObject));
   EXPECT_CALL(*mockActionPtr, getSourceLocation()).WillRepeatedly(Return(sourceObject->getLocation()));
@@ -0,0 +1,80 @@
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+
+#include "Griddly/Core/Util/ThreadPool.cpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using ::testing::Each;
+using ::testing::Eq;
+
+namespace griddly {
+
+TEST(ThreadPoolTest, runsEveryTaskOnce) {
+  for (uint32_t threadCount : {1, 2, 3, 8}) {
+    ThreadPool threadPool(threadCount);
+    ASSERT_EQ(threadPool.getThreadCount(), threadCount);
+
+    // Batches are smaller and larger than the number of threads
+    for (uint32_t taskCount : {0, 1, 2, 7, 100}) {
+      std::vector<std::atomic<uint32_t>> runs(taskCount);
+      threadPool.parallelFor(taskCount, [&runs](uint32_t taskIdx) {
+        runs[taskIdx]++;
+      });
+
+      std::vector<uint32_t> runCounts(runs.begin(), runs.end());
+      ASSERT_THAT(runCounts, Each(Eq(1)));
+    }
+  }
+}
+
+TEST(ThreadPoolTest, unevenTasks) {
+  ThreadPool threadPool(4);
+
+  // All of the slow tasks start in the first thread's queue, so the other threads have to steal them
+  std::atomic<uint32_t> runs{0};
+  for (int batch = 0; batch < 10; batch++) {
+    threadPool.parallelFor(64, [&runs](uint32_t taskIdx) {
+      if (taskIdx < 8) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      runs++;
+    });
+  }
+
+  ASSERT_EQ(runs, 640);
+}
+
+TEST(ThreadPoolTest, rethrowsTaskException) {
+  ThreadPool threadPool(4);
+
+  std::atomic<uint32_t> runs{0};
+  ASSERT_THROW(threadPool.parallelFor(32, [&runs](uint32_t taskIdx) {
+    runs++;
+    if (taskIdx == 5) {
+      throw std::runtime_error("task failed");
+    }
+  }),
+               std::runtime_error);
+
+  // The rest of the batch still runs and the pool can be used again
+  ASSERT_EQ(runs, 32);
+  threadPool.parallelFor(32, [&runs](uint32_t taskIdx) {
+    runs++;
+  });
+  ASSERT_EQ(runs, 64);
+}
+
+TEST(ThreadPoolTest, pinnedThreads) {
+  ThreadPool threadPool(2, true);
+
+  std::atomic<uint32_t> runs{0};
+  threadPool.parallelFor(16, [&runs](uint32_t taskIdx) {
+    runs++;
+  });
+
+  ASSERT_EQ(runs, 16);
+}
+
+}  // namespace griddly
@@ -0,0 +1,140 @@
+#include <memory>
+
+#include "Griddly/Core/ValidActionCache.cpp"
+#include "Mocks/Griddly/Core/MockGrid.hpp"
+#include "TestUtils/common.hpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using ::testing::Invoke;
+using ::testing::UnorderedElementsAre;
+
+namespace griddly {
+
+class ValidActionCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    mockGridPtr = std::make_shared<MockGrid>();
+    EXPECT_CALL(*mockGridPtr, getWidth).WillRepeatedly(Return(10));
+    EXPECT_CALL(*mockGridPtr, getHeight).WillRepeatedly(Return(10));
+    EXPECT_CALL(*mockGridPtr, getUpdatedLocations).WillRepeatedly(Invoke([this](uint64_t& cursor, std::vector<glm::ivec2>& updatedLocations) -> bool {
+      updatedLocations = nextUpdatedLocations;
+      nextUpdatedLocations.clear();
+      return updatesAvailable;
+    }));
+
+    actionInputsDefinition = {{{1, {{0, -1}, {0, 0}, "Up"}},
+                               {2, {{1, 0}, {0, 0}, "Right"}},
+                               {3, {{0, 2}, {0, 0}, "Far Down"}}},
+                              false,
+                              false};
+
+    object = mockObject("object", 'o', 1, 0, {4, 4}, DiscreteOrientation(), {"move"});
+    EXPECT_CALL(*object, preconditionsReadGlobalVariables(Eq("move"))).WillRepeatedly(Invoke([this](const std::string& actionName) {
+      return readsGlobalVariables;
+    }));
+    EXPECT_CALL(*object, isValidAction).WillRepeatedly(Invoke([this](std::shared_ptr<Action> action) {
+      preconditionChecks++;
+      return validVectors.find(action->getVectorToDest()) != validVectors.end();
+    }));
+  }
+
+  // Returns the valid action ids and how many preconditions were checked to find them
+  std::pair<std::vector<uint32_t>, uint32_t> getValidActionIds(ValidActionCache& validActionCache) {
+    preconditionChecks = 0;
+    validActionCache.update();
+    auto actionIds = validActionCache.getValidActionIds(object, "move", actionInputsDefinition);
+    return {actionIds, preconditionChecks};
+  }
+
+  std::shared_ptr<MockGrid> mockGridPtr;
+  std::shared_ptr<MockObject> object;
+  ActionInputsDefinition actionInputsDefinition;
+
+  std::unordered_set<glm::ivec2> validVectors{{0, -1}, {0, 2}};
+  bool readsGlobalVariables = false;
+  uint32_t preconditionChecks = 0;
+
+  std::vector<glm::ivec2> nextUpdatedLocations;
+  bool updatesAvailable = true;
+};
+
+TEST_F(ValidActionCacheTest, onlyChecksPreconditionsOnce) {
+  ValidActionCache validActionCache(mockGridPtr);
+
+  auto checked = getValidActionIds(validActionCache);
+  ASSERT_THAT(checked.first, UnorderedElementsAre(1, 3));
+  ASSERT_EQ(checked.second, 3);
+
+  auto cached = getValidActionIds(validActionCache);
+  ASSERT_THAT(cached.first, UnorderedElementsAre(1, 3));
+  ASSERT_EQ(cached.second, 0);
+
+  // Changes out of reach of the object's actions
+  nextUpdatedLocations = {{4, 2}, {0, 0}, {6, 4}, {3, 3}};
+  cached = getValidActionIds(validActionCache);
+  ASSERT_THAT(cached.first, UnorderedElementsAre(1, 3));
+  ASSERT_EQ(cached.second, 0);
+}
+
+TEST_F(ValidActionCacheTest, checksPreconditionsWhenObjectChanges) {
+  ValidActionCache validActionCache(mockGridPtr);
+  getValidActionIds(validActionCache);
+
+  validVectors = {{1, 0}};
+  nextUpdatedLocations = {{4, 4}};
+  auto checked = getValidActionIds(validActionCache);
+  ASSERT_THAT(checked.first, UnorderedElementsAre(2));
+  ASSERT_EQ(checked.second, 3);
+}
+
+TEST_F(ValidActionCacheTest, checksPreconditionsWhenDestinationChanges) {
+  ValidActionCache validActionCache(mockGridPtr);
+  getValidActionIds(validActionCache);
+
+  for (auto destination : {glm::ivec2{4, 3}, glm::ivec2{5, 4}, glm::ivec2{4, 6}}) {
+    nextUpdatedLocations = {destination};
+    ASSERT_EQ(getValidActionIds(validActionCache).second, 3);
+  }
+}
+
+TEST_F(ValidActionCacheTest, checksRotatedDestinationsOfRelativeActions) {
+  actionInputsDefinition.relative = true;
+  ValidActionCache validActionCache(mockGridPtr);
+  getValidActionIds(validActionCache);
+
+  // When the object is rotated, the action that targets {4, 6} targets the cells two to the left, right or above it instead
+  for (auto destination : {glm::ivec2{2, 4}, glm::ivec2{6, 4}, glm::ivec2{4, 2}}) {
+    nextUpdatedLocations = {destination};
+    ASSERT_EQ(getValidActionIds(validActionCache).second, 3);
+  }
+}
+
+TEST_F(ValidActionCacheTest, checksPreconditionsWhenUpdatesAreLost) {
+  ValidActionCache validActionCache(mockGridPtr);
+  getValidActionIds(validActionCache);
+
+  updatesAvailable = false;
+  ASSERT_EQ(getValidActionIds(validActionCache).second, 3);
+}
+
+TEST_F(ValidActionCacheTest, checksPreconditionsAfterClear) {
+  ValidActionCache validActionCache(mockGridPtr);
+  getValidActionIds(validActionCache);
+
+  validActionCache.clear();
+  ASSERT_EQ(getValidActionIds(validActionCache).second, 3);
+}
+
+TEST_F(ValidActionCacheTest, alwaysChecksPreconditionsThatReadGlobalVariables) {
+  readsGlobalVariables = true;
+  ValidActionCache validActionCache(mockGridPtr);
+  getValidActionIds(validActionCache);
+
+  validVectors = {{1, 0}};
+  auto checked = getValidActionIds(validActionCache);
+  ASSERT_THAT(checked.first, UnorderedElementsAre(2));
+  ASSERT_EQ(checked.second, 3);
+}
+
+}  // namespace griddly
@@ -0,0 +1,220 @@
+#include <algorithm>
+#include <random>
+#include <sstream>
+
+#include "Griddly/Core/VectorGameProcess.cpp"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+using ::testing::ElementsAre;
+
+namespace griddly {
+
+// The avatar collects the goal to the right of it for a reward of 1, which finishes the game
+const std::string vectorGameGDY = R"(
+Version: "0.1"
+Environment:
+  Name: Vector Game
+  Player:
+    AvatarObject: avatar
+  Termination:
+    Win:
+      - eq: [goal:count, 0]
+  Levels:
+    - |
+      a  g  .
+
+Actions:
+  - Name: move
+    Behaviours:
+      - Src:
+          Object: avatar
+          Commands:
+            - mov: _dest
+        Dst:
+          Object: _empty
+      - Src:
+          Object: avatar
+          Commands:
+            - mov: _dest
+            - reward: 1
+        Dst:
+          Object: goal
+          Commands:
+            - remove: true
+
+Objects:
+  - Name: avatar
+    MapCharacter: a
+  - Name: goal
+    MapCharacter: g
+)";
+
+std::shared_ptr<GDYFactory> loadVectorGameGDY() {
+  auto gdyFactory = std::make_shared<GDYFactory>(GDYFactory(std::make_shared<ObjectGenerator>(ObjectGenerator()), std::make_shared<TerminationGenerator>(TerminationGenerator()), {}));
+  std::istringstream stream(vectorGameGDY);
+  gdyFactory->parseFromStream(stream);
+  return gdyFactory;
+}
+
+TEST(VectorGameProcessTest, stepAndAutoReset) {
+  auto vectorGameProcess = std::make_shared<VectorGameProcess>(3, "VECTOR", loadVectorGameGDY());
+  vectorGameProcess->init();
+  vectorGameProcess->reset();
+
+  ASSERT_EQ(vectorGameProcess->getGameCount(), 3);
+  ASSERT_EQ(vectorGameProcess->getPlayerCount(), 1);
+  ASSERT_THAT(vectorGameProcess->getObservationShape(), ElementsAre(2, 3, 1));
+  ASSERT_EQ(vectorGameProcess->getObservationSize(), 6);
+
+  auto initialObservations = vectorGameProcess->getObservations();
+  ASSERT_EQ(initialObservations.size(), 18);
+
+  // Game 0 collects the goal, game 1 does nothing and game 2 tries to move off the grid
+  std::vector<int32_t> actions{3, 0, 1};
+  vectorGameProcess->step(actions.data(), 1);
+
+  ASSERT_THAT(vectorGameProcess->getRewards(), ElementsAre(1, 0, 0));
+  ASSERT_THAT(vectorGameProcess->getDones(), ElementsAre(1, 0, 0));
+
+  // The finished game is reset so its observation is the first one of the next episode
+  ASSERT_EQ(vectorGameProcess->getObservations(), initialObservations);
+  ASSERT_EQ(vectorGameProcess->getGameProcess(0)->getGrid()->getObjects().size(), 2);
+
+  // All games collect the goal
+  actions = {3, 3, 3};
+  vectorGameProcess->step(actions.data(), 1);
+
+  ASSERT_THAT(vectorGameProcess->getRewards(), ElementsAre(1, 1, 1));
+  ASSERT_THAT(vectorGameProcess->getDones(), ElementsAre(1, 1, 1));
+  ASSERT_EQ(vectorGameProcess->getObservations(), initialObservations);
+}
+
+TEST(VectorGameProcessTest, stepWritesObservationsOfEachGame) {
+  auto vectorGameProcess = std::make_shared<VectorGameProcess>(2, "VECTOR", loadVectorGameGDY());
+  vectorGameProcess->setLevel(". a . g\n");
+  vectorGameProcess->init();
+  vectorGameProcess->reset();
+
+  std::vector<int32_t> actions{1, 3};
+  vectorGameProcess->step(actions.data(), 1);
+
+  ASSERT_THAT(vectorGameProcess->getDones(), ElementsAre(0, 0));
+
+  // Channels are interleaved, avatar is channel 0 and goal is channel 1
+  const auto& observations = vectorGameProcess->getObservations();
+  ASSERT_THAT(std::vector<uint8_t>(observations.begin(), observations.begin() + 8), ElementsAre(1, 0, 0, 0, 0, 0, 0, 1));
+  ASSERT_THAT(std::vector<uint8_t>(observations.begin() + 8, observations.end()), ElementsAre(0, 0, 0, 0, 1, 0, 0, 1));
+}
+
+TEST(VectorGameProcessTest, threadsGiveTheSameResults) {
+  auto serialGameProcess = std::make_shared<VectorGameProcess>(16, "VECTOR", loadVectorGameGDY());
+  auto threadedGameProcess = std::make_shared<VectorGameProcess>(16, "VECTOR", loadVectorGameGDY());
+  threadedGameProcess->setThreadCount(4);
+
+  ASSERT_EQ(serialGameProcess->getThreadCount(), 1);
+  ASSERT_EQ(threadedGameProcess->getThreadCount(), 4);
+
+  for (auto& vectorGameProcess : {serialGameProcess, threadedGameProcess}) {
+    vectorGameProcess->setLevel(". a . g\n");
+    vectorGameProcess->init();
+    vectorGameProcess->reset();
+  }
+
+  std::mt19937 random(0);
+  std::vector<int32_t> actions(16);
+  for (int s = 0; s < 100; s++) {
+    for (auto& action : actions) {
+      action = random() % 5;
+    }
+
+    serialGameProcess->step(actions.data(), 1);
+    threadedGameProcess->step(actions.data(), 1);
+
+    ASSERT_EQ(serialGameProcess->getRewards(), threadedGameProcess->getRewards());
+    ASSERT_EQ(serialGameProcess->getDones(), threadedGameProcess->getDones());
+    ASSERT_EQ(serialGameProcess->getObservations(), threadedGameProcess->getObservations());
+  }
+}
+
+TEST(VectorGameProcessTest, stepAsyncGivesTheSameResults) {
+  auto syncGameProcess = std::make_shared<VectorGameProcess>(8, "VECTOR", loadVectorGameGDY());
+  auto asyncGameProcess = std::make_shared<VectorGameProcess>(8, "VECTOR", loadVectorGameGDY());
+
+  for (auto& vectorGameProcess : {syncGameProcess, asyncGameProcess}) {
+    vectorGameProcess->setLevel(". a . g\n");
+    vectorGameProcess->init();
+    vectorGameProcess->reset();
+  }
+
+  std::mt19937 random(0);
+  std::vector<int32_t> actions(8);
+  for (int s = 0; s < 50; s++) {
+    for (auto& action : actions) {
+      action = random() % 5;
+    }
+
+    syncGameProcess->step(actions.data(), 1);
+
+    asyncGameProcess->stepAsync(actions.data(), 1);
+    ASSERT_TRUE(asyncGameProcess->isStepping());
+
+    // The actions are copied, so overwriting them does not change the step
+    std::fill(actions.begin(), actions.end(), -1);
+
+    asyncGameProcess->waitForStep();
+    ASSERT_FALSE(asyncGameProcess->isStepping());
+
+    ASSERT_EQ(syncGameProcess->getRewards(), asyncGameProcess->getRewards());
+    ASSERT_EQ(syncGameProcess->getDones(), asyncGameProcess->getDones());
+    ASSERT_EQ(syncGameProcess->getObservations(), asyncGameProcess->getObservations());
+  }
+}
+
+TEST(VectorGameProcessTest, stepWhileStepping) {
+  auto vectorGameProcess = std::make_shared<VectorGameProcess>(2, "VECTOR", loadVectorGameGDY());
+  vectorGameProcess->init();
+  vectorGameProcess->reset();
+
+  ASSERT_THROW(vectorGameProcess->waitForStep(), std::runtime_error);
+
+  std::vector<int32_t> actions(2);
+  vectorGameProcess->stepAsync(actions.data(), 1);
+  ASSERT_THROW(vectorGameProcess->step(actions.data(), 1), std::runtime_error);
+  ASSERT_THROW(vectorGameProcess->stepAsync(actions.data(), 1), std::runtime_error);
+  ASSERT_THROW(vectorGameProcess->reset(), std::runtime_error);
+
+  vectorGameProcess->waitForStep();
+  vectorGameProcess->step(actions.data(), 1);
+}
+
+TEST(VectorGameProcessTest, stepAsyncRethrowsErrors) {
+  auto vectorGameProcess = std::make_shared<VectorGameProcess>(2, "VECTOR", loadVectorGameGDY());
+  vectorGameProcess->init();
+  vectorGameProcess->reset();
+
+  // Action type 1 does not exist, the error is raised on the background thread
+  std::vector<int32_t> actions{1, 1, 0, 1};
+  vectorGameProcess->stepAsync(actions.data(), 2);
+  ASSERT_THROW(vectorGameProcess->waitForStep(), std::invalid_argument);
+  ASSERT_FALSE(vectorGameProcess->isStepping());
+}
+
+TEST(VectorGameProcessTest, invalidActionSize) {
+  auto vectorGameProcess = std::make_shared<VectorGameProcess>(2, "VECTOR", loadVectorGameGDY());
+  vectorGameProcess->init();
+  vectorGameProcess->reset();
+
+  std::vector<int32_t> actions(10);
+  ASSERT_THROW(vectorGameProcess->step(actions.data(), 5), std::invalid_argument);
+}
+
+TEST(VectorGameProcessTest, stepBeforeReset) {
+  auto vectorGameProcess = std::make_shared<VectorGameProcess>(2, "VECTOR", loadVectorGameGDY());
+  vectorGameProcess->init();
+
+  std::vector<int32_t> actions(2);
+  ASSERT_THROW(vectorGameProcess->step(actions.data(), 1), std::runtime_error);
+}
+
+}  // namespace griddly
@@ -7,8 +7,9 @@ namespace griddly {
 
 class MockObject : public Object {
  public:
-  MockObject()
-      : Object("mockObject", 'o', 0, 0, {}, nullptr, std::weak_ptr<Grid>()) {
+  // The variables are also given to the object itself, so they can be read from their slots like the variables of a real object
+  explicit MockObject(std::unordered_map<std::string, std::shared_ptr<int32_t>> availableVariables = {})
+      : Object("mockObject", 'o', 0, 0, std::move(availableVariables), nullptr, std::weak_ptr<Grid>()) {
   }
 
 
@@ -26,12 +27,14 @@ class MockObject : public Object {
   MOCK_METHOD(uint32_t, getRenderTileId, (), (const));
 
   MOCK_METHOD(bool, isPlayerAvatar, (), (const));
+  MOCK_METHOD(bool, isImmutable, (), (const));
 
   MOCK_METHOD(std::shared_ptr<int32_t>, getVariableValue, (std::string variableName), ());
 
   MOCK_METHOD(std::vector<std::shared_ptr<Action>>, getInitialActions, (std::shared_ptr<Action> originatingAction), ());
 
   MOCK_METHOD(bool, isValidAction, (std::shared_ptr<Action> action), (const));
+  MOCK_METHOD(bool, preconditionsReadGlobalVariables, (const std::string& actionName), (const));
 
   MOCK_METHOD(BehaviourResult, onActionSrc, (std::string destinationObjectName, std::shared_ptr<Action> action), (override));
   MOCK_METHOD(BehaviourResult, onActionDst, (std::shared_ptr<Action> action), (override));
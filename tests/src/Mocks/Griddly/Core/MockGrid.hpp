@@ -13,8 +13,8 @@ class MockGrid : public Grid {
   MOCK_METHOD(void, resetGlobalVariables, ((std::unordered_map<std::string, GlobalVariableDefinition>)), ());
   MOCK_METHOD((std::unordered_map<uint32_t, int32_t>), update, (), ());
 
-  MOCK_METHOD((const std::unordered_set<glm::ivec2>&), getUpdatedLocations, (uint32_t playerId), (const));
-  MOCK_METHOD(void, purgeUpdatedLocations, (uint32_t playerId), ());
+  MOCK_METHOD(bool, getUpdatedLocations, (uint64_t& cursor, std::vector<glm::ivec2>& updatedLocations), (const));
+  MOCK_METHOD(uint64_t, getStateHash, (), ());
 
   MOCK_METHOD(uint32_t, getWidth, (), (const));
   MOCK_METHOD(uint32_t, getHeight, (), (const));
@@ -52,5 +52,9 @@ class MockGrid : public Grid {
   MOCK_METHOD(std::shared_ptr<int32_t>, getTickCount, (), (const));
 
   MOCK_METHOD(std::mt19937, getRandomGenerator, (), ());
+
+  MOCK_METHOD(void, pushCheckpoint, (), ());
+  MOCK_METHOD(void, rollback, (), ());
+  MOCK_METHOD(void, discardCheckpoint, (), ());
 };
 }  // namespace griddly
\ No newline at end of file